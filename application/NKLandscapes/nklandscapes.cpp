@@ -0,0 +1,267 @@
+// -*- mode: c++; c-indent-level: 4; c++-member-init-indent: 8; comment-column: 35; -*-
+
+/* This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+ * Authors:
+ * Caner Candan <caner.candan@univ-angers.fr>
+ */
+
+#include <eo>
+#include <ga.h>
+#include <dim/dim>
+#include <dim/algo/Easy.h>
+#include <dim/evolver/Easy.h>
+#include <dim/evolver/Incremental.h>
+#include <dim/feedbacker/Easy.h>
+#include <dim/migrator/Easy.h>
+#include <dim/vectorupdater/Easy.h>
+#include <dim/core/State.h>
+
+#if __cplusplus > 199711L
+namespace std_or_boost = std;
+#include <mutex>
+#include <condition_variable>
+#else
+#include <boost/thread/thread.hpp>
+#include <boost/chrono/chrono_io.hpp>
+#include <boost/thread/mutex.hpp>
+namespace std_or_boost = boost;
+#endif
+
+typedef dim::core::Bit<double> EOT;
+
+#ifdef NK_FLOAT
+// nklandscapes-float: the tables of contributions in single precision, for the largest K
+typedef float NKValue;
+#else
+typedef double NKValue;
+#endif
+
+typedef dim::evaluation::NKLandscapes<EOT, NKValue> NK;
+
+int main (int argc, char *argv[])
+{
+    /************************
+     * Initialisation de EO *
+     ************************/
+
+    eoParser parser(argc, argv);
+    eoState state;    // keeps all things allocated
+    dim::core::State state_dim;    // keeps all things allocated
+
+    /*****************************
+     * Definition des paramètres *
+     *****************************/
+
+    // N
+    unsigned nislands = parser.createParam(unsigned(4), "nislands", "Number of islands", 'N', "Islands Model").value();
+    // a
+    double alphaP = parser.createParam(double(0.2), "alpha", "Alpha Probability", 'a', "Islands Model").value();
+    // A
+    double alphaF = parser.createParam(double(0.01), "alphaF", "Alpha Fitness", 'A', "Islands Model").value();
+    // b
+    double betaP = parser.createParam(double(0.01), "beta", "Beta Probability", 'b', "Islands Model").value();
+    // d
+    double probaSame = parser.createParam(double(100./nislands), "probaSame", "Probability for an individual to stay in the same island", 'd', "Islands Model").value();
+    // I
+    bool initG = parser.createParam(bool(true), "initG", "initG", 'I', "Islands Model").value();
+    unsigned stepTimer = parser.createParam(unsigned(0), "stepTimer", "stepTimer (milliseconds)", 0, "Islands Model").value();
+    double sensitivity = 1 / parser.createParam(double(1.), "sensitivity", "sensitivity of delta{t} (1/sensitivity)", 0, "Islands Model").value();
+    std::string rewardStrategy = parser.createParam(std::string("best"), "rewardStrategy", "Strategy of rewarding: best or avg", 0, "Islands Model").value();
+    std::string waitPolicy = parser.createParam(std::string("spin"), "waitPolicy", "How threads wait for their queues: spin, backoff or park", 0, "Islands Model").value();
+    unsigned nbmove = parser.createParam(unsigned(1), "nbmove", "Number of movement of the operator per generation", 'm', "Islands Model").value();
+    bool batch = parser.createParam(bool(false), "batch", "Generate the nbmove candidates of every individual before evaluating them together (without --incremental)", 0, "Islands Model").value();
+    bool incremental = parser.createParam(bool(false), "incremental", "Evaluate the flipped bits incrementally and flip them in place instead of evaluating a copy of the individual", 0, "Islands Model").value();
+    bool skipSampling = parser.createParam(bool(false), "skipSampling", "Draw the flipped bits of the mutations directly, one random number per flip instead of one per bit", 0, "Islands Model").value();
+
+    /*********************************
+     * Déclaration des composants EO *
+     *********************************/
+
+    std::string nkInstance = parser.getORcreateParam(std::string(""), "nkInstance", "filename of the NK instance, a random one is generated if empty", 0, "Problem").value();
+    unsigned chromSize = parser.getORcreateParam(unsigned(1000), "chromSize", "The length of the bitstrings (N of a generated instance)", 'n', "Problem").value();
+    unsigned K = parser.getORcreateParam(unsigned(4), "K", "Number of epistatic links of a generated instance", 'K', "Problem").value();
+    bool consecutive = parser.getORcreateParam(bool(false), "consecutive", "Links of a generated instance to the K next bits instead of random ones", 0, "Problem").value();
+
+    unsigned popSize = parser.getORcreateParam(unsigned(100), "popSize", "Population Size", 'P', "Evolution Engine").value();
+
+    double targetFitness = parser.getORcreateParam(double(1), "targetFitness", "Stop when fitness reaches",'T', "Stopping criterion").value();
+    unsigned maxGen = parser.getORcreateParam(unsigned(10000), "maxGen", "Maximum number of generations () = none)",'G',"Stopping criterion").value();
+
+    std::string monitorPrefix = parser.getORcreateParam(std::string("result"), "monitorPrefix", "Monitor prefix filenames", '\0', "Output").value();
+
+    /**************
+     * EO routine *
+     **************/
+
+    make_parallel(parser);
+    make_verbose(parser);
+    make_help(parser);
+
+    NK* ptNK = nkInstance.empty() ? new NK(chromSize, K, consecutive) : new NK(nkInstance.c_str());
+    NK& mainEval = *ptNK;
+
+    // the bitstrings take the length of the instance
+    parser.setORcreateParam(unsigned(mainEval.N), "chromSize", "The length of the bitstrings (N of a generated instance)", 'n', "Problem");
+    // unbiased random bitstrings
+    eoInit<EOT>& init = dim::do_make::genotype(parser, state, EOT(), 0.5);
+    dim::core::Pop<EOT>& pop = dim::do_make::detail::pop(parser, state, init);
+
+    std::cout << "N: " << mainEval.N << " K: " << mainEval.K << std::endl;
+
+    // smp
+
+    /**********************************
+     * Déclaration des composants DIM *
+     **********************************/
+
+    dim::core::ThreadsRunner< EOT > tr;
+
+    std::vector< dim::core::Pop<EOT>* > islandPop(nislands);
+    std::vector< dim::core::IslandData<EOT>* > islandData(nislands);
+    std::vector< dim::variation::NKLandscapesBitFlipEval<EOT, NKValue>* > flipEvals(nislands);
+
+    dim::core::MigrationMatrix probabilities( nislands );
+    dim::core::InitMatrix initmatrix( initG, probaSame );
+
+    initmatrix( probabilities );
+    std::cout << probabilities;
+
+    for (size_t i = 0; i < nislands; ++i)
+	{
+	    std::cout << "island " << i << std::endl;
+
+	    islandPop[i] = new dim::core::Pop<EOT>(popSize, init);
+	    islandData[i] = new dim::core::IslandData<EOT>(nislands, i, monitorPrefix);
+	    islandData[i]->waitPolicy( dim::core::WaitPolicy::parse(waitPolicy) );
+
+	    eoEvalFuncCounter<EOT>* ptEval = new dim::evaluation::BatchCounter<EOT>(mainEval);
+	    state.storeFunctor(ptEval);
+
+	    islandData[i]->proba = probabilities(i);
+	    dim::evaluation::evaluate(*ptEval, *(islandPop[i]));
+
+	    /****************************************
+	     * Distribution des opérateurs aux iles *
+	     ****************************************/
+
+	    // the incremental evaluation keeps marks, one per island
+	    flipEvals[i] = new dim::variation::NKLandscapesBitFlipEval<EOT, NKValue>(mainEval);
+	    dim::variation::BitFlipEval<EOT>* ptFlipEval = flipEvals[i];
+
+	    eoMonOp<EOT>* ptMon = NULL;
+	    dim::variation::Move<EOT>* ptMove = NULL;
+	    if ( i == 0 )
+		{
+		    eo::log << eo::logging << i << ": bitflip ";
+		    if (skipSampling) { ptMon = new dim::variation::SkipBitMutation<EOT>( 1, true ); }
+		    else { ptMon = new eoBitMutation<EOT>( 1, true ); }
+		    ptMove = new dim::variation::BitMutationMove<EOT>( *ptFlipEval, 1 );
+		}
+	    else
+		{
+		    eo::log << eo::logging << i << ": kflip(" << (i-1) * 2 + 1 << ") ";
+		    if (skipSampling) { ptMon = new dim::variation::DetBitFlip<EOT>( (i-1) * 2 + 1 ); }
+		    else { ptMon = new eoDetSingleBitFlip<EOT>( (i-1) * 2 + 1 ); }
+		    ptMove = new dim::variation::DetBitFlipMove<EOT>( *ptFlipEval, (i-1) * 2 + 1 );
+		}
+	    eo::log << eo::logging << std::endl;
+	    eo::log.flush();
+	    state.storeFunctor(ptMon);
+	    state.storeFunctor(ptMove);
+
+	    dim::evolver::Base<EOT>* ptEvolver = NULL;
+	    if (incremental)
+		{
+		    ptEvolver = new dim::evolver::Incremental<EOT>( *ptMove, nbmove );
+		}
+	    else
+		{
+		    ptEvolver = new dim::evolver::Easy<EOT>( *ptEval, *ptMon, true, nbmove, batch );
+		}
+	    state_dim.storeFunctor(ptEvolver);
+
+	    dim::feedbacker::Base<EOT>* ptFeedbacker = new dim::feedbacker::smp::Easy<EOT>(islandPop, islandData, alphaF);
+	    state_dim.storeFunctor(ptFeedbacker);
+
+	    dim::vectorupdater::Reward<EOT>* ptReward = NULL;
+	    if (rewardStrategy == "best")
+		{
+		    ptReward = new dim::vectorupdater::Best<EOT>(alphaP, betaP);
+		}
+	    else
+		{
+		    ptReward = new dim::vectorupdater::Average<EOT>(alphaP, betaP, sensitivity);
+		}
+	    state_dim.storeFunctor(ptReward);
+
+	    dim::vectorupdater::Base<EOT>* ptUpdater = new dim::vectorupdater::Easy<EOT>(*ptReward);
+	    state_dim.storeFunctor(ptUpdater);
+
+	    dim::memorizer::Base<EOT>* ptMemorizer = new dim::memorizer::Easy<EOT>();
+	    state_dim.storeFunctor(ptMemorizer);
+
+	    dim::migrator::Base<EOT>* ptMigrator = new dim::migrator::smp::Easy<EOT>(islandPop, islandData);
+	    state_dim.storeFunctor(ptMigrator);
+
+	    dim::continuator::Base<EOT>& continuator = dim::do_make::continuator<EOT>(parser, state, *ptEval);
+	    dim::utils::CheckPoint<EOT>& checkpoint = dim::do_make::checkpoint<EOT>(parser, state, continuator, *(islandData[i]), 1, stepTimer);
+
+	    dim::algo::Base<EOT>* ptIsland = new dim::algo::smp::Easy<EOT>( *ptEvolver, *ptFeedbacker, *ptUpdater, *ptMemorizer, *ptMigrator, checkpoint, islandPop, islandData );
+	    state_dim.storeFunctor(ptIsland);
+
+	    ptEvolver->size(nislands);
+	    ptFeedbacker->size(nislands);
+	    ptReward->size(nislands);
+	    ptUpdater->size(nislands);
+	    ptMemorizer->size(nislands);
+	    ptMigrator->size(nislands);
+	    ptIsland->size(nislands);
+
+	    ptEvolver->rank(i);
+	    ptFeedbacker->rank(i);
+	    ptReward->rank(i);
+	    ptUpdater->rank(i);
+	    ptMemorizer->rank(i);
+	    ptMigrator->rank(i);
+	    ptIsland->rank(i);
+
+	    tr.add(*ptIsland);
+	}
+
+    std::cout << "Island Model Parameters:" << std::endl
+	      << "alphaP: " << alphaP << std::endl
+	      << "alphaF: " << alphaF << std::endl
+	      << "betaP: " << betaP << std::endl
+	      << "probaSame: " << probaSame << std::endl
+	      << "initG: " << initG << std::endl
+	      << "popSize: " << popSize << std::endl
+	      << "targetFitness: " << targetFitness << std::endl
+	      << "maxGen: " << maxGen << std::endl
+	;
+
+    dim::core::IslandData<EOT> data(nislands, -1, monitorPrefix);
+    tr(pop, data);
+
+    for (size_t i = 0; i < nislands; ++i)
+	{
+	    delete islandPop[i];
+	    delete islandData[i];
+	    delete flipEvals[i];
+	}
+
+    delete ptNK;
+
+    return 0;
+}
@@ -24,6 +24,7 @@
 #include <dim/dim>
 #include <dim/algo/Easy.h>
 #include <dim/evolver/Easy.h>
+#include <dim/evolver/Incremental.h>
 #include <dim/feedbacker/Easy.h>
 #include <dim/migrator/Easy.h>
 #include <dim/vectorupdater/Easy.h>
@@ -40,7 +41,37 @@ namespace std_or_boost = std;
 namespace std_or_boost = boost;
 #endif
 
+#ifdef PACKED_BIT
+// onemax-packed: bits stored in words
+typedef dim::core::PackedBit<double> EOT;
+#else
 typedef dim::core::Bit<double> EOT;
+#endif
+
+/*
+ * The EO mutations draw one random number per bit, the ones of --skipSampling
+ * draw the flipped bits directly. The EO mutations do not handle packed
+ * bitstrings, so onemax-packed always samples.
+ */
+
+// flips every bit with a probability of 1/n
+eoMonOp<EOT>* bitflip(bool skipSampling)
+{
+#ifndef PACKED_BIT
+    if ( !skipSampling ) { return new eoBitMutation<EOT>( 1, true ); }
+#endif
+    return new dim::variation::SkipBitMutation<EOT>( 1, true );
+}
+
+// flips k bits, distinct ones or drawn with replacement, DetBitFlip always draws distinct ones
+eoMonOp<EOT>* kflip(unsigned k, bool distinct, bool skipSampling)
+{
+#ifndef PACKED_BIT
+    if ( !skipSampling && distinct ) { return new eoDetPermutBitFlip<EOT>( k ); }
+    if ( !skipSampling ) { return new eoDetSingleBitFlip<EOT>( k ); }
+#endif
+    return new dim::variation::DetBitFlip<EOT>( k );
+}
 
 int main (int argc, char *argv[])
 {
@@ -48,7 +79,7 @@ int main (int argc, char *argv[])
      * Initialisation de MPI *
      *************************/
 
-    boost::mpi::environment env(argc, argv, MPI_THREAD_MULTIPLE, true);
+    boost::mpi::environment env(argc, argv, MPI_THREAD_FUNNELED, true);
     boost::mpi::communicator world;
 
     /****************************
@@ -72,6 +103,7 @@ int main (int argc, char *argv[])
 
     bool sync = parser.createParam(bool(true), "sync", "sync", 0, "Islands Model").value();
     bool smp = parser.createParam(bool(true), "smp", "smp", 0, "Islands Model").value();
+    bool overlap = parser.createParam(bool(false), "overlap", "Overlap the exchanges of a generation with the evolution of the next one (synchronous MPI islands)", 0, "Islands Model").value();
     unsigned nislands = parser.createParam(unsigned(4), "nislands", "Number of islands (see --smp)", 0, "Islands Model").value();
     // a
     double alphaP = parser.createParam(double(0.2), "alpha", "Alpha Probability", 'a', "Islands Model").value();
@@ -92,6 +124,11 @@ int main (int argc, char *argv[])
     bool deltaFeedback = parser.createParam(bool(true), "deltaFeedback", "deltaFeedback", 0, "Islands Model").value();
     double sensitivity = 1 / parser.createParam(double(1.), "sensitivity", "sensitivity of delta{t} (1/sensitivity)", 0, "Islands Model").value();
     std::string rewardStrategy = parser.createParam(std::string("best"), "rewardStrategy", "Strategy of rewarding: best or avg", 0, "Islands Model").value();
+    std::string waitPolicy = parser.createParam(std::string("spin"), "waitPolicy", "How threads wait for their queues: spin, backoff or park", 0, "Islands Model").value();
+    unsigned packetSize = parser.createParam(unsigned(64), "packetSize", "Number of migrants and feedbacks from which a packet is sent to an island (asynchronous MPI islands)", 0, "Islands Model").value();
+    unsigned packetDelay = parser.createParam(unsigned(1000), "packetDelay", "Microseconds from which a packet is sent to an island whatever its size (asynchronous MPI islands)", 0, "Islands Model").value();
+    bool incremental = parser.createParam(bool(false), "incremental", "Evaluate the flipped bits incrementally and flip them in place instead of evaluating a copy of the individual", 0, "Islands Model").value();
+    bool skipSampling = parser.createParam(bool(false), "skipSampling", "Draw the flipped bits of the mutations directly, one random number per flip instead of one per bit (always on with packed bitstrings)", 0, "Islands Model").value();
 
     /*********************************
      * Déclaration des composants EO *
@@ -102,6 +139,7 @@ int main (int argc, char *argv[])
 
     dim::evaluation::OneMax<EOT> mainEval;
     eoEvalFuncCounter<EOT> eval(mainEval);
+    dim::variation::OneMaxBitFlipEval<EOT> flipEval;
 
     unsigned popSize = parser.getORcreateParam(unsigned(100), "popSize", "Population Size", 'P', "Evolution Engine").value();
     dim::core::Pop<EOT>& pop = dim::do_make::detail::pop(parser, state, init);
@@ -111,6 +149,8 @@ int main (int argc, char *argv[])
     dim::continuator::Base<EOT>& continuator = dim::do_make::continuator<EOT>(parser, state, eval);
 
     dim::core::IslandData<EOT> data(smp ? nislands : -1);
+    if (!smp) { data.random.seed(dim::core::Random::master(), RANK); } // one stream per process
+    data.waitPolicy( dim::core::WaitPolicy::parse(waitPolicy) );
 
     std::string monitorPrefix = parser.getORcreateParam(std::string("result"), "monitorPrefix", "Monitor prefix filenames", '\0', "Output").value();
     dim::utils::CheckPoint<EOT>& checkpoint = dim::do_make::checkpoint<EOT>(parser, state, continuator, data, 1, stepTimer);
@@ -131,19 +171,23 @@ int main (int argc, char *argv[])
 	     ****************************************/
 
 	    eoMonOp<EOT>* ptMon = NULL;
+	    dim::variation::Move<EOT>* ptMove = NULL;
 	    if ( RANK == 0 )
 		{
 		    eo::log << eo::logging << RANK << ": bitflip ";
-		    ptMon = new eoBitMutation<EOT>( 1, true );
+		    ptMon = bitflip( skipSampling );
+		    ptMove = new dim::variation::BitMutationMove<EOT>( flipEval, 1 );
 		}
 	    else
 		{
 		    eo::log << eo::logging << RANK << ": kflip(" << (RANK-1) * 2 + 1 << ") ";
-		    ptMon = new eoDetPermutBitFlip<EOT>( (RANK-1) * 2 + 1 );
+		    ptMon = kflip( (RANK-1) * 2 + 1, true, skipSampling );
+		    ptMove = new dim::variation::DetBitFlipMove<EOT>( flipEval, (RANK-1) * 2 + 1 );
 		}
 	    eo::log << eo::logging << std::endl;
 	    eo::log.flush();
 	    state.storeFunctor(ptMon);
+	    state.storeFunctor(ptMove);
 
 	    /**********************************
 	     * Déclaration des composants DIM *
@@ -151,7 +195,16 @@ int main (int argc, char *argv[])
 
 	    dim::core::ThreadsRunner< EOT > tr;
 
-	    dim::evolver::Easy<EOT> evolver( /*eval*/mainEval, *ptMon );
+	    dim::evolver::Base<EOT>* ptEvolver = NULL;
+	    if (incremental)
+		{
+		    ptEvolver = new dim::evolver::Incremental<EOT>( *ptMove );
+		}
+	    else
+		{
+		    ptEvolver = new dim::evolver::Easy<EOT>( /*eval*/mainEval, *ptMon );
+		}
+	    state_dim.storeFunctor(ptEvolver);
 
 	    dim::feedbacker::Base<EOT>* ptFeedbacker = NULL;
 	    if (feedback)
@@ -213,10 +266,18 @@ int main (int argc, char *argv[])
 		}
 	    state_dim.storeFunctor(ptMigrator);
 
-	    dim::algo::Easy<EOT> island( evolver, *ptFeedbacker, *ptUpdater, memorizer, *ptMigrator, checkpoint, monitorPrefix );
+	    dim::algo::Easy<EOT> island( *ptEvolver, *ptFeedbacker, *ptUpdater, memorizer, *ptMigrator, checkpoint, monitorPrefix );
 
-	    if (!sync)
+	    if (sync)
+		{
+		    island.overlap(overlap);
+		}
+	    else
 		{
+		    dim::core::ProgressEngine<EOT>& engine = dim::core::ProgressEngine<EOT>::shared();
+		    engine.maxPacket(packetSize);
+		    engine.maxDelay(packetDelay);
+
 		    tr.addHandler(*ptFeedbacker).addHandler(*ptMigrator).add(island);
 		}
 
@@ -252,6 +313,7 @@ int main (int argc, char *argv[])
 			      << "feedback: " << feedback << std::endl
 			      << "migrate: " << migrate << std::endl
 			      << "sync: " << sync << std::endl
+			      << "overlap: " << overlap << std::endl
 			      << "stepTimer: " << stepTimer << std::endl
 			      << "deltaUpdate: " << deltaUpdate << std::endl
 			      << "deltaFeedback: " << deltaFeedback << std::endl
@@ -322,21 +384,33 @@ int main (int argc, char *argv[])
 	     ****************************************/
 
 	    eoMonOp<EOT>* ptMon = NULL;
+	    dim::variation::Move<EOT>* ptMove = NULL;
 	    if ( islandData[i].rank() == 0 )
 		{
 		    eo::log << eo::logging << islandData[i].rank() << ": bitflip ";
-		    ptMon = new eoBitMutation<EOT>( 1, true );
+		    ptMon = bitflip( skipSampling );
+		    ptMove = new dim::variation::BitMutationMove<EOT>( flipEval, 1 );
 		}
 	    else
 		{
 		    eo::log << eo::logging << islandData[i].rank() << ": kflip(" << (islandData[i].rank()-1) * 2 + 1 << ") ";
-		    ptMon = new eoDetSingleBitFlip<EOT>( (islandData[i].rank()-1) * 2 + 1 );
+		    ptMon = kflip( (islandData[i].rank()-1) * 2 + 1, false, skipSampling );
+		    ptMove = new dim::variation::DetBitFlipMove<EOT>( flipEval, (islandData[i].rank()-1) * 2 + 1 );
 		}
 	    eo::log << eo::logging << std::endl;
 	    eo::log.flush();
 	    state.storeFunctor(ptMon);
+	    state.storeFunctor(ptMove);
 
-	    dim::evolver::Base<EOT>* ptEvolver = new dim::evolver::Easy<EOT>( /*eval*/mainEval, *ptMon );
+	    dim::evolver::Base<EOT>* ptEvolver = NULL;
+	    if (incremental)
+		{
+		    ptEvolver = new dim::evolver::Incremental<EOT>( *ptMove );
+		}
+	    else
+		{
+		    ptEvolver = new dim::evolver::Easy<EOT>( /*eval*/mainEval, *ptMon );
+		}
 	    state_dim.storeFunctor(ptEvolver);
 
 	    dim::feedbacker::Base<EOT>* ptFeedbacker = new dim::feedbacker::smp::Easy<EOT>(islandPop, islandData, alphaF);
@@ -27,6 +27,8 @@
 #include <dim/dim>
 #include <dim/algo/Easy.h>
 #include <dim/evolver/Easy.h>
+#include <dim/evolver/Incremental.h>
+#include <dim/evolver/Parallel.h>
 #include <dim/feedbacker/Easy.h>
 #include <dim/migrator/Easy.h>
 #include <dim/vectorupdater/Easy.h>
@@ -45,6 +47,24 @@ namespace std_or_boost = boost;
 
 typedef dim::representation::Route<double> EOT;
 
+/// instance of an improvement kernel for the comparison strategy
+template <template <typename, typename, typename> class Kernel, typename Move>
+dim::variation::Base<EOT>* makeKernel(std::string comparisonStrategy, eoValueParam<unsigned int>& evaluations, dim::core::ThreadPool* pool)
+{
+    if ( comparisonStrategy == "neutral" )
+	{
+	    return new Kernel<EOT, Move, dim::variation::neighborhood::Neutral>(evaluations, pool);
+	}
+
+    return new Kernel<EOT, Move, dim::variation::neighborhood::Strict>(evaluations, pool);
+}
+
+/// the thread pool if the operator is listed in --parallelOperators
+dim::core::ThreadPool* poolOf(std::string name, const std::vector<std::string>& parallelOperators, dim::core::ThreadPool& pool)
+{
+    return std::find(parallelOperators.begin(), parallelOperators.end(), name) != parallelOperators.end() ? &pool : NULL;
+}
+
 int main (int argc, char *argv[])
 {
     /*************************
@@ -93,12 +113,25 @@ int main (int argc, char *argv[])
     std::string rewardStrategy = parser.createParam(std::string("best"), "rewardStrategy", "Strategy of rewarding: best or avg", 0, "Islands Model").value();
     std::string comparisonStrategy = parser.createParam(std::string("neutral"), "comparisonStrategy", "Operator comparison strategy: neutral or strict", 0, "Islands Model").value();
     unsigned nbmove = parser.createParam(unsigned(1), "nbmove", "Number of movement of the operator per generation", 'm', "Islands Model").value();
+    bool batch = parser.createParam(bool(false), "batch", "Generate the nbmove candidates of every individual before evaluating them together (without --incremental)", 0, "Islands Model").value();
+    bool incremental = parser.createParam(bool(false), "incremental", "Evaluate the moves of the swap, shift and inversion operators incrementally and apply them in place instead of evaluating a copy of the tour", 0, "Islands Model").value();
+    std::string kernel = parser.createParam(std::string("template"), "kernel", "Evaluation of the neighbourhoods of the best_improve_* and relative_best_improve_* operators: template or virtual", 0, "Islands Model").value();
+    std::string waitPolicy = parser.createParam(std::string("spin"), "waitPolicy", "How threads wait for their queues: spin, backoff or park", 0, "Islands Model").value();
+    unsigned poolThreads = parser.createParam(unsigned(0), "poolThreads", "Number of worker threads shared by the operators of --parallelOperators", 0, "Islands Model").value();
+    unsigned cacheSize = parser.createParam(unsigned(0), "cacheSize", "Number of fitnesses kept by the cache of the evaluations of the operators without --incremental (0 = no cache)", 0, "Islands Model").value();
+    bool cacheShared = parser.createParam(bool(true), "cacheShared", "One cache shared by the islands instead of one per island", 0, "Islands Model").value();
+    unsigned parts = parser.createParam(unsigned(1), "parts", "Number of parts the population of an island is split in and evolved in parallel by the thread pool (swap, shift and inversion without --incremental)", 0, "Islands Model").value();
+    std::string parallelOperators = parser.createParam(std::string(""), "parallelOperators", "List of first_improve_*, relative_best_improve_* and best_improve_* operators separated by a comma which split their neighbourhood with the thread pool", 0, "Islands Model").value();
 
     /*********************************
      * Déclaration des composants EO *
      *********************************/
 
-    std::string tspInstance =  parser.getORcreateParam(std::string("benchs/ali535.xml"), "tspInstance", "filename of the instance for TSP problem", 0, "Problem").value();
+    std::string tspInstance =  parser.getORcreateParam(std::string("benchs/pr2392.tsp"), "tspInstance", "filename of the instance for TSP problem (TSPLIB, XML or bare coordinates)", 0, "Problem").value();
+    std::string edgeWeightType =  parser.getORcreateParam(std::string("EUC_2D"), "edgeWeightType", "edge weight type of a bare coordinates instance: EUC_2D, CEIL_2D, GEO or ATT (benchs/ali535.tsp is GEO)", 0, "Problem").value();
+    bool hugePages =  parser.getORcreateParam(bool(false), "hugePages", "back the distance matrix with huge pages", 0, "Problem").value();
+    bool matrixFree =  parser.getORcreateParam(bool(false), "matrixFree", "compute the distances on the fly instead of storing the matrix (large instances)", 0, "Problem").value();
+    unsigned candidates =  parser.getORcreateParam(unsigned(10), "candidates", "number of nearest neighbours per city used by the candidate_* operators (0 = disabled)", 0, "Problem").value();
 
     dim::evaluation::Route<double> mainEval;
 
@@ -109,6 +142,10 @@ int main (int argc, char *argv[])
 
     std::string monitorPrefix = parser.getORcreateParam(std::string("result"), "monitorPrefix", "Monitor prefix filenames", '\0', "Output").value();
 
+    dim::core::ThreadPool threadPool(poolThreads);
+    std::vector<std::string> parallelOperatorsVec;
+    if ( !parallelOperators.empty() ) { boost::split(parallelOperatorsVec, parallelOperators, boost::is_any_of(",")); }
+
     std::map< std::string, std::pair< dim::variation::Base<EOT>*, dim::variation::IncrementalEvalCounter<EOT>* > > mapOperators;
     std::vector< std::string > operatorsOrder;
 
@@ -119,18 +156,23 @@ int main (int argc, char *argv[])
     dim::variation::SwapIncrementalEval<EOT> swapEval;
     dim::variation::ShiftIncrementalEval<EOT> shiftEval;
     dim::variation::InversionIncrementalEval<EOT> inversionEval;
-    dim::variation::DummyIncrementalEval<EOT> dummyEval;
 
+    // the random operators only use their incremental evaluation with --incremental
     mapOperators["swap"] = std::make_pair(new dim::variation::RandMutation<EOT>(swapOp),
-					  new dim::variation::IncrementalEvalCounter<EOT>(dummyEval));
+					  new dim::variation::IncrementalEvalCounter<EOT>(swapEval));
     operatorsOrder.push_back("swap");
     mapOperators["shift"] = std::make_pair(new dim::variation::RandMutation<EOT>(shiftOp),
-					   new dim::variation::IncrementalEvalCounter<EOT>(dummyEval));
+					   new dim::variation::IncrementalEvalCounter<EOT>(shiftEval));
     operatorsOrder.push_back("shift");
     mapOperators["inversion"] = std::make_pair(new dim::variation::RandMutation<EOT>(inversionOp),
-					       new dim::variation::IncrementalEvalCounter<EOT>(dummyEval));;
+					       new dim::variation::IncrementalEvalCounter<EOT>(inversionEval));;
     operatorsOrder.push_back("inversion");
 
+    std::map< std::string, dim::variation::PartialOp<EOT>* > mapPartialOps;
+    mapPartialOps["swap"] = &swapOp;
+    mapPartialOps["shift"] = &shiftOp;
+    mapPartialOps["inversion"] = &inversionOp;
+
     dim::variation::ComparisonOp<EOT>* ptComparisonOp = NULL;
 
     if ( comparisonStrategy == "neutral" )
@@ -146,35 +188,91 @@ int main (int argc, char *argv[])
     dim::variation::IncrementalEvalCounter<EOT> firstImprovementShiftEvalCounter(shiftEval);
     dim::variation::IncrementalEvalCounter<EOT> firstImprovementInversionEvalCounter(inversionEval);
 
-    mapOperators["first_improve_swap"] = std::make_pair(new dim::variation::FirstImprovementSingleMutation<EOT>(swapOp, firstImprovementSwapEvalCounter, *ptComparisonOp), &firstImprovementSwapEvalCounter);
+    mapOperators["first_improve_swap"] = std::make_pair(new dim::variation::FirstImprovementSingleMutation<EOT>(swapOp, firstImprovementSwapEvalCounter, *ptComparisonOp, poolOf("first_improve_swap", parallelOperatorsVec, threadPool)), &firstImprovementSwapEvalCounter);
     operatorsOrder.push_back("first_improve_swap");
-    mapOperators["first_improve_shift"] = std::make_pair(new dim::variation::FirstImprovementSingleMutation<EOT>(shiftOp, firstImprovementShiftEvalCounter, *ptComparisonOp), &firstImprovementShiftEvalCounter);
+    mapOperators["first_improve_shift"] = std::make_pair(new dim::variation::FirstImprovementSingleMutation<EOT>(shiftOp, firstImprovementShiftEvalCounter, *ptComparisonOp, poolOf("first_improve_shift", parallelOperatorsVec, threadPool)), &firstImprovementShiftEvalCounter);
     operatorsOrder.push_back("first_improve_shift");
-    mapOperators["first_improve_inversion"] = std::make_pair(new dim::variation::FirstImprovementSingleMutation<EOT>(inversionOp, firstImprovementInversionEvalCounter, *ptComparisonOp), &firstImprovementInversionEvalCounter);
+    mapOperators["first_improve_inversion"] = std::make_pair(new dim::variation::FirstImprovementSingleMutation<EOT>(inversionOp, firstImprovementInversionEvalCounter, *ptComparisonOp, poolOf("first_improve_inversion", parallelOperatorsVec, threadPool)), &firstImprovementInversionEvalCounter);
     operatorsOrder.push_back("first_improve_inversion");
 
     dim::variation::IncrementalEvalCounter<EOT> relativeBestImprovementSwapEvalCounter(swapEval);
     dim::variation::IncrementalEvalCounter<EOT> relativeBestImprovementShiftEvalCounter(shiftEval);
     dim::variation::IncrementalEvalCounter<EOT> relativeBestImprovementInversionEvalCounter(inversionEval);
 
-    mapOperators["relative_best_improve_swap"] = std::make_pair(new dim::variation::RelativeBestImprovementMutation<EOT>(swapOp, relativeBestImprovementSwapEvalCounter, *ptComparisonOp), &relativeBestImprovementSwapEvalCounter);
+    if ( kernel == "template" )
+	{
+	    mapOperators["relative_best_improve_swap"] = std::make_pair(makeKernel<dim::variation::RelativeBestImprovementKernel, dim::variation::neighborhood::Swap>(comparisonStrategy, relativeBestImprovementSwapEvalCounter, poolOf("relative_best_improve_swap", parallelOperatorsVec, threadPool)), &relativeBestImprovementSwapEvalCounter);
+	    mapOperators["relative_best_improve_shift"] = std::make_pair(makeKernel<dim::variation::RelativeBestImprovementKernel, dim::variation::neighborhood::Shift>(comparisonStrategy, relativeBestImprovementShiftEvalCounter, poolOf("relative_best_improve_shift", parallelOperatorsVec, threadPool)), &relativeBestImprovementShiftEvalCounter);
+	    mapOperators["relative_best_improve_inversion"] = std::make_pair(makeKernel<dim::variation::RelativeBestImprovementKernel, dim::variation::neighborhood::Inversion>(comparisonStrategy, relativeBestImprovementInversionEvalCounter, poolOf("relative_best_improve_inversion", parallelOperatorsVec, threadPool)), &relativeBestImprovementInversionEvalCounter);
+	}
+    else
+	{
+	    mapOperators["relative_best_improve_swap"] = std::make_pair(new dim::variation::RelativeBestImprovementMutation<EOT>(swapOp, relativeBestImprovementSwapEvalCounter, *ptComparisonOp, poolOf("relative_best_improve_swap", parallelOperatorsVec, threadPool)), &relativeBestImprovementSwapEvalCounter);
+	    mapOperators["relative_best_improve_shift"] = std::make_pair(new dim::variation::RelativeBestImprovementMutation<EOT>(shiftOp, relativeBestImprovementShiftEvalCounter, *ptComparisonOp, poolOf("relative_best_improve_shift", parallelOperatorsVec, threadPool)), &relativeBestImprovementShiftEvalCounter);
+	    mapOperators["relative_best_improve_inversion"] = std::make_pair(new dim::variation::RelativeBestImprovementMutation<EOT>(inversionOp, relativeBestImprovementInversionEvalCounter, *ptComparisonOp, poolOf("relative_best_improve_inversion", parallelOperatorsVec, threadPool)), &relativeBestImprovementInversionEvalCounter);
+	}
     operatorsOrder.push_back("relative_best_improve_swap");
-    mapOperators["relative_best_improve_shift"] = std::make_pair(new dim::variation::RelativeBestImprovementMutation<EOT>(shiftOp, relativeBestImprovementShiftEvalCounter, *ptComparisonOp), &relativeBestImprovementShiftEvalCounter);
     operatorsOrder.push_back("relative_best_improve_shift");
-    mapOperators["relative_best_improve_inversion"] = std::make_pair(new dim::variation::RelativeBestImprovementMutation<EOT>(inversionOp, relativeBestImprovementInversionEvalCounter, *ptComparisonOp), &relativeBestImprovementInversionEvalCounter);
     operatorsOrder.push_back("relative_best_improve_inversion");
 
     dim::variation::IncrementalEvalCounter<EOT> bestImprovementSwapEvalCounter(swapEval);
     dim::variation::IncrementalEvalCounter<EOT> bestImprovementShiftEvalCounter(shiftEval);
     dim::variation::IncrementalEvalCounter<EOT> bestImprovementInversionEvalCounter(inversionEval);
 
-    mapOperators["best_improve_swap"] = std::make_pair(new dim::variation::BestImprovementMutation<EOT>(swapOp, bestImprovementSwapEvalCounter, *ptComparisonOp), &bestImprovementSwapEvalCounter);
+    if ( kernel == "template" )
+	{
+	    mapOperators["best_improve_swap"] = std::make_pair(makeKernel<dim::variation::BestImprovementKernel, dim::variation::neighborhood::Swap>(comparisonStrategy, bestImprovementSwapEvalCounter, poolOf("best_improve_swap", parallelOperatorsVec, threadPool)), &bestImprovementSwapEvalCounter);
+	    mapOperators["best_improve_shift"] = std::make_pair(makeKernel<dim::variation::BestImprovementKernel, dim::variation::neighborhood::Shift>(comparisonStrategy, bestImprovementShiftEvalCounter, poolOf("best_improve_shift", parallelOperatorsVec, threadPool)), &bestImprovementShiftEvalCounter);
+	    mapOperators["best_improve_inversion"] = std::make_pair(makeKernel<dim::variation::BestImprovementKernel, dim::variation::neighborhood::Inversion>(comparisonStrategy, bestImprovementInversionEvalCounter, poolOf("best_improve_inversion", parallelOperatorsVec, threadPool)), &bestImprovementInversionEvalCounter);
+	}
+    else
+	{
+	    mapOperators["best_improve_swap"] = std::make_pair(new dim::variation::BestImprovementMutation<EOT>(swapOp, bestImprovementSwapEvalCounter, *ptComparisonOp, poolOf("best_improve_swap", parallelOperatorsVec, threadPool)), &bestImprovementSwapEvalCounter);
+	    mapOperators["best_improve_shift"] = std::make_pair(new dim::variation::BestImprovementMutation<EOT>(shiftOp, bestImprovementShiftEvalCounter, *ptComparisonOp, poolOf("best_improve_shift", parallelOperatorsVec, threadPool)), &bestImprovementShiftEvalCounter);
+	    mapOperators["best_improve_inversion"] = std::make_pair(new dim::variation::BestImprovementMutation<EOT>(inversionOp, bestImprovementInversionEvalCounter, *ptComparisonOp, poolOf("best_improve_inversion", parallelOperatorsVec, threadPool)), &bestImprovementInversionEvalCounter);
+	}
     operatorsOrder.push_back("best_improve_swap");
-    mapOperators["best_improve_shift"] = std::make_pair(new dim::variation::BestImprovementMutation<EOT>(shiftOp, bestImprovementShiftEvalCounter, *ptComparisonOp), &bestImprovementShiftEvalCounter);
     operatorsOrder.push_back("best_improve_shift");
-    mapOperators["best_improve_inversion"] = std::make_pair(new dim::variation::BestImprovementMutation<EOT>(inversionOp, bestImprovementInversionEvalCounter, *ptComparisonOp), &bestImprovementInversionEvalCounter);
     operatorsOrder.push_back("best_improve_inversion");
 
+    dim::variation::IncrementalEvalCounter<EOT> candidateFirstImprovementSwapEvalCounter(swapEval);
+    dim::variation::IncrementalEvalCounter<EOT> candidateFirstImprovementShiftEvalCounter(shiftEval);
+    dim::variation::IncrementalEvalCounter<EOT> candidateFirstImprovementInversionEvalCounter(inversionEval);
+    dim::variation::IncrementalEvalCounter<EOT> candidateRelativeBestImprovementSwapEvalCounter(swapEval);
+    dim::variation::IncrementalEvalCounter<EOT> candidateRelativeBestImprovementShiftEvalCounter(shiftEval);
+    dim::variation::IncrementalEvalCounter<EOT> candidateRelativeBestImprovementInversionEvalCounter(inversionEval);
+    dim::variation::IncrementalEvalCounter<EOT> candidateBestImprovementSwapEvalCounter(swapEval);
+    dim::variation::IncrementalEvalCounter<EOT> candidateBestImprovementShiftEvalCounter(shiftEval);
+    dim::variation::IncrementalEvalCounter<EOT> candidateBestImprovementInversionEvalCounter(inversionEval);
+    dim::variation::IncrementalEvalCounter<EOT> twoOptEvalCounter(inversionEval);
+
+    if ( candidates )
+	{
+	    mapOperators["candidate_first_improve_swap"] = std::make_pair(new dim::variation::CandidateFirstImprovementMutation<EOT>(swapOp, candidateFirstImprovementSwapEvalCounter, *ptComparisonOp), &candidateFirstImprovementSwapEvalCounter);
+	    operatorsOrder.push_back("candidate_first_improve_swap");
+	    mapOperators["candidate_first_improve_shift"] = std::make_pair(new dim::variation::CandidateFirstImprovementMutation<EOT>(shiftOp, candidateFirstImprovementShiftEvalCounter, *ptComparisonOp), &candidateFirstImprovementShiftEvalCounter);
+	    operatorsOrder.push_back("candidate_first_improve_shift");
+	    mapOperators["candidate_first_improve_inversion"] = std::make_pair(new dim::variation::CandidateFirstImprovementMutation<EOT>(inversionOp, candidateFirstImprovementInversionEvalCounter, *ptComparisonOp), &candidateFirstImprovementInversionEvalCounter);
+	    operatorsOrder.push_back("candidate_first_improve_inversion");
+
+	    mapOperators["candidate_relative_best_improve_swap"] = std::make_pair(new dim::variation::CandidateRelativeBestImprovementMutation<EOT>(swapOp, candidateRelativeBestImprovementSwapEvalCounter, *ptComparisonOp), &candidateRelativeBestImprovementSwapEvalCounter);
+	    operatorsOrder.push_back("candidate_relative_best_improve_swap");
+	    mapOperators["candidate_relative_best_improve_shift"] = std::make_pair(new dim::variation::CandidateRelativeBestImprovementMutation<EOT>(shiftOp, candidateRelativeBestImprovementShiftEvalCounter, *ptComparisonOp), &candidateRelativeBestImprovementShiftEvalCounter);
+	    operatorsOrder.push_back("candidate_relative_best_improve_shift");
+	    mapOperators["candidate_relative_best_improve_inversion"] = std::make_pair(new dim::variation::CandidateRelativeBestImprovementMutation<EOT>(inversionOp, candidateRelativeBestImprovementInversionEvalCounter, *ptComparisonOp), &candidateRelativeBestImprovementInversionEvalCounter);
+	    operatorsOrder.push_back("candidate_relative_best_improve_inversion");
+
+	    mapOperators["candidate_best_improve_swap"] = std::make_pair(new dim::variation::CandidateBestImprovementMutation<EOT>(swapOp, candidateBestImprovementSwapEvalCounter, *ptComparisonOp), &candidateBestImprovementSwapEvalCounter);
+	    operatorsOrder.push_back("candidate_best_improve_swap");
+	    mapOperators["candidate_best_improve_shift"] = std::make_pair(new dim::variation::CandidateBestImprovementMutation<EOT>(shiftOp, candidateBestImprovementShiftEvalCounter, *ptComparisonOp), &candidateBestImprovementShiftEvalCounter);
+	    operatorsOrder.push_back("candidate_best_improve_shift");
+	    mapOperators["candidate_best_improve_inversion"] = std::make_pair(new dim::variation::CandidateBestImprovementMutation<EOT>(inversionOp, candidateBestImprovementInversionEvalCounter, *ptComparisonOp), &candidateBestImprovementInversionEvalCounter);
+	    operatorsOrder.push_back("candidate_best_improve_inversion");
+
+	    mapOperators["two_opt"] = std::make_pair(new dim::variation::TwoOptSearch<EOT>(twoOptEvalCounter), &twoOptEvalCounter);
+	    operatorsOrder.push_back("two_opt");
+	}
+
     // mapOperators["2swap"] = new eoSwapMutation<EOT>(2);	operatorsOrder.push_back("2swap");
     // mapOperators["2opt"] = new eoTwoOptMutation<EOT>;	operatorsOrder.push_back("2opt");
 
@@ -212,7 +310,8 @@ int main (int argc, char *argv[])
     make_verbose(parser);
     make_help(parser);
 
-    dim::initialization::TSPLibGraph::load( tspInstance ); // Instance
+    dim::initialization::TSPLibGraph::load( tspInstance, edgeWeightType, hugePages, matrixFree ); // Instance
+    dim::initialization::CandidateList::build( candidates ); // Nearest neighbours
     dim::initialization::Route<double> init ; // Sol. Random Init.
     dim::core::Pop<EOT>& pop = dim::do_make::detail::pop(parser, state, init);
 
@@ -226,6 +325,7 @@ int main (int argc, char *argv[])
 
     std::vector< dim::core::Pop<EOT>* > islandPop(nislands);
     std::vector< dim::core::IslandData<EOT>* > islandData(nislands);
+    std::vector< dim::core::FitnessCache<double>* > caches(nislands, NULL);
 
     dim::core::MigrationMatrix probabilities( nislands );
     dim::core::InitMatrix initmatrix( initG, probaSame );
@@ -241,14 +341,15 @@ int main (int argc, char *argv[])
 
 	    islandPop[i] = new dim::core::Pop<EOT>(popSize, init);
 	    islandData[i] = new dim::core::IslandData<EOT>(nislands, i, monitorPrefix);
+	    islandData[i]->waitPolicy( dim::core::WaitPolicy::parse(waitPolicy) );
 
 	    std::cout << islandData[i]->size() << " " << islandData[i]->rank() << " " << operatorsVec[ islandData[i]->rank() ] << std::endl;
 
-	    eoEvalFuncCounter<EOT>* ptEval = new eoEvalFuncCounter<EOT>(mainEval);
+	    eoEvalFuncCounter<EOT>* ptEval = new dim::evaluation::BatchCounter<EOT>(mainEval);
 	    state.storeFunctor(ptEval);
 
 	    islandData[i]->proba = probabilities(i);
-	    apply<EOT>(*ptEval, *(islandPop[i]));
+	    dim::evaluation::evaluate(*ptEval, *(islandPop[i]));
 
 	    /****************************************
 	     * Distribution des opérateurs aux iles *
@@ -261,7 +362,37 @@ int main (int argc, char *argv[])
 
 	    dim::variation::IncrementalEvalCounter<EOT>* ptIncrementalEvalCounter = mapOperators[ operatorsVec[ islandData[i]->rank() ] ].second;
 
-	    dim::evolver::Base<EOT>* ptEvolver = new dim::evolver::Easy<EOT>( *ptEval, *ptMon, true, nbmove );
+	    if ( cacheSize )
+		{
+		    caches[i] = ( cacheShared && i > 0 ) ? caches[0] : new dim::core::FitnessCache<double>( cacheSize );
+		}
+
+	    dim::evolver::Base<EOT>* ptEvolver = NULL;
+	    if ( incremental && mapPartialOps.count( operatorsVec[ islandData[i]->rank() ] ) )
+		{
+		    // one move per island, it keeps the neighbour drawn
+		    dim::variation::Move<EOT>* ptMove = new dim::variation::PartialMove<EOT>( *mapPartialOps[ operatorsVec[ islandData[i]->rank() ] ], *ptIncrementalEvalCounter );
+		    state.storeFunctor(ptMove);
+		    ptEvolver = new dim::evolver::Incremental<EOT>( *ptMove, nbmove );
+		}
+	    else if ( parts > 1 && mapPartialOps.count( operatorsVec[ islandData[i]->rank() ] ) )
+		{
+		    // every part has its own operator and evaluator
+		    std::vector< eoEvalFunc<EOT>* > partEvals(parts);
+		    std::vector< eoMonOp<EOT>* > partOps(parts);
+		    for (size_t p = 0; p < parts; ++p)
+			{
+			    partEvals[p] = new dim::evaluation::Route<double>;
+			    partOps[p] = new dim::variation::RandMutation<EOT>( *mapPartialOps[ operatorsVec[ islandData[i]->rank() ] ] );
+			    state.storeFunctor(partEvals[p]);
+			    state.storeFunctor(partOps[p]);
+			}
+		    ptEvolver = new dim::evolver::Parallel<EOT>( *ptEval, partEvals, partOps, &threadPool, true, nbmove );
+		}
+	    else
+		{
+		    ptEvolver = new dim::evolver::Easy<EOT>( *ptEval, *ptMon, true, nbmove, batch, caches[i] );
+		}
 	    state_dim.storeFunctor(ptEvolver);
 
 	    dim::feedbacker::Base<EOT>* ptFeedbacker = new dim::feedbacker::smp::Easy<EOT>(islandPop, islandData, alphaF);
@@ -288,7 +419,7 @@ int main (int argc, char *argv[])
 	    state_dim.storeFunctor(ptMigrator);
 
 	    dim::continuator::Base<EOT>& continuator = dim::do_make::continuator<EOT>(parser, state, *ptEval);
-	    dim::utils::CheckPoint<EOT>& checkpoint = dim::do_make::checkpoint<EOT>(parser, state, continuator, *ptIncrementalEvalCounter, *(islandData[i]), 1, stepTimer);
+	    dim::utils::CheckPoint<EOT>& checkpoint = dim::do_make::checkpoint<EOT>(parser, state, continuator, *ptIncrementalEvalCounter, *(islandData[i]), 1, stepTimer, caches[i]);
 
 	    dim::algo::Base<EOT>* ptIsland = new dim::algo::smp::Easy<EOT>( *ptEvolver, *ptFeedbacker, *ptUpdater, *ptMemorizer, *ptMigrator, checkpoint, islandPop, islandData );
 	    state_dim.storeFunctor(ptIsland);
@@ -319,6 +450,7 @@ int main (int argc, char *argv[])
 	{
 	    delete islandPop[i];
 	    delete islandData[i];
+	    if ( !cacheShared || i == 0 ) { delete caches[i]; }
 	}
 
     for ( std::map< std::string, std::pair< dim::variation::Base<EOT>*, dim::variation::IncrementalEvalCounter<EOT>* > >::iterator it = mapOperators.begin(); it != mapOperators.end(); ++it )
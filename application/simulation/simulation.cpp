@@ -126,7 +126,7 @@ int main (int argc, char *argv[])
      * Initialisation de MPI *
      *************************/
 
-    boost::mpi::environment env(argc, argv, MPI_THREAD_MULTIPLE, true);
+    boost::mpi::environment env(argc, argv, MPI_THREAD_FUNNELED, true);
     boost::mpi::communicator world;
 
     /****************************
@@ -205,6 +205,7 @@ int main (int argc, char *argv[])
     dim::continuator::Base<EOT>& continuator = dim::do_make::continuator<EOT>(parser, state, eval);
 
     dim::core::IslandData<EOT> data(smp ? nislands : -1);
+    if (!smp) { data.random.seed(dim::core::Random::master(), RANK); } // one stream per process
 
     std::string monitorPrefix = parser.getORcreateParam(std::string("result"), "monitorPrefix", "Monitor prefix filenames", '\0', "Output").value();
     dim::utils::CheckPoint<EOT>& checkpoint = dim::do_make::checkpoint<EOT>(parser, state, continuator, data, 1, stepTimer);
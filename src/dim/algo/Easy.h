@@ -98,6 +98,13 @@ namespace dim
 		    measureFiles["migrate"] = new std::ofstream(ss.str().c_str());
 #endif // !MEASURE
 
+		    // the operators of this thread draw from the generator of the island
+		    core::Random::local(&data.random);
+#if defined(DIM_PMR)
+		    // and allocate from its memory
+		    core::memory::local(core::memory::island(std::max(this->rank(), 0)));
+#endif
+
 		    DO_MEASURE(
 
 			       _evolve.firstCall(pop, data);
@@ -130,7 +137,15 @@ namespace dim
 
 			       , measureFiles, "total" );
 
+		    core::Random::local(NULL);
+#if defined(DIM_PMR)
+		    core::memory::local(NULL);
+#endif
+
 #ifdef MEASURE
+		    ss.str(""); ss << data.monitorPrefix << ".wait.count." << this->rank();
+		    std::ofstream(ss.str().c_str()) << data.parks() << " " << data.wakes() << std::endl;
+
 		    for ( std::map<std::string, std::ofstream*>::iterator it = measureFiles.begin(); it != measureFiles.end(); ++it )
 			{
 			    delete it->second;
@@ -160,16 +175,44 @@ namespace dim
 	    };
 	} // !smp
 
+	/**
+	 * Generation loop of an island: evolve, feedback, update, memorize and
+	 * migrate.
+	 *
+	 * With the synchronous feedbacker and migrator the islands wait for
+	 * each other twice a generation. In the overlapped mode (see overlap())
+	 * the feedbacks and the migrants of the generation g are only posted
+	 * and the generation g+1 evolves the residents while they are in
+	 * flight. The exchanges are then completed and the immigrants,
+	 * evolved in their turn, merged into the population before the
+	 * feedbacks of g+1 are computed. Each individual is thus evolved as
+	 * many times as in the blocking loop, but the migration probabilities
+	 * of g+1 are updated with the feedbacks of g instead of g+1, a lag of
+	 * one generation. The checkpoint sees the residents only, the
+	 * immigrants of the last generation being merged after it without
+	 * being evolved.
+	 *
+	 * With MEASURE, the overlap ratio is the part of the time the
+	 * exchanges were in flight which was spent evolving the residents
+	 * rather than waiting for them to complete. It is an upper bound of
+	 * the overlap actually achieved: nothing calls MPI while the residents
+	 * evolve, and an MPI library which only progresses its nonblocking
+	 * collectives inside MPI calls, like OpenMPI without a progress
+	 * thread, does most of the exchange in the wait anyway.
+	 */
 	template <typename EOT>
 	class Easy : public Base<EOT>
 	{
 	public:
-	    Easy(utils::CheckPoint<EOT>& checkpoint) : _checkpoint(checkpoint), _evolve(__dummyEvolve), _feedback(__dummyFeedback), _update(__dummyUpdate), _memorize(__dummyMemorize), _migrate(__dummyMigrate) {}
+	    Easy(utils::CheckPoint<EOT>& checkpoint) : _checkpoint(checkpoint), _evolve(__dummyEvolve), _feedback(__dummyFeedback), _update(__dummyUpdate), _memorize(__dummyMemorize), _migrate(__dummyMigrate), _overlap(false), _inFlight(false), _hidden(0), _exposed(0) {}
 
-	    Easy(evolver::Base<EOT>& evolver, feedbacker::Base<EOT>& feedbacker, vectorupdater::Base<EOT>& updater, memorizer::Base<EOT>& memorizer, migrator::Base<EOT>& migrator, utils::CheckPoint<EOT>& checkpoint) : _checkpoint(checkpoint), _evolve(evolver), _feedback(feedbacker), _update(updater), _memorize(memorizer), _migrate(migrator) {}
+	    Easy(evolver::Base<EOT>& evolver, feedbacker::Base<EOT>& feedbacker, vectorupdater::Base<EOT>& updater, memorizer::Base<EOT>& memorizer, migrator::Base<EOT>& migrator, utils::CheckPoint<EOT>& checkpoint) : _checkpoint(checkpoint), _evolve(evolver), _feedback(feedbacker), _update(updater), _memorize(memorizer), _migrate(migrator), _overlap(false), _inFlight(false), _hidden(0), _exposed(0) {}
 
 	    virtual ~Easy() {}
 
+	    /// overlaps the exchanges of a generation with the evolution of the next one
+	    void overlap(bool on) { _overlap = on; }
+
 	    void operator()(core::Pop<EOT>& pop, core::IslandData<EOT>& data)
 	    {
 		std::map<std::string, std::ofstream*> measureFiles;
@@ -197,8 +240,25 @@ namespace dim
 
 		ss.str(""); ss << data.monitorPrefix << ".migrate.time." << this->rank();
 		measureFiles["migrate"] = new std::ofstream(ss.str().c_str());
+
+		if (_overlap)
+		    {
+			ss.str(""); ss << data.monitorPrefix << ".wait.time." << this->rank();
+			measureFiles["wait"] = new std::ofstream(ss.str().c_str());
+
+			ss.str(""); ss << data.monitorPrefix << ".evolve_arrivals.time." << this->rank();
+			measureFiles["evolve_arrivals"] = new std::ofstream(ss.str().c_str());
+		    }
 #endif // !MEASURE
 
+		_inFlight = false;
+		_hidden = _exposed = 0;
+
+		core::Random::local(&data.random);
+#if defined(DIM_PMR)
+		core::memory::local(core::memory::island(std::max(this->rank(), 0)));
+#endif
+
 		DO_MEASURE(
 
 			   _evolve.firstCall(pop, data);
@@ -210,6 +270,12 @@ namespace dim
 
 			   while ( ( data.toContinue = _checkpoint(pop) ) )
 			       {
+				   if (_overlap)
+				       {
+					   DO_MEASURE( overlapped(pop, data, measureFiles), measureFiles, "gen" );
+					   continue;
+				       }
+
 				   DO_MEASURE( DO_MEASURE(_evolve(pop, data), measureFiles, "evolve");
 					       DO_MEASURE(_feedback(pop, data), measureFiles, "feedback");
 					       DO_MEASURE(_update(pop, data), measureFiles, "update");
@@ -218,6 +284,9 @@ namespace dim
 					       , measureFiles, "gen" );
 			       }
 
+			   // the exchanges are collective, every island completes the last ones
+			   if (_inFlight) { complete(pop, data, false, measureFiles); }
+
 			   _evolve.lastCall(pop, data);
 			   _feedback.lastCall(pop, data);
 			   _update.lastCall(pop, data);
@@ -226,7 +295,23 @@ namespace dim
 
 			   , measureFiles, "total" );
 
+		core::Random::local(NULL);
+#if defined(DIM_PMR)
+		core::memory::local(NULL);
+#endif
+
 #ifdef MEASURE
+		ss.str(""); ss << data.monitorPrefix << ".wait.count." << this->rank();
+		std::ofstream(ss.str().c_str()) << data.parks() << " " << data.wakes() << std::endl;
+
+		if (_overlap)
+		    {
+			// microseconds evolving and waiting while the exchanges were in flight, then the ratio
+			ss.str(""); ss << data.monitorPrefix << ".overlap.ratio." << this->rank();
+			std::ofstream(ss.str().c_str()) << _hidden << " " << _exposed << " "
+						       << ( _hidden + _exposed ? double(_hidden) / (_hidden + _exposed) : 0 ) << std::endl;
+		    }
+
 		for ( std::map<std::string, std::ofstream*>::iterator it = measureFiles.begin(); it != measureFiles.end(); ++it )
 		    {
 			delete it->second;
@@ -234,6 +319,47 @@ namespace dim
 #endif // !MEASURE
 	    }
 
+	private:
+	    /// one generation of the overlapped mode, the exchanges of the previous one being in flight
+	    void overlapped(core::Pop<EOT>& pop, core::IslandData<EOT>& data, std::map<std::string, std::ofstream*>& measureFiles)
+	    {
+		if (_inFlight)
+		    {
+			DO_MEASURE( DO_ACCUMULATE(_evolve(pop, data), _hidden), measureFiles, "evolve" );
+			complete(pop, data, true, measureFiles);
+		    }
+		else
+		    {
+			DO_MEASURE(_evolve(pop, data), measureFiles, "evolve");
+		    }
+
+		DO_MEASURE(_feedback.post(pop, data), measureFiles, "feedback");
+		DO_MEASURE(_update(pop, data), measureFiles, "update");
+		DO_MEASURE(_memorize(pop, data), measureFiles, "memorize");
+		DO_MEASURE(_migrate.post(pop, data), measureFiles, "migrate");
+
+		_inFlight = true;
+	    }
+
+	    /// completes the exchanges in flight and merges the immigrants, evolving them first if asked
+	    void complete(core::Pop<EOT>& pop, core::IslandData<EOT>& data, bool evolve, std::map<std::string, std::ofstream*>& measureFiles)
+	    {
+		core::Pop<EOT> arrivals;
+
+		DO_MEASURE( DO_ACCUMULATE( _feedback.wait(pop, data); _migrate.wait(arrivals, data), _exposed ), measureFiles, "wait" );
+
+		if (evolve) { DO_MEASURE(_evolve(arrivals, data), measureFiles, "evolve_arrivals"); }
+
+		for (size_t i = 0; i < arrivals.size(); ++i)
+		    {
+			pop.push_back( MOVE(arrivals[i]) );
+		    }
+
+		// a migrator migrating at once in post() already set it
+		if ( _migrate.split() ) { pop.setInputSize( arrivals.size() ); }
+		_inFlight = false;
+	    }
+
 	public:
 	    struct DummyEvolver : public evolver::Base<EOT> { void operator()(core::Pop<EOT>&, core::IslandData<EOT>&) {} } __dummyEvolve;
 	    struct DummyFeedbacker : public feedbacker::Base<EOT> { void operator()(core::Pop<EOT>&, core::IslandData<EOT>&) {} } __dummyFeedback;
@@ -248,6 +374,10 @@ namespace dim
 	    vectorupdater::Base<EOT>& _update;
 	    memorizer::Base<EOT>& _memorize;
 	    migrator::Base<EOT>& _migrate;
+
+	    bool _overlap;
+	    bool _inFlight; // exchanges posted and not completed yet
+	    unsigned long _hidden, _exposed; // microseconds evolving and waiting while they were in flight
 	};
     } // !algo
 } // !dim
@@ -64,14 +64,14 @@ namespace dim
 	 *
 	 * Based on STL's std::vector<bool> specialization.
 	 */
-	template <class FitT> class Bit: public Vector<FitT, bool>
+	template <class FitT, class Alloc = memory::DefaultAllocator<bool>::type> class Bit: public Vector<FitT, bool, Alloc>
 	{
 	public:
 
-	    using Vector< FitT, bool >::begin;
-	    using Vector< FitT, bool >::end;
-	    using Vector< FitT, bool >::resize;
-	    using Vector< FitT, bool >::size;
+	    using Vector< FitT, bool, Alloc >::begin;
+	    using Vector< FitT, bool, Alloc >::end;
+	    using Vector< FitT, bool, Alloc >::resize;
+	    using Vector< FitT, bool, Alloc >::size;
 
 	    /**
 	     * (Default) Constructor.
@@ -79,7 +79,7 @@ namespace dim
 	     * @param value Default value.
 	     */
 	    Bit(unsigned size = 0, bool value = false):
-		Vector<FitT, bool>(size, value) {}
+		Vector<FitT, bool, Alloc>(size, value) {}
 
 	    /// My class name.
 	    virtual std::string className() const
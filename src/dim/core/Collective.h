@@ -0,0 +1,340 @@
+// -*- mode: c++; c-indent-level: 4; c++-member-init-indent: 8; comment-column: 35; -*-
+
+/* This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+ * Authors:
+ * Caner Candan <caner.candan@univ-angers.fr>
+ */
+
+#ifndef _CORE_COLLECTIVE_H_
+#define _CORE_COLLECTIVE_H_
+
+#include <vector>
+#include <stdexcept>
+
+#include <boost/mpi.hpp>
+#include <boost/mpl/bool.hpp>
+
+#include "Pop.h"
+#include "Wire.h"
+
+namespace dim
+{
+    namespace core
+    {
+
+	/**
+	 * Transport of the synchronous migrations and feedbacks by MPI
+	 * collectives, over a duplicate of the world communicator. The
+	 * migrants are sent in their wire format (see wire::Encoded), or
+	 * serialized by boost when their type has none.
+	 *
+	 * A migration exchanges the number of bytes going to every island by
+	 * MPI_Alltoall, then the migrants themselves, in the wire format, by
+	 * MPI_Ialltoallv. The feedbacks are one flat array of fitnesses
+	 * exchanged by MPI_Ialltoall. Both are split into post*() and wait*()
+	 * so the caller can work while they are in flight.
+	 *
+	 * The exchanges of the counts and of the feedbacks always use the same
+	 * buffers, so they are persistent requests set up once with MPI 4
+	 * (MPI_Alltoall_init), and collectives started anew otherwise. MPI 3
+	 * has no persistent collectives, so an MPI 3.1 library such as the
+	 * OpenMPI of the usual toolchains only builds the second path.
+	 *
+	 * When the islands only exchange with some neighbours, the transport
+	 * can be built on a distributed graph of these neighbours instead, the
+	 * exchanges using the neighborhood collectives (MPI 3). Nothing can be
+	 * sent to the other islands then, and nothing comes from them.
+	 *
+	 * Every call is collective: the ranks call them in the same order, from
+	 * the thread calling MPI.
+	 */
+	template <typename EOT>
+	class Collective
+	{
+	public:
+	    typedef typename EOT::Fitness Fitness;
+
+	    /// exchanges with every island
+	    Collective() : _graph(false)
+	    {
+		MPI_Comm_dup( MPI_COMM_WORLD, &_comm );
+
+		int size;
+		MPI_Comm_size( _comm, &size );
+		for (int i = 0; i < size; ++i) { _peers.push_back(i); }
+
+		init();
+	    }
+
+#if MPI_VERSION >= 3
+	    /// exchanges with the given islands only, which have to exchange with this one too
+	    Collective(const std::vector<int>& neighbours) : _graph(true), _peers(neighbours)
+	    {
+		const int n = _peers.size();
+		MPI_Dist_graph_create_adjacent( MPI_COMM_WORLD, n, ptr(_peers), MPI_UNWEIGHTED, n, ptr(_peers), MPI_UNWEIGHTED, MPI_INFO_NULL, 0, &_comm );
+
+		init();
+	    }
+#endif
+
+	    ~Collective()
+	    {
+		int finalized;
+		MPI_Finalized( &finalized );
+		if ( finalized ) { return; }
+
+#if MPI_VERSION >= 4
+		MPI_Request_free( &_countsRequest );
+		MPI_Request_free( &_feedbacksRequest );
+#endif
+		MPI_Comm_free( &_comm );
+	    }
+
+	    /// the transport exchanging with every island, to be first called by every rank at the same point
+	    static Collective& shared()
+	    {
+		static Collective collective;
+		return collective;
+	    }
+
+	    /// islands exchanged with
+	    inline const std::vector<int>& peers() const { return _peers; }
+
+	    /**
+	     * Starts sending out[i] to every island i. The individuals are
+	     * serialized before it returns, so out can be changed or freed
+	     * while the migration is in flight. The individuals of the island
+	     * itself are not sent.
+	     */
+	    void postMigration(const std::vector< Pop<EOT> >& out)
+	    {
+		int rank;
+		MPI_Comm_rank( MPI_COMM_WORLD, &rank );
+
+		_sendBytes.clear();
+
+		std::vector<bool> sent( out.size(), false );
+
+		for (size_t s = 0; s < _peers.size(); ++s)
+		    {
+			const int peer = _peers[s];
+			size_t before = _sendBytes.size();
+
+			if ( peer != rank && !out[peer].empty() ) { save( out[peer], Encoded() ); }
+
+			_sendCounts[s] = _sendBytes.size() - before;
+			sent[peer] = true;
+		    }
+
+		for (size_t i = 0; i < out.size(); ++i)
+		    {
+			if ( !sent[i] && int(i) != rank && !out[i].empty() ) { throw std::runtime_error("Collective: migrants for an island which is not a neighbour"); }
+		    }
+
+		// the sizes first, to make room for the migrants
+#if MPI_VERSION >= 4
+		MPI_Start( &_countsRequest );
+		MPI_Wait( &_countsRequest, MPI_STATUS_IGNORE );
+#else
+		counts( _sendCounts, _recvCounts );
+#endif
+
+		displacements( _sendCounts, _sendDispls );
+		_recvBytes.resize( displacements( _recvCounts, _recvDispls ) );
+
+#if MPI_VERSION >= 3
+		if ( _graph )
+		    {
+			MPI_Ineighbor_alltoallv( ptr(_sendBytes), ptr(_sendCounts), ptr(_sendDispls), MPI_BYTE,
+						 ptr(_recvBytes), ptr(_recvCounts), ptr(_recvDispls), MPI_BYTE, _comm, &_migrationRequest );
+			return;
+		    }
+#endif
+		MPI_Ialltoallv( ptr(_sendBytes), ptr(_sendCounts), ptr(_sendDispls), MPI_BYTE,
+				ptr(_recvBytes), ptr(_recvCounts), ptr(_recvDispls), MPI_BYTE, _comm, &_migrationRequest );
+	    }
+
+	    /// completes the migration, in[i] getting the individuals sent by the island i
+	    void waitMigration(std::vector< Pop<EOT> >& in)
+	    {
+		MPI_Wait( &_migrationRequest, MPI_STATUS_IGNORE );
+
+		int size;
+		MPI_Comm_size( MPI_COMM_WORLD, &size );
+		in.assign( size, Pop<EOT>() );
+
+		for (size_t s = 0; s < _peers.size(); ++s)
+		    {
+			if ( !_recvCounts[s] ) { continue; }
+
+			const char* first = ptr(_recvBytes) + _recvDispls[s];
+			load( first, first + _recvCounts[s], in[ _peers[s] ], Encoded() );
+		    }
+	    }
+
+	    /// sends out[i] to every island i and receives in[i] from it
+	    void migrate(const std::vector< Pop<EOT> >& out, std::vector< Pop<EOT> >& in)
+	    {
+		postMigration(out);
+		waitMigration(in);
+	    }
+
+	    /// starts sending the feedback out[i] to every island i
+	    void postFeedbacks(const std::vector<Fitness>& out)
+	    {
+		for (size_t s = 0; s < _peers.size(); ++s) { _feedbacksOut[s] = out[ _peers[s] ]; }
+
+#if MPI_VERSION >= 4
+		MPI_Start( &_feedbacksRequest );
+#else
+		MPI_Datatype type = boost::mpi::get_mpi_datatype<Fitness>( Fitness() );
+#if MPI_VERSION >= 3
+		if ( _graph )
+		    {
+			MPI_Ineighbor_alltoall( ptr(_feedbacksOut), 1, type, ptr(_feedbacksIn), 1, type, _comm, &_feedbacksRequest );
+			return;
+		    }
+#endif
+		MPI_Ialltoall( ptr(_feedbacksOut), 1, type, ptr(_feedbacksIn), 1, type, _comm, &_feedbacksRequest );
+#endif
+	    }
+
+	    /// completes the exchange of the feedbacks, in[i] getting the one of the island i (0 for the islands not exchanged with)
+	    void waitFeedbacks(std::vector<Fitness>& in)
+	    {
+		MPI_Wait( &_feedbacksRequest, MPI_STATUS_IGNORE );
+
+		int size;
+		MPI_Comm_size( MPI_COMM_WORLD, &size );
+		in.assign( size, Fitness(0) );
+
+		for (size_t s = 0; s < _peers.size(); ++s) { in[ _peers[s] ] = _feedbacksIn[s]; }
+	    }
+
+	    /// sends the feedback out[i] to every island i and receives in[i] from it
+	    void feedbacks(const std::vector<Fitness>& out, std::vector<Fitness>& in)
+	    {
+		postFeedbacks(out);
+		waitFeedbacks(in);
+	    }
+
+	private:
+	    typedef boost::mpl::bool_< wire::Encoded<EOT>::value > Encoded;
+
+	    template <typename T>
+	    static T* ptr(std::vector<T>& v) { return v.empty() ? NULL : &v[0]; }
+
+	    /// appends the individuals of pop to the bytes to send, in the wire format
+	    void save(const Pop<EOT>& pop, boost::mpl::true_)
+	    {
+		wire::save( _sendBytes, &pop[0], pop.size() );
+	    }
+
+	    /// or serialized by boost when EOT has none
+	    void save(const Pop<EOT>& pop, boost::mpl::false_)
+	    {
+		boost::mpi::packed_oarchive::buffer_type buffer;
+		boost::mpi::packed_oarchive oa( _comm, buffer );
+		oa << pop;
+		_sendBytes.insert( _sendBytes.end(), buffer.begin(), buffer.end() );
+	    }
+
+	    /// appends the individuals of the bytes [first, last) to pop
+	    static void load(const char* first, const char* last, Pop<EOT>& pop, boost::mpl::true_)
+	    {
+		while ( first < last )
+		    {
+			pop.push_back( EOT() );
+			first = wire::read( pop.back(), first );
+		    }
+	    }
+
+	    void load(const char* first, const char* last, Pop<EOT>& pop, boost::mpl::false_)
+	    {
+		boost::mpi::packed_iarchive::buffer_type buffer( first, last );
+		boost::mpi::packed_iarchive ia( _comm, buffer );
+		ia >> pop;
+	    }
+
+	    void init()
+	    {
+		const size_t n = _peers.size();
+
+		_sendCounts.assign(n, 0);
+		_recvCounts.assign(n, 0);
+		_sendDispls.assign(n, 0);
+		_recvDispls.assign(n, 0);
+		_feedbacksOut.assign(n, Fitness(0));
+		_feedbacksIn.assign(n, Fitness(0));
+
+#if MPI_VERSION >= 4
+		MPI_Datatype type = boost::mpi::get_mpi_datatype<Fitness>( Fitness() );
+
+		if ( _graph )
+		    {
+			MPI_Neighbor_alltoall_init( ptr(_sendCounts), 1, MPI_INT, ptr(_recvCounts), 1, MPI_INT, _comm, MPI_INFO_NULL, &_countsRequest );
+			MPI_Neighbor_alltoall_init( ptr(_feedbacksOut), 1, type, ptr(_feedbacksIn), 1, type, _comm, MPI_INFO_NULL, &_feedbacksRequest );
+		    }
+		else
+		    {
+			MPI_Alltoall_init( ptr(_sendCounts), 1, MPI_INT, ptr(_recvCounts), 1, MPI_INT, _comm, MPI_INFO_NULL, &_countsRequest );
+			MPI_Alltoall_init( ptr(_feedbacksOut), 1, type, ptr(_feedbacksIn), 1, type, _comm, MPI_INFO_NULL, &_feedbacksRequest );
+		    }
+#endif
+	    }
+
+#if MPI_VERSION < 4
+	    void counts(std::vector<int>& out, std::vector<int>& in)
+	    {
+#if MPI_VERSION >= 3
+		if ( _graph )
+		    {
+			MPI_Neighbor_alltoall( ptr(out), 1, MPI_INT, ptr(in), 1, MPI_INT, _comm );
+			return;
+		    }
+#endif
+		MPI_Alltoall( ptr(out), 1, MPI_INT, ptr(in), 1, MPI_INT, _comm );
+	    }
+#endif
+
+	    /// displacements of the segments of the given sizes, returning their total
+	    static size_t displacements(const std::vector<int>& counts, std::vector<int>& displs)
+	    {
+		size_t total = 0;
+		for (size_t s = 0; s < counts.size(); ++s)
+		    {
+			displs[s] = total;
+			total += counts[s];
+		    }
+		return total;
+	    }
+
+	    MPI_Comm _comm;
+	    bool _graph;
+	    std::vector<int> _peers; // island of each slot of the buffers
+
+	    std::vector<int> _sendCounts, _recvCounts, _sendDispls, _recvDispls;
+	    std::vector<char> _sendBytes, _recvBytes;
+	    std::vector<Fitness> _feedbacksOut, _feedbacksIn;
+
+	    MPI_Request _countsRequest; // persistent with MPI 4
+	    MPI_Request _migrationRequest;
+	    MPI_Request _feedbacksRequest; // persistent with MPI 4
+	};
+
+    }
+}
+
+#endif // !_CORE_COLLECTIVE_H_
@@ -0,0 +1,193 @@
+// -*- mode: c++; c-indent-level: 4; c++-member-init-indent: 8; comment-column: 35; -*-
+
+/* This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+ * Authors:
+ * Caner Candan <caner.candan@univ-angers.fr>
+ */
+
+#ifndef _CORE_FITNESSCACHE_H_
+#define _CORE_FITNESSCACHE_H_
+
+#if __cplusplus > 199711L
+#include <mutex>
+#else
+#include <boost/thread/mutex.hpp>
+#endif
+
+#include <vector>
+#include <cstddef>
+
+#include "Zobrist.h"
+
+namespace dim
+{
+    namespace core
+    {
+#if __cplusplus > 199711L
+	namespace std_or_boost = std;
+#else
+	namespace std_or_boost = boost;
+#endif
+
+	/**
+	 * Bounded cache of fitnesses keyed by the Zobrist hashes of the genomes.
+	 *
+	 * The entries are held in sets of a few ways, the set of a hash being
+	 * given by its low bits, and a full set replaces its entries in turn, so
+	 * the memory is fixed at construction. The sets are guarded by a fixed
+	 * number of locks, at most one per set, a set by the lock of its index
+	 * modulo the number of locks, so the islands of a process can share one
+	 * cache and only contend when they hit the same stripe.
+	 *
+	 * Two genomes with the same 64 bits hash share their entry, which is
+	 * unlikely enough to be ignored for the sizes of the populations.
+	 */
+	template <typename Fitness>
+	class FitnessCache
+	{
+	public:
+	    typedef zobrist::Hash Hash;
+
+	    static const size_t ways = 4;
+
+	    /**
+	     * @param capacity number of entries, rounded up to a power of two sets
+	     * @param stripes number of locks, rounded up to a power of two and at most the number of sets
+	     */
+	    FitnessCache(size_t capacity = 1 << 16, size_t stripes = 64)
+	    {
+		size_t sets = 1;
+		while ( sets * ways < capacity ) { sets <<= 1; }
+		_sets.resize(sets);
+		_setMask = sets - 1;
+
+		size_t n = 1;
+		while ( n < stripes && n < sets ) { n <<= 1; }
+		_stripes = new Stripe[n];
+		_stripeMask = n - 1;
+	    }
+
+	    ~FitnessCache() { delete[] _stripes; }
+
+	    /// number of entries
+	    inline size_t capacity() const { return _sets.size() * ways; }
+
+	    /// gives the fitness of the genome of hash h if it is cached
+	    bool find(Hash h, Fitness& fitness)
+	    {
+		const size_t index = h & _setMask;
+		Set& set = _sets[index];
+		Stripe& stripe = _stripes[ index & _stripeMask ];
+
+		std_or_boost::lock_guard<std_or_boost::mutex> lock(stripe.mutex);
+
+		for (size_t w = 0; w < set.used; ++w)
+		    {
+			if ( set.hashes[w] == h )
+			    {
+				fitness = set.fitnesses[w];
+				++stripe.hits;
+				return true;
+			    }
+		    }
+
+		++stripe.misses;
+		return false;
+	    }
+
+	    /// caches the fitness of the genome of hash h
+	    void insert(Hash h, const Fitness& fitness)
+	    {
+		const size_t index = h & _setMask;
+		Set& set = _sets[index];
+		Stripe& stripe = _stripes[ index & _stripeMask ];
+
+		std_or_boost::lock_guard<std_or_boost::mutex> lock(stripe.mutex);
+
+		for (size_t w = 0; w < set.used; ++w)
+		    {
+			if ( set.hashes[w] == h ) { set.fitnesses[w] = fitness; return; }
+		    }
+
+		size_t w = set.used < ways ? set.used++ : set.next++ % ways;
+		set.hashes[w] = h;
+		set.fitnesses[w] = fitness;
+	    }
+
+	    /// number of finds which gave a fitness
+	    unsigned long hits() const { return sum(&Stripe::hits); }
+
+	    /// number of finds which did not
+	    unsigned long misses() const { return sum(&Stripe::misses); }
+
+	    /// hits over finds, 0 before the first one
+	    double hitRate() const
+	    {
+		unsigned long h = hits(), m = misses();
+		return h + m ? double(h) / (h + m) : 0;
+	    }
+
+	    /// misses over finds, 0 before the first one
+	    double missRate() const
+	    {
+		unsigned long h = hits(), m = misses();
+		return h + m ? double(m) / (h + m) : 0;
+	    }
+
+	private:
+	    struct Set
+	    {
+		Set() : used(0), next(0) {}
+
+		Hash hashes[ways];
+		Fitness fitnesses[ways];
+		unsigned used;
+		unsigned next; // way replaced by the next insertion into the full set
+	    };
+
+	    struct Stripe
+	    {
+		Stripe() : hits(0), misses(0) {}
+
+		std_or_boost::mutex mutex;
+		unsigned long hits;
+		unsigned long misses;
+		char padding[64]; // the locks of two stripes are not on the same cache line
+	    };
+
+	    unsigned long sum(unsigned long Stripe::* counter) const
+	    {
+		unsigned long total = 0;
+		for (size_t s = 0; s <= _stripeMask; ++s)
+		    {
+			std_or_boost::lock_guard<std_or_boost::mutex> lock(_stripes[s].mutex);
+			total += _stripes[s].*counter;
+		    }
+		return total;
+	    }
+
+	    FitnessCache(const FitnessCache&);
+	    FitnessCache& operator=(const FitnessCache&);
+
+	    std::vector<Set> _sets;
+	    size_t _setMask;
+	    Stripe* _stripes;
+	    size_t _stripeMask;
+	};
+
+    }
+}
+
+#endif // !_CORE_FITNESSCACHE_H_
@@ -0,0 +1,127 @@
+// -*- mode: c++; c-indent-level: 4; c++-member-init-indent: 8; comment-column: 35; -*-
+
+/* This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+ * Authors:
+ * Caner Candan <caner.candan@univ-angers.fr>
+ */
+
+#ifndef _CORE_HISTORY_H_
+#define _CORE_HISTORY_H_
+
+#include <cstddef>
+
+#include <boost/cstdint.hpp>
+#include <boost/serialization/access.hpp>
+
+#ifndef VECTOR_HISTORY_CAPACITY
+#define VECTOR_HISTORY_CAPACITY 4
+#endif
+
+namespace dim
+{
+    namespace core
+    {
+
+	/**
+	 * Islands last visited by an individual, with its fitness when it left
+	 * them, oldest first.
+	 *
+	 * The entries are stored inline in a ring buffer of Capacity entries,
+	 * so recording a visit never allocates and the size of an individual
+	 * does not depend on its history. Only the used entries are serialized.
+	 *
+	 * The capacity is VECTOR_HISTORY_CAPACITY by default.
+	 */
+	template <typename FitT, unsigned Capacity = VECTOR_HISTORY_CAPACITY>
+	class History
+	{
+	public:
+	    friend class boost::serialization::access;
+
+	    struct Entry
+	    {
+		boost::uint32_t count; // number of generations spent in the island after the first one
+		boost::int32_t island;
+		FitT fitness;
+	    };
+
+	    History() : _first(0), _size(0) {}
+
+	    inline size_t size() const { return _size; }
+	    inline bool empty() const { return _size == 0; }
+	    static inline size_t capacity() { return Capacity; }
+
+	    /// the i-th oldest entry
+	    inline const Entry& operator[](size_t i) const { return _entries[ (_first + i) % Capacity ]; }
+	    inline Entry& operator[](size_t i) { return _entries[ (_first + i) % Capacity ]; }
+
+	    inline const Entry& back() const { return (*this)[_size - 1]; }
+	    inline Entry& back() { return (*this)[_size - 1]; }
+
+	    /**
+	     * Appends an entry, the oldest ones being dropped to keep at most
+	     * limit entries. A limit of 0 or above the capacity stands for the
+	     * capacity.
+	     */
+	    void push(int island, FitT fitness, size_t limit = Capacity)
+	    {
+		if ( !limit || limit > Capacity ) { limit = Capacity; }
+
+		while ( _size >= limit )
+		    {
+			_first = (_first + 1) % Capacity;
+			--_size;
+		    }
+
+		Entry& e = (*this)[_size++];
+		e.count = 0;
+		e.island = island;
+		e.fitness = fitness;
+	    }
+
+	    inline void clear() { _first = 0; _size = 0; }
+
+	private:
+	    template<class Archive>
+	    void serialize(Archive & ar, const unsigned int /*version*/)
+	    {
+		ar & _size;
+
+		// the entries are read back from the start of the buffer, only
+		// the newest ones being kept from an archive holding more
+		if ( Archive::is_loading::value )
+		    {
+			_first = 0;
+
+			Entry dropped;
+			for (; _size > Capacity; --_size) { ar & dropped.count & dropped.island & dropped.fitness; }
+		    }
+
+		for (unsigned i = 0; i < _size; ++i)
+		    {
+			Entry& e = (*this)[i];
+			ar & e.count & e.island & e.fitness;
+		    }
+	    }
+
+	    Entry _entries[Capacity];
+	    unsigned _first;
+	    unsigned _size;
+	};
+
+    } // !core
+} // !dim
+
+#endif // !_CORE_HISTORY_H_
@@ -39,8 +39,13 @@
 
 #include <vector>
 #include <queue>
+#include <deque>
 
 #include "ParallelContext.h"
+#include "Mailbox.h"
+#include "MigrantPool.h"
+#include "WaitPolicy.h"
+#include "Random.h"
 
 #include <boost/utility/identity_type.hpp>
 
@@ -61,9 +66,11 @@ namespace dim
 	namespace std_or_boost = boost;
 #endif
 
-	template <typename T>
+	template <typename T, typename Alloc = typename memory::DefaultAllocator<T>::type>
 	struct DataQueue
 	{
+	    typedef std_or_boost::chrono::time_point< std_or_boost::chrono::system_clock > TimePoint;
+
 	    DataQueue() {}
 	    DataQueue(const DataQueue& d) { *this = d; }
 
@@ -74,6 +81,7 @@ namespace dim
 	    		dataQueue = d.dataQueue;
 	    		timesQueue = d.timesQueue;
 	    		idQueue = d.idQueue;
+			waitPolicy = d.waitPolicy;
 	    	    }
 		return *this;
 	    }
@@ -81,16 +89,20 @@ namespace dim
 	    virtual ~DataQueue() {}
 
 	    std_or_boost::mutex mutex;
-	    std::queue<T> dataQueue;
-	    std::queue< std_or_boost::chrono::time_point< std_or_boost::chrono::system_clock > > timesQueue;
-	    std::queue<size_t> idQueue;
+	    std::queue< T, std::deque<T, Alloc> > dataQueue;
+	    std::queue< TimePoint, std::deque< TimePoint, typename memory::Rebind<Alloc, TimePoint>::type > > timesQueue;
+	    std::queue< size_t, std::deque< size_t, typename memory::Rebind<Alloc, size_t>::type > > idQueue;
+	    WaitPolicy waitPolicy;
 
 	    void push(T newData, size_t id = 0)
 	    {
-		std_or_boost::lock_guard<std_or_boost::mutex> lock(mutex);
-		dataQueue.push(newData);
-		timesQueue.push(std_or_boost::chrono::system_clock::now());
-		idQueue.push(id);
+		{
+		    std_or_boost::lock_guard<std_or_boost::mutex> lock(mutex);
+		    dataQueue.push(newData);
+		    timesQueue.push(std_or_boost::chrono::system_clock::now());
+		    idQueue.push(id);
+		}
+		waitPolicy.notify();
 	    }
 
 	    std_or_boost::tuple<T, double, size_t> pop(bool wait = false)
@@ -98,7 +110,7 @@ namespace dim
 		// waiting while queue is empty
 		if (wait)
 		    {
-			while ( empty() ) {}
+			waitPolicy.wait(*this);
 		    }
 		else
 		    {
@@ -173,6 +185,34 @@ namespace dim
 		    }
 		return sum;
 	    }
+
+	    void waitPolicy(WaitPolicy::Strategy strategy)
+	    {
+		for (size_t i = 0; i < std::vector< DataQueue< T > >::size(); ++i)
+		    {
+			(*this)[i].waitPolicy.strategy(strategy);
+		    }
+	    }
+
+	    size_t parks() const
+	    {
+		size_t sum = 0;
+		for (size_t i = 0; i < std::vector< DataQueue< T > >::size(); ++i)
+		    {
+			sum += (*this)[i].waitPolicy.parks();
+		    }
+		return sum;
+	    }
+
+	    size_t wakes() const
+	    {
+		size_t sum = 0;
+		for (size_t i = 0; i < std::vector< DataQueue< T > >::size(); ++i)
+		    {
+			sum += (*this)[i].waitPolicy.wakes();
+		    }
+		return sum;
+	    }
 	};
 
 	template <typename EOT>
@@ -196,7 +236,8 @@ namespace dim
 		  migratorSendingQueue(size()),
 		  toContinue(true),
 		  bar(size()),
-		  monitorPrefix(__monitorPrefix)
+		  monitorPrefix(__monitorPrefix),
+		  random(Random::master(), std::max(rank(), 0))
 	    {}
 
 	    IslandData(const IslandData& d)
@@ -223,23 +264,52 @@ namespace dim
 			feedbackerReceivingQueue = d.feedbackerReceivingQueue;
 			migratorSendingQueue = d.migratorSendingQueue;
 			migratorReceivingQueue = d.migratorReceivingQueue;
+			migrantHandles = d.migrantHandles;
 			monitorPrefix = d.monitorPrefix;
+			random = d.random;
 		    }
 		return *this;
 	    }
 
 	    virtual ~IslandData() {}
 
+	    /// Sets how the threads of this island wait for their queues, Spin by default.
+	    void waitPolicy(WaitPolicy::Strategy strategy)
+	    {
+		feedbackerSendingQueue.waitPolicy(strategy);
+		feedbackerReceivingQueue.waitPolicy().strategy(strategy);
+		migratorSendingQueue.waitPolicy(strategy);
+		migratorReceivingQueue.waitPolicy().strategy(strategy);
+		migrantHandles.waitPolicy().strategy(strategy);
+	    }
+
+	    /// Number of times a thread of this island went to sleep on an empty queue
+	    size_t parks() const
+	    {
+		return feedbackerSendingQueue.parks() + feedbackerReceivingQueue.waitPolicy().parks() +
+		    migratorSendingQueue.parks() + migratorReceivingQueue.waitPolicy().parks() +
+		    migrantHandles.waitPolicy().parks();
+	    }
+
+	    /// Number of times a producer had to wake up a parked thread of this island
+	    size_t wakes() const
+	    {
+		return feedbackerSendingQueue.wakes() + feedbackerReceivingQueue.waitPolicy().wakes() +
+		    migratorSendingQueue.wakes() + migratorReceivingQueue.waitPolicy().wakes() +
+		    migrantHandles.waitPolicy().wakes();
+	    }
+
 	    std::vector< Fitness > feedbacks;
 	    std::vector< std_or_boost::chrono::time_point< std_or_boost::chrono::system_clock > > feedbackLastUpdatedTimes;
 	    std_or_boost::chrono::time_point< std_or_boost::chrono::system_clock > vectorLastUpdatedTime;
 	    std::vector< unsigned > proba;
 
 	    DataQueueVector< Fitness > feedbackerSendingQueue;
-	    DataQueue< Fitness > feedbackerReceivingQueue;
+	    Mailbox< Fitness > feedbackerReceivingQueue;
 
 	    DataQueueVector< EOT > migratorSendingQueue;
-	    DataQueue< EOT > migratorReceivingQueue;
+	    Mailbox< EOT > migratorReceivingQueue;
+	    Mailbox< typename MigrantPool<EOT>::Handle > migrantHandles; // smp migrants waiting in MigrantPool<EOT>::shared()
 
 	    std_or_boost::atomic<bool> toContinue;
 	    // std_or_boost::condition_variable cv;
@@ -247,6 +317,9 @@ namespace dim
 	    boost::barrier bar;
 
 	    std::string monitorPrefix;
+
+	    /// generator of the operators of this island, seeded with the master seed and the rank
+	    Random random;
 	};
 
     } // !core
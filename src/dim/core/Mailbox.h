@@ -0,0 +1,363 @@
+// -*- mode: c++; c-indent-level: 4; c++-member-init-indent: 8; comment-column: 35; -*-
+
+/* This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+ * Authors:
+ * Caner Candan <caner.candan@univ-angers.fr>
+ */
+
+#ifndef _CORE_MAILBOX_H_
+#define _CORE_MAILBOX_H_
+
+#if __cplusplus > 199711L
+#include <tuple>
+#include <atomic>
+#include <chrono>
+#else
+#include <boost/tuple/tuple.hpp>
+#include <boost/chrono/chrono.hpp>
+#include <boost/atomic.hpp>
+#endif
+
+#include <cstddef>
+#include <stdexcept>
+
+#include "WaitPolicy.h"
+#include "Memory.h"
+
+#undef MOVE
+#if __cplusplus > 199711L
+# define MOVE(var) std::move(var)
+#else
+# define MOVE(var) var
+#endif
+
+namespace dim
+{
+    namespace core
+    {
+#if __cplusplus > 199711L
+	namespace std_or_boost = std;
+#else
+	namespace std_or_boost = boost;
+#endif
+
+	/**
+	 * Lock-free multi-producer single-consumer mailbox.
+	 *
+	 * It is a drop-in replacement of DataQueue for the receiving side of an
+	 * island: any number of threads (islands, MPI receivers) can push into
+	 * it concurrently without taking a lock, and only the owner island pops.
+	 *
+	 * The element, its arrival time and the id of its sender are kept in one
+	 * node so that a push costs one allocation and one atomic exchange. The
+	 * nodes come from the allocator, with DIM_PMR the one of the memory of
+	 * the pushing island, and go back to it whoever pops them. The
+	 * queue is unbounded by default, a positive capacity makes push() fail
+	 * instead of growing beyond it.
+	 *
+	 * The implementation is the intrusive MPSC queue of D. Vyukov: producers
+	 * swap themselves at the head and link the previous node afterwards, so
+	 * a pushed element may be counted by size() while still invisible to the
+	 * consumer for a few cycles.
+	 */
+	template <typename T, typename Alloc = typename memory::DefaultAllocator<T>::type>
+	class Mailbox
+	{
+	public:
+	    typedef std_or_boost::chrono::time_point< std_or_boost::chrono::system_clock > TimePoint;
+
+	    Mailbox(size_t capacity = 0) : _capacity(capacity), _count(0), _reserved(0)
+	    {
+		init();
+	    }
+
+	    /// Not thread-safe, only meant to be used while the islands are being set up.
+	    Mailbox(const Mailbox& m) : _capacity(m._capacity), _count(0), _reserved(0), _wait(m._wait)
+	    {
+		init();
+		copy(m);
+	    }
+
+	    /// Not thread-safe, only meant to be used while the islands are being set up.
+	    Mailbox& operator=(const Mailbox& m)
+	    {
+		if ( &m != this )
+		    {
+			clear();
+			_capacity = m._capacity;
+			_wait = m._wait;
+			copy(m);
+		    }
+		return *this;
+	    }
+
+	    virtual ~Mailbox()
+	    {
+		clear();
+		destroy(_tail);
+	    }
+
+	    /**
+	     * Push an element, can be called by any thread.
+	     *
+	     * @return false if the mailbox is bounded and full
+	     */
+	    bool push(const T& data, size_t id = 0)
+	    {
+		if ( !reserve() ) { return false; }
+		enqueue( create(data, id) );
+		_wait.notify();
+		return true;
+	    }
+
+#if __cplusplus > 199711L
+	    bool push(T&& data, size_t id = 0)
+	    {
+		if ( !reserve() ) { return false; }
+		enqueue( create(std::move(data), id) );
+		_wait.notify();
+		return true;
+	    }
+#endif
+
+	    /**
+	     * Move the oldest element out of the mailbox, consumer only.
+	     *
+	     * @param data receives the element
+	     * @param elapsed receives the time spent in the mailbox (ms)
+	     * @param id receives the id of the sender
+	     * @return false if nothing was available
+	     */
+	    bool try_pop(T& data, double& elapsed, size_t& id)
+	    {
+		Node* next = _tail->next.load(std_or_boost::memory_order_acquire);
+		if ( !next ) { return false; }
+
+		data = MOVE(next->data);
+		elapsed = since(next->time);
+		id = next->id;
+
+		release(next);
+		return true;
+	    }
+
+	    /**
+	     * DataQueue compatible pop, consumer only.
+	     *
+	     * Without waiting an exception is thrown if the mailbox is empty,
+	     * otherwise the consumer blocks according to the wait policy.
+	     */
+	    std_or_boost::tuple<T, double, size_t> pop(bool wait = false)
+	    {
+		if ( wait )
+		    {
+			_wait.wait(*this);
+		    }
+		else if ( empty() )
+		    {
+			throw std::runtime_error("The queue is empty.");
+		    }
+
+		T data;
+		double elapsed = 0;
+		size_t id = 0;
+
+		// a counted element may still be half-linked by its producer
+		while ( !try_pop(data, elapsed, id) ) {}
+
+		return std_or_boost::tuple<T, double, size_t>(MOVE(data), elapsed, id);
+	    }
+
+	    /**
+	     * Move every available element at the end of a population, consumer only.
+	     *
+	     * The time spent in the mailbox is stored as the receivedTime of each individual.
+	     *
+	     * @return the number of elements moved
+	     */
+	    template <typename Pop>
+	    size_t drain_into(Pop& pop)
+	    {
+		size_t n = 0;
+		Node* next;
+
+		while ( ( next = _tail->next.load(std_or_boost::memory_order_acquire) ) )
+		    {
+			next->data.receivedTime = since(next->time);
+			pop.push_back( MOVE(next->data) );
+			release(next);
+			++n;
+		    }
+
+		return n;
+	    }
+
+	    bool empty() const { return _count.load(std_or_boost::memory_order_acquire) == 0; }
+
+	    size_t size() const { return _count.load(std_or_boost::memory_order_acquire); }
+
+	    size_t capacity() const { return _capacity; }
+
+	    /// Blocks the consumer until something has been pushed, according to the wait policy.
+	    void wait() { _wait.wait(*this); }
+
+	    WaitPolicy& waitPolicy() { return _wait; }
+	    const WaitPolicy& waitPolicy() const { return _wait; }
+
+	private:
+	    struct Node
+	    {
+		Node() : next(NULL), id(0) {}
+		Node(const T& d, size_t i) : next(NULL), data(d), time(std_or_boost::chrono::system_clock::now()), id(i) {}
+#if __cplusplus > 199711L
+		Node(T&& d, size_t i) : next(NULL), data(std::move(d)), time(std_or_boost::chrono::system_clock::now()), id(i) {}
+#endif
+
+		std_or_boost::atomic<Node*> next;
+		T data;
+		TimePoint time;
+		size_t id;
+	    };
+
+	    typedef typename memory::Rebind<Alloc, Node>::type NodeAllocator;
+
+	    Node* create(const T& data, size_t id)
+	    {
+		Node* node = _allocator.allocate(1);
+		try
+		    {
+			::new (static_cast<void*>(node)) Node(data, id);
+		    }
+		catch (...)
+		    {
+			_allocator.deallocate(node, 1);
+			throw;
+		    }
+		return node;
+	    }
+
+#if __cplusplus > 199711L
+	    Node* create(T&& data, size_t id)
+	    {
+		Node* node = _allocator.allocate(1);
+		try
+		    {
+			::new (static_cast<void*>(node)) Node(std::move(data), id);
+		    }
+		catch (...)
+		    {
+			_allocator.deallocate(node, 1);
+			throw;
+		    }
+		return node;
+	    }
+#endif
+
+	    Node* create()
+	    {
+		Node* node = _allocator.allocate(1);
+		::new (static_cast<void*>(node)) Node;
+		return node;
+	    }
+
+	    void destroy(Node* node)
+	    {
+		node->~Node();
+		_allocator.deallocate(node, 1);
+	    }
+
+	    void init()
+	    {
+		_tail = create();
+		_head.store(_tail, std_or_boost::memory_order_relaxed);
+	    }
+
+	    bool reserve()
+	    {
+		if ( !_capacity ) { return true; }
+
+		if ( _reserved.fetch_add(1, std_or_boost::memory_order_relaxed) >= _capacity )
+		    {
+			_reserved.fetch_sub(1, std_or_boost::memory_order_relaxed);
+			return false;
+		    }
+		return true;
+	    }
+
+	    void enqueue(Node* node)
+	    {
+		// counted before being linked so that the consumer never sees a negative size
+		_count.fetch_add(1, std_or_boost::memory_order_release);
+		Node* prev = _head.exchange(node, std_or_boost::memory_order_acq_rel);
+		prev->next.store(node, std_or_boost::memory_order_release);
+	    }
+
+	    /// the popped node becomes the new stub, the old one is freed
+	    void release(Node* next)
+	    {
+		Node* tail = _tail;
+		_tail = next;
+		next->data = T();
+		destroy(tail);
+
+		_count.fetch_sub(1, std_or_boost::memory_order_relaxed);
+		if ( _capacity ) { _reserved.fetch_sub(1, std_or_boost::memory_order_relaxed); }
+	    }
+
+	    double since(const TimePoint& time) const
+	    {
+		TimePoint end = std_or_boost::chrono::system_clock::now();
+		double elapsed = std_or_boost::chrono::duration_cast<std_or_boost::chrono::microseconds>( end - time ).count() / 1000.;
+		if (!elapsed) { elapsed = 10e-10; } // temporary solution in order to have a positive number in elapsed value
+		return elapsed;
+	    }
+
+	    void clear()
+	    {
+		T data;
+		double elapsed;
+		size_t id;
+		while ( try_pop(data, elapsed, id) ) {}
+	    }
+
+	    void copy(const Mailbox& m)
+	    {
+		for ( Node* node = m._tail->next.load(); node; node = node->next.load() )
+		    {
+			Node* n = create(node->data, node->id);
+			n->time = node->time;
+			if ( _capacity ) { _reserved.fetch_add(1); }
+			enqueue(n);
+		    }
+	    }
+
+	    size_t _capacity;
+
+	    // producers and consumer sides are kept on separate cache lines
+	    char _pad0[64];
+	    std_or_boost::atomic<Node*> _head;
+	    char _pad1[64];
+	    Node* _tail;
+	    std_or_boost::atomic<size_t> _count;
+	    std_or_boost::atomic<size_t> _reserved;
+
+	    WaitPolicy _wait;
+	    NodeAllocator _allocator;
+	};
+
+    } // !core
+} // !dim
+
+#endif /* _CORE_MAILBOX_H_ */
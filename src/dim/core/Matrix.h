@@ -23,6 +23,8 @@
 #include <vector>
 #include <eo>
 
+#include "Random.h"
+
 namespace dim
 {
     namespace core
@@ -151,7 +153,7 @@ namespace dim
 					if (_initG)
 					    matrix(i,j) = (1000 - _same) / (matrix.size()-1);
 					else
-					    matrix(i,j) = eo::rng.rand();
+					    matrix(i,j) = Random::local().rand();
 					sum += matrix(i,j);
 				    }
 			    }
@@ -0,0 +1,116 @@
+// -*- mode: c++; c-indent-level: 4; c++-member-init-indent: 8; comment-column: 35; -*-
+
+/* This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+ * Authors:
+ * Caner Candan <caner.candan@univ-angers.fr>
+ */
+
+#include "Memory.h"
+
+#if defined(DIM_PMR)
+
+#include <deque>
+#include <mutex>
+
+#if defined(DIM_NUMA)
+#include <numa.h>
+#endif
+
+namespace dim
+{
+    namespace core
+    {
+	namespace memory
+	{
+	    namespace
+	    {
+		thread_local std::pmr::memory_resource* binding = NULL;
+
+		struct Island
+		{
+		    Island(size_t arena)
+			: arena(arena ? arena : 1, &node),
+			  pool(arena ? static_cast<std::pmr::memory_resource*>(&this->arena) : &node)
+		    {}
+
+		    NodeResource node;
+		    std::pmr::monotonic_buffer_resource arena;
+		    std::pmr::synchronized_pool_resource pool;
+		};
+
+		std::mutex islandsMutex;
+
+		// never destroyed on purpose: individuals of static or global
+		// populations may still give their blocks back after the static
+		// destructors of this file ran
+		std::deque< std::unique_ptr<Island> >& islands = *new std::deque< std::unique_ptr<Island> >;
+		size_t arenaSize = 0;
+	    }
+
+	    std::pmr::memory_resource* local()
+	    {
+		return binding ? binding : std::pmr::get_default_resource();
+	    }
+
+	    void local(std::pmr::memory_resource* resource)
+	    {
+		binding = resource;
+	    }
+
+	    void* NodeResource::do_allocate(size_t bytes, size_t alignment)
+	    {
+#if defined(DIM_NUMA)
+		// page aligned
+		if ( numa_available() >= 0 && alignment <= 4096 )
+		    {
+			void* p = numa_alloc_local(bytes);
+			if ( !p ) { throw std::bad_alloc(); }
+			return p;
+		    }
+#endif
+		return ::operator new(bytes, std::align_val_t(alignment));
+	    }
+
+	    void NodeResource::do_deallocate(void* p, size_t bytes, size_t alignment)
+	    {
+#if defined(DIM_NUMA)
+		if ( numa_available() >= 0 && alignment <= 4096 )
+		    {
+			numa_free(p, bytes);
+			return;
+		    }
+#endif
+		::operator delete(p, bytes, std::align_val_t(alignment));
+	    }
+
+	    std::pmr::memory_resource* island(size_t rank)
+	    {
+		std::lock_guard<std::mutex> lock(islandsMutex);
+		if ( islands.size() <= rank ) { islands.resize(rank + 1); }
+		if ( !islands[rank] ) { islands[rank].reset( new Island(arenaSize) ); }
+		return &islands[rank]->pool;
+	    }
+
+	    void arena(size_t bytes)
+	    {
+		std::lock_guard<std::mutex> lock(islandsMutex);
+		arenaSize = bytes;
+	    }
+
+	} // !memory
+    } // !core
+} // !dim
+
+#endif // !DIM_PMR
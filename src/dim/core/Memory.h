@@ -0,0 +1,161 @@
+// -*- mode: c++; c-indent-level: 4; c++-member-init-indent: 8; comment-column: 35; -*-
+
+/* This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+ * Authors:
+ * Caner Candan <caner.candan@univ-angers.fr>
+ */
+
+#ifndef _CORE_MEMORY_H_
+#define _CORE_MEMORY_H_
+
+#include <memory>
+#include <cstddef>
+
+#if defined(DIM_PMR)
+#if __cplusplus < 201703L
+#error "DIM_PMR needs C++17 (std::pmr)"
+#endif
+#include <memory_resource>
+#include <new>
+#endif
+
+namespace dim
+{
+    namespace core
+    {
+	/**
+	 * Memory of the islands.
+	 *
+	 * With DIM_PMR defined (C++17), the genes of the individuals, the
+	 * populations, the data queues and the nodes of the mailboxes allocate
+	 * through memory::Allocator, which takes its memory from the
+	 * std::pmr::memory_resource bound to the calling thread by
+	 * local(resource). The islands bind their own
+	 * resource, see island(), so that they do not share the global heap in
+	 * steady state. Without DIM_PMR the containers use std::allocator and
+	 * nothing changes.
+	 */
+	namespace memory
+	{
+#if defined(DIM_PMR)
+	    /// resource bound to the calling thread, the default resource if none
+	    std::pmr::memory_resource* local();
+
+	    /// binds a resource to the calling thread, NULL restores the default one
+	    void local(std::pmr::memory_resource* resource);
+
+	    /**
+	     * Stateless allocator drawing from the resource of the calling thread.
+	     *
+	     * The resource is stored in front of each block, so a block is given
+	     * back to the resource it comes from whatever the thread freeing it,
+	     * for instance after a migration. Since all the instances compare
+	     * equal, containers can be swapped and moved between islands.
+	     */
+	    template <typename T>
+	    class Allocator
+	    {
+	    public:
+		typedef T value_type;
+
+		static const size_t alignment = alignof(T) > alignof(std::max_align_t) ? alignof(T) : alignof(std::max_align_t);
+		static const size_t header = alignment;
+
+		Allocator() {}
+		template <typename U> Allocator(const Allocator<U>&) {}
+
+		T* allocate(size_t n)
+		{
+		    std::pmr::memory_resource* resource = local();
+		    char* block = static_cast<char*>( resource->allocate(header + n * sizeof(T), alignment) );
+		    ::new (block) std::pmr::memory_resource*(resource);
+		    return reinterpret_cast<T*>(block + header);
+		}
+
+		void deallocate(T* p, size_t n)
+		{
+		    char* block = reinterpret_cast<char*>(p) - header;
+		    std::pmr::memory_resource* resource = *reinterpret_cast<std::pmr::memory_resource**>(block);
+		    resource->deallocate(block, header + n * sizeof(T), alignment);
+		}
+	    };
+
+	    template <typename T, typename U>
+	    inline bool operator==(const Allocator<T>&, const Allocator<U>&) { return true; }
+
+	    template <typename T, typename U>
+	    inline bool operator!=(const Allocator<T>&, const Allocator<U>&) { return false; }
+
+	    /**
+	     * Memory of the NUMA node of the calling thread.
+	     *
+	     * Uses numa_alloc_local with DIM_NUMA (link with -lnuma), the aligned
+	     * operator new otherwise. Meant to be the upstream of the other resources.
+	     */
+	    class NodeResource : public std::pmr::memory_resource
+	    {
+	    protected:
+		void* do_allocate(size_t bytes, size_t alignment);
+		void do_deallocate(void* p, size_t bytes, size_t alignment);
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept { return this == &other; }
+	    };
+
+	    /**
+	     * Ready-made resource of an island.
+	     *
+	     * A synchronized pool recycling the freed blocks, on top of an
+	     * optional monotonic arena (see arena()), on top of a NodeResource.
+	     * The pool is synchronized because migrants are freed by the islands
+	     * receiving them. The arena never gives memory back but the pool does
+	     * not ask it for more once the island reached its steady state.
+	     *
+	     * The resource is created on the first call and never destroyed, not
+	     * even at exit, so that it outlives the individuals. Nothing is
+	     * allocated before the first allocation, done by the island thread,
+	     * so the memory lies on the node of the island.
+	     */
+	    std::pmr::memory_resource* island(size_t rank);
+
+	    /// size of the monotonic arena of the islands created afterwards, 0 (default) for none
+	    void arena(size_t bytes);
+#endif // !DIM_PMR
+
+	    /// allocator of the containers of dim
+	    template <typename T>
+	    struct DefaultAllocator
+	    {
+#if defined(DIM_PMR)
+		typedef Allocator<T> type;
+#else
+		typedef std::allocator<T> type;
+#endif
+	    };
+
+	    /// the allocator Alloc rebound to the type U
+	    template <typename Alloc, typename U>
+	    struct Rebind
+	    {
+#if __cplusplus > 199711L
+		typedef typename std::allocator_traits<Alloc>::template rebind_alloc<U> type;
+#else
+		typedef typename Alloc::template rebind<U>::other type;
+#endif
+	    };
+
+	} // !memory
+    } // !core
+} // !dim
+
+#endif /* _CORE_MEMORY_H_ */
@@ -0,0 +1,163 @@
+// -*- mode: c++; c-indent-level: 4; c++-member-init-indent: 8; comment-column: 35; -*-
+
+/* This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+ * Authors:
+ * Caner Candan <caner.candan@univ-angers.fr>
+ */
+
+#ifndef _CORE_MIGRANTPOOL_H_
+#define _CORE_MIGRANTPOOL_H_
+
+#if __cplusplus > 199711L
+#include <atomic>
+#else
+#include <boost/atomic.hpp>
+#endif
+
+#include <cstddef>
+#include <stdexcept>
+
+#include <boost/cstdint.hpp>
+
+namespace dim
+{
+    namespace core
+    {
+#if __cplusplus > 199711L
+	namespace std_or_boost = std;
+#else
+	namespace std_or_boost = boost;
+#endif
+
+	/**
+	 * Slots shared by the smp islands to hand individuals over.
+	 *
+	 * An island puts a migrant into a free slot and only the handle of the
+	 * slot travels through the mailbox of the destination, which takes the
+	 * migrant out and frees the slot. Putting and taking swap the individual
+	 * with the one of the slot, so the genes are never copied and a
+	 * migration costs the same whatever the length of the genome.
+	 *
+	 * The slots are allocated by chunks which are only freed with the pool,
+	 * so a handle can never point to reclaimed memory, and the free slots
+	 * are kept in a lock-free stack whose head is tagged with a counter
+	 * against the ABA problem. Any thread can put and take concurrently.
+	 *
+	 * EOT has to provide swap(EOT&), like Vector and PackedBit.
+	 */
+	template <typename EOT>
+	class MigrantPool
+	{
+	public:
+	    typedef boost::uint32_t Handle;
+
+	    static const size_t chunkSize = 1024;
+	    static const size_t maxChunks = 4096;
+
+	    MigrantPool() : _allocated(0), _free( pack(0, none) )
+	    {
+		for (size_t c = 0; c < maxChunks; ++c) { _chunks[c].store(NULL, std_or_boost::memory_order_relaxed); }
+	    }
+
+	    ~MigrantPool()
+	    {
+		for (size_t c = 0; c < maxChunks; ++c) { delete[] _chunks[c].load(); }
+	    }
+
+	    /// the pool of the smp islands of this type of individual
+	    static MigrantPool& shared()
+	    {
+		static MigrantPool pool;
+		return pool;
+	    }
+
+	    /// moves ind into a free slot, ind receives the previous content of the slot
+	    Handle put(EOT& ind)
+	    {
+		Handle h = acquire();
+		slot(h).ind.swap(ind);
+		return h;
+	    }
+
+	    /// moves the individual of a slot into ind and frees the slot
+	    void take(Handle h, EOT& ind)
+	    {
+		slot(h).ind.swap(ind);
+		release(h);
+	    }
+
+	    /// number of slots allocated so far, free or not
+	    size_t capacity() const { return _allocated.load(std_or_boost::memory_order_relaxed); }
+
+	private:
+	    static const Handle none = ~Handle(0);
+
+	    struct Slot
+	    {
+		EOT ind;
+		std_or_boost::atomic<Handle> next; // in the free stack
+	    };
+
+	    static inline boost::uint64_t pack(boost::uint32_t tag, Handle h) { return ( boost::uint64_t(tag) << 32 ) | h; }
+	    static inline Handle handle(boost::uint64_t head) { return Handle(head); }
+	    static inline boost::uint32_t tag(boost::uint64_t head) { return boost::uint32_t(head >> 32); }
+
+	    inline Slot& slot(Handle h) { return _chunks[h / chunkSize].load(std_or_boost::memory_order_acquire)[h % chunkSize]; }
+
+	    Handle acquire()
+	    {
+		boost::uint64_t head = _free.load(std_or_boost::memory_order_acquire);
+
+		while ( handle(head) != none )
+		    {
+			Handle h = handle(head);
+			Handle next = slot(h).next.load(std_or_boost::memory_order_relaxed);
+			if ( _free.compare_exchange_weak(head, pack(tag(head) + 1, next), std_or_boost::memory_order_acq_rel) ) { return h; }
+		    }
+
+		// no free slot, a new one is taken at the end
+		size_t h = _allocated.fetch_add(1, std_or_boost::memory_order_relaxed);
+		size_t c = h / chunkSize;
+		if ( c >= maxChunks ) { throw std::runtime_error("MigrantPool: too many migrants in flight"); }
+
+		if ( !_chunks[c].load(std_or_boost::memory_order_acquire) )
+		    {
+			Slot* chunk = new Slot[chunkSize];
+			Slot* expected = NULL;
+			if ( !_chunks[c].compare_exchange_strong(expected, chunk, std_or_boost::memory_order_acq_rel) ) { delete[] chunk; }
+		    }
+
+		return Handle(h);
+	    }
+
+	    void release(Handle h)
+	    {
+		boost::uint64_t head = _free.load(std_or_boost::memory_order_relaxed);
+		do
+		    {
+			slot(h).next.store(handle(head), std_or_boost::memory_order_relaxed);
+		    }
+		while ( !_free.compare_exchange_weak(head, pack(tag(head) + 1, h), std_or_boost::memory_order_acq_rel) );
+	    }
+
+	    std_or_boost::atomic<Slot*> _chunks[maxChunks];
+	    std_or_boost::atomic<size_t> _allocated;
+	    std_or_boost::atomic<boost::uint64_t> _free;
+	};
+
+    } // !core
+} // !dim
+
+#endif /* _CORE_MIGRANTPOOL_H_ */
@@ -0,0 +1,278 @@
+// -*- mode: c++; c-indent-level: 4; c++-member-init-indent: 8; comment-column: 35; -*-
+
+/* This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+ * Authors:
+ * Caner Candan <caner.candan@univ-angers.fr>
+ */
+
+#ifndef _CORE_PACKEDBIT_H_
+#define _CORE_PACKEDBIT_H_
+
+#include <string>
+#include <algorithm>
+#include <iostream>
+#include <cstddef>
+
+#include <boost/cstdint.hpp>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include "Vector.h"
+
+namespace dim
+{
+    namespace core
+    {
+
+	namespace detail
+	{
+	    /// number of ones of a 64 bits word
+	    inline unsigned popcount(boost::uint64_t w)
+	    {
+#if defined(__GNUC__)
+		return __builtin_popcountll(w);
+#else
+		w = w - ((w >> 1) & 0x5555555555555555ULL);
+		w = (w & 0x3333333333333333ULL) + ((w >> 2) & 0x3333333333333333ULL);
+		w = (w + (w >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+		return unsigned( (w * 0x0101010101010101ULL) >> 56 );
+#endif
+	    }
+
+#if defined(__AVX2__)
+	    /// number of ones of each 64 bits lane, by a lookup of the nibbles
+	    inline __m256i popcount(__m256i v)
+	    {
+		const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+							0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+		const __m256i low = _mm256_set1_epi8(0x0f);
+
+		__m256i lo = _mm256_shuffle_epi8( lookup, _mm256_and_si256(v, low) );
+		__m256i hi = _mm256_shuffle_epi8( lookup, _mm256_and_si256(_mm256_srli_epi16(v, 4), low) );
+
+		return _mm256_sad_epu8( _mm256_add_epi8(lo, hi), _mm256_setzero_si256() );
+	    }
+#endif
+
+	    /// number of ones of a[0..n), or of a[0..n) ^ b[0..n) when b is given
+	    inline size_t count(const boost::uint64_t* a, const boost::uint64_t* b, size_t n)
+	    {
+		size_t sum = 0;
+		size_t i = 0;
+
+#if defined(__AVX2__)
+		__m256i acc = _mm256_setzero_si256();
+		for (; i + 4 <= n; i += 4)
+		    {
+			__m256i v = _mm256_loadu_si256( (const __m256i*)(a + i) );
+			if ( b ) { v = _mm256_xor_si256( v, _mm256_loadu_si256( (const __m256i*)(b + i) ) ); }
+			acc = _mm256_add_epi64( acc, popcount(v) );
+		    }
+
+		boost::uint64_t lanes[4];
+		_mm256_storeu_si256( (__m256i*)lanes, acc );
+		sum = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#endif
+
+		if ( b )
+		    {
+			for (; i < n; ++i) { sum += popcount( a[i] ^ b[i] ); }
+		    }
+		else
+		    {
+			for (; i < n; ++i) { sum += popcount( a[i] ); }
+		    }
+
+		return sum;
+	    }
+	}
+
+	/**
+	 * Bit string stored in 64 bits words.
+	 *
+	 * It has the interface of Bit for the generic operators: size() and
+	 * operator[] are given in bits, the latter returning a proxy like
+	 * std::vector<bool>. The words are reachable by words() for the
+	 * operators working on whole words, the bits past size() in the last
+	 * word being always zero.
+	 *
+	 * The migration history of Vector is kept, and the words are serialized
+	 * as one array of integers instead of a sequence of booleans.
+	 *
+	 * @ingroup bitstring
+	 */
+	template <class FitT>
+	class PackedBit : public Vector<FitT, boost::uint64_t>
+	{
+	public:
+	    friend class boost::serialization::access;
+
+	    typedef boost::uint64_t Word;
+	    typedef Vector<FitT, Word> Base;
+	    typedef bool AtomType;
+
+	    static const unsigned bitsPerWord = 64;
+
+	    /// proxy to one bit
+	    class reference
+	    {
+	    public:
+		reference(Word& word, Word mask) : _word(word), _mask(mask) {}
+
+		operator bool() const { return (_word & _mask) != 0; }
+
+		reference& operator=(bool bit)
+		{
+		    if ( bit ) { _word |= _mask; } else { _word &= ~_mask; }
+		    return *this;
+		}
+
+		reference& operator=(const reference& r) { return *this = bool(r); }
+
+		void flip() { _word ^= _mask; }
+
+	    private:
+		Word& _word;
+		Word _mask;
+	    };
+
+	    /**
+	     * (Default) Constructor.
+	     * @param size Number of bits.
+	     * @param value Default value.
+	     */
+	    PackedBit(unsigned size = 0, bool value = false)
+		: Base(nwords(size), value ? ~Word(0) : Word(0)), _size(size)
+	    {
+		clearTail();
+	    }
+
+	    /// My class name.
+	    virtual std::string className() const
+	    {
+		return "PackedBit";
+	    }
+
+	    /// number of bits
+	    inline size_t size() const { return _size; }
+
+	    void resize(size_t size, bool value = false)
+	    {
+		size_t old = _size;
+		Base::resize( nwords(size), value ? ~Word(0) : Word(0) );
+		_size = size;
+
+		// the new bits of the old last word
+		if ( value && old < size && old % bitsPerWord )
+		    {
+			Base::operator[](old / bitsPerWord) |= ~Word(0) << (old % bitsPerWord);
+		    }
+
+		clearTail();
+	    }
+
+	    inline bool operator[](size_t i) const { return ( word(i) >> (i % bitsPerWord) ) & 1; }
+	    inline reference operator[](size_t i) { return reference( word(i), Word(1) << (i % bitsPerWord) ); }
+
+	    inline void flip(size_t i) { word(i) ^= Word(1) << (i % bitsPerWord); }
+
+	    /// number of ones
+	    inline size_t count() const { return detail::count( words(), NULL, nwords() ); }
+
+	    /// number of bits which differ from the ones of another bit string of the same size
+	    inline size_t hamming(const PackedBit& other) const
+	    {
+		return detail::count( words(), other.words(), nwords() );
+	    }
+
+	    /// exchanges two bit strings without copying their words
+	    void swap(PackedBit& other)
+	    {
+		Base::swap(other);
+		std::swap(_size, other._size);
+	    }
+
+	    inline size_t nwords() const { return Base::size(); }
+	    inline Word* words() { return nwords() ? &Base::operator[](0) : NULL; }
+	    inline const Word* words() const { return nwords() ? &Base::operator[](0) : NULL; }
+
+	    /// mask of the used bits of the last word
+	    inline Word tailMask() const
+	    {
+		return _size % bitsPerWord ? ( Word(1) << (_size % bitsPerWord) ) - 1 : ~Word(0);
+	    }
+
+	    /**
+	     * To print me on a stream, in the format of Bit.
+	     * @param os The std::ostream.
+	     */
+	    virtual void printOn(std::ostream& os) const
+	    {
+		EO<FitT>::printOn(os);
+		os << ' ';
+		os << size() << ' ';
+
+		std::string bits(size(), '0');
+		for (size_t i = 0; i < size(); ++i) { if ( (*this)[i] ) { bits[i] = '1'; } }
+		os << bits;
+	    }
+
+	    /**
+	     * To read me from a stream, in the format of Bit.
+	     * @param is The std::istream.
+	     */
+	    virtual void readFrom(std::istream& is)
+	    {
+		EO<FitT>::readFrom(is);
+		unsigned s;
+		is >> s;
+		std::string bits;
+		is >> bits;
+		if (is)
+		    {
+			resize(bits.size());
+			std::fill( words(), words() + nwords(), Word(0) );
+			for (size_t i = 0; i < bits.size(); ++i) { if ( bits[i] == '1' ) { flip(i); } }
+		    }
+	    }
+
+	    template<class Archive>
+	    void serialize(Archive & ar, const unsigned int /*version*/)
+	    {
+		ar & boost::serialization::base_object< Base >(*this);
+		ar & _size;
+	    }
+
+	private:
+	    // the iterators of the words are not the ones of the bits
+	    using Base::begin;
+	    using Base::end;
+
+	    static inline size_t nwords(size_t size) { return (size + bitsPerWord - 1) / bitsPerWord; }
+
+	    inline Word& word(size_t i) { return Base::operator[](i / bitsPerWord); }
+	    inline const Word& word(size_t i) const { return Base::operator[](i / bitsPerWord); }
+
+	    inline void clearTail() { if ( nwords() ) { Base::operator[](nwords() - 1) &= tailMask(); } }
+
+	    size_t _size;
+	};
+
+    } // !core
+} // !dim
+
+#endif // !_CORE_PACKEDBIT_H_
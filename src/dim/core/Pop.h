@@ -48,14 +48,14 @@
 
 #include <boost/mpi.hpp>
 
-#include <boost/archive/text_oarchive.hpp>
-#include <boost/archive/text_iarchive.hpp>
-
 #include <boost/serialization/vector.hpp>
 #include <boost/serialization/base_object.hpp>
 #include <boost/serialization/utility.hpp>
 #include <boost/serialization/assume_abstract.hpp>
 
+#include "Memory.h"
+#include "Wire.h"
+
 #if __cplusplus > 199711L
 #include <mutex>
 #else
@@ -89,27 +89,28 @@ namespace dim
 	 *
 	 * @ingroup Core
 	 */
-	template<class EOT>
-	class Pop: public std::vector<EOT>, public eoObject, public eoPersistent
+	template<class EOT, class Alloc = typename memory::DefaultAllocator<EOT>::type>
+	class Pop: public std::vector<EOT, Alloc>, public eoObject, public eoPersistent
 	{
 	public:
 	    friend class boost::serialization::access;
 
-	    using std::vector<EOT>::size;
-	    using std::vector<EOT>::resize;
-	    using std::vector<EOT>::operator[];
-	    using std::vector<EOT>::begin;
-	    using std::vector<EOT>::end;
+	    using std::vector<EOT, Alloc>::size;
+	    using std::vector<EOT, Alloc>::resize;
+	    using std::vector<EOT, Alloc>::operator[];
+	    using std::vector<EOT, Alloc>::begin;
+	    using std::vector<EOT, Alloc>::end;
 
 	    typedef typename EOT::Fitness Fitness;
+	    typedef std::vector<EOT, Alloc> ContainerType;
 #if defined(__CUDACC__)
-	    typedef typename std::vector<EOT>::iterator iterator;
-	    typedef typename std::vector<EOT>::const_iterator const_iterator;
+	    typedef typename ContainerType::iterator iterator;
+	    typedef typename ContainerType::const_iterator const_iterator;
 #endif
 
 	    /** Default ctor. Creates empty pop
 	     */
-	    Pop()   : std::vector<EOT>(), eoObject(), eoPersistent(), inputSize(0), outputSize(0)
+	    Pop()   : ContainerType(), eoObject(), eoPersistent(), inputSize(0), outputSize(0)
 	    {};
 
 	    /** Ctor for the initialization of chromosomes
@@ -118,7 +119,7 @@ namespace dim
 		@param _chromInit Initialization routine, produces EO's, needs to be an eoInit
 	    */
 	    Pop( unsigned _popSize, eoInit<EOT>& _chromInit )
-		: std::vector<EOT>(), inputSize(0), outputSize(0)
+		: ContainerType(), inputSize(0), outputSize(0)
 	    {
 		resize(_popSize);
 		for ( unsigned i = 0; i < _popSize; i++ )
@@ -174,7 +175,7 @@ namespace dim
 		each element should be in different lines
 		@param _is the stream
 	    */
-	    Pop( std::istream& _is ) :std::vector<EOT>()
+	    Pop( std::istream& _is ) :ContainerType()
 	    {
 		readFrom( _is );
 	    }
@@ -362,9 +363,9 @@ namespace dim
 
 
 	    /** does STL swap with other pop */
-	    void swap(Pop<EOT>& other)
+	    void swap(Pop& other)
 	    {
-		std::swap(static_cast<std::vector<EOT>& >(*this), static_cast<std::vector<EOT>& >(other));
+		std::swap(static_cast<ContainerType& >(*this), static_cast<ContainerType& >(other));
 	    }
 
 
@@ -442,7 +443,7 @@ namespace dim
 	    template<class Archive>
 	    void serialize(Archive & ar, const unsigned int /*version*/)
 	    {
-		ar & boost::serialization::base_object< std::vector<EOT> >(*this);
+		wire::serialize( ar, static_cast<ContainerType&>(*this) );
 		ar & inputSize & outputSize & outputSizes;
 	    }
 
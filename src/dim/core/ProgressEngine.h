@@ -0,0 +1,358 @@
+// -*- mode: c++; c-indent-level: 4; c++-member-init-indent: 8; comment-column: 35; -*-
+
+/* This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+ * Authors:
+ * Caner Candan <caner.candan@univ-angers.fr>
+ */
+
+#ifndef _CORE_PROGRESSENGINE_H_
+#define _CORE_PROGRESSENGINE_H_
+
+#include <boost/mpi.hpp>
+#include <boost/optional.hpp>
+#include <boost/serialization/vector.hpp>
+
+#if __cplusplus > 199711L
+#include <thread>
+#include <chrono>
+#include <atomic>
+#else
+#include <boost/thread.hpp>
+#include <boost/chrono/chrono.hpp>
+#include <boost/atomic.hpp>
+#endif
+
+#include <list>
+#include <vector>
+
+#include "Thread.h"
+#include "Wire.h"
+
+namespace dim
+{
+    namespace core
+    {
+#if __cplusplus > 199711L
+	namespace std_or_boost = std;
+#else
+	namespace std_or_boost = boost;
+#endif
+
+	/**
+	 * The only thread of a rank exchanging the asynchronous migrants and
+	 * feedbacks with the other ranks.
+	 *
+	 * The migrants and feedbacks going to the same peer are coalesced into
+	 * one packet, serialized as a single message (the migrants in the wire
+	 * format). A packet is sent once it holds maxPacket of them, once its
+	 * oldest one waited maxDelay microseconds, or when the island asks for
+	 * it with flush(), at the end of its generation. The packets in flight
+	 * are only kept until their sends complete.
+	 *
+	 * One nonblocking receive per peer stays posted during the whole run
+	 * and is posted again as soon as it completes, the packet being
+	 * unpacked in bulk into the receiving queues. When there is nothing to
+	 * do, the engine sleeps with an exponential backoff bounded by
+	 * maxSleep microseconds.
+	 *
+	 * The engine runs on the thread calling the ThreadsRunner, so it is
+	 * the only one calling MPI and the asynchronous islands work with
+	 * MPI_THREAD_FUNNELED. It uses a duplicate of the world communicator,
+	 * so its messages never match the ones of the other operators.
+	 *
+	 * It stops with the island (IslandData::toContinue). What the island
+	 * queued is then sent to every peer in a last packet, marked as the
+	 * end of the stream. The engine goes on receiving until every peer has
+	 * sent its own last packet and its sends in flight are complete, so no
+	 * packet is lost and no receive stays posted, the ranks stopping in
+	 * any order. A peer stopping first thus keeps serving the sends of the
+	 * others, whatever their size. Every rank has to stop its engine as
+	 * many times as the others, the next run posting the receives again.
+	 */
+	template <typename EOT>
+	class ProgressEngine : public Thread<EOT>
+	{
+	public:
+	    typedef typename EOT::Fitness Fitness;
+
+	    /// kinds of messages exchanged
+	    enum Kind { Migrants = 1, Feedbacks = 2 };
+
+	    ProgressEngine(size_t maxPacket = 64, unsigned maxDelay = 1000, unsigned maxSleep = 1000)
+		: _world( boost::mpi::communicator(), boost::mpi::comm_duplicate ), _kinds(0),
+		  _maxPacket(maxPacket), _maxDelay(maxDelay), _maxSleep(maxSleep),
+		  _flush(false), _packets(0), _items(0), _latency(0) {}
+
+	    /// the engine of the rank, to be first called by every rank at the same point (the communicator is duplicated)
+	    static ProgressEngine& shared()
+	    {
+		static ProgressEngine engine;
+		return engine;
+	    }
+
+	    /// exchanges the messages of a kind, the engine being run by tr
+	    void serve(Kind kind, ThreadsRunner<EOT>& tr)
+	    {
+		_kinds |= kind;
+		tr.main(*this);
+	    }
+
+	    /// number of migrants and feedbacks from which a packet is sent
+	    void maxPacket(size_t n) { _maxPacket = n ? n : 1; }
+
+	    /// microseconds from which a packet is sent, whatever its size
+	    void maxDelay(unsigned us) { _maxDelay = us; }
+
+	    /// sends every packet, what the island has queued so far included
+	    void flush() { _flush = true; }
+
+	    /// number of packets sent
+	    size_t packets() const { return _packets; }
+
+	    /// average number of migrants and feedbacks per packet sent
+	    double packetSize() const { return _packets ? double(_items) / _packets : 0; }
+
+	    /// number of packets whose send is not complete yet, none once the engine returned
+	    size_t inFlight() const { return _pending.size(); }
+
+	    /// average time in milliseconds between the queueing of the first migrant or feedback of a packet and its sending
+	    double flushLatency() const { return _packets ? _latency / 1000. / _packets : 0; }
+
+	    void operator()(Pop<EOT>& /*pop*/, IslandData<EOT>& data)
+	    {
+		post();
+
+		unsigned sleep = 0;
+
+		while ( data.toContinue )
+		    {
+			bool active = receive(data);
+			active = send(data) || active;
+			complete();
+
+			if ( active ) { sleep = 0; continue; }
+
+			std_or_boost::this_thread::sleep_for( std_or_boost::chrono::microseconds(sleep) );
+			sleep = sleep ? std::min(2 * sleep, _maxSleep) : 1;
+		    }
+
+		// what was queued goes with the last packets, the receives being
+		// served until every peer has sent its own
+		send(data);
+		end();
+		sleep = 0;
+
+		while ( !_receives.empty() || !_pending.empty() )
+		    {
+			bool active = receive(data);
+			complete();
+
+			if ( active ) { sleep = 0; continue; }
+
+			std_or_boost::this_thread::sleep_for( std_or_boost::chrono::microseconds(sleep) );
+			sleep = sleep ? std::min(2 * sleep, _maxSleep) : 1;
+		    }
+	    }
+
+	private:
+	    typedef std_or_boost::chrono::time_point<std_or_boost::chrono::system_clock> Time;
+
+	    /// migrants and feedbacks going to the same peer
+	    struct Packet
+	    {
+		Packet() : last(false) {}
+
+		std::vector<EOT> migrants;
+		std::vector<Fitness> feedbacks;
+		bool last; // end of the stream of the peer for this run
+		Time first; // queueing of the oldest one
+
+		size_t size() const { return migrants.size() + feedbacks.size(); }
+		void clear() { migrants.clear(); feedbacks.clear(); last = false; }
+
+		template <class Archive>
+		void serialize(Archive & ar, const unsigned int /*version*/) { wire::serialize(ar, migrants); ar & feedbacks; ar & last; }
+	    };
+
+	    struct Pending { Packet packet; boost::mpi::request request; };
+
+	    static const int tag = 1;
+
+	    /// one receive per peer, until its last packet
+	    void post()
+	    {
+		if ( _world.size() == 1 ) { return; }
+
+		const int n = _world.size();
+
+		_in.resize(n);
+		_out.resize(n);
+
+		for (int peer = 0; peer < n; ++peer)
+		    {
+			if ( peer == _world.rank() ) { continue; }
+
+			_receives.push_back( _world.irecv( peer, tag, _in[peer] ) );
+			_peers.push_back( peer );
+		    }
+	    }
+
+	    /// unpacks the completed receives and posts them again, until the last packet of their peer
+	    bool receive(IslandData<EOT>& data)
+	    {
+		bool active = false;
+
+		for (;;)
+		    {
+			boost::optional< std::pair< boost::mpi::status, std::vector<boost::mpi::request>::iterator > > done = boost::mpi::test_any( _receives.begin(), _receives.end() );
+			if ( !done ) { return active; }
+
+			size_t k = done->second - _receives.begin();
+			int peer = _peers[k];
+			Packet& in = _in[peer];
+
+			for (size_t i = 0; i < in.migrants.size(); ++i) { data.migratorReceivingQueue.push( in.migrants[i], peer ); }
+			for (size_t i = 0; i < in.feedbacks.size(); ++i) { data.feedbackerReceivingQueue.push( in.feedbacks[i], peer ); }
+			active = true;
+
+			if ( !in.last )
+			    {
+				in.clear();
+				_receives[k] = _world.irecv( peer, tag, in );
+				continue;
+			    }
+
+			// the peer sends nothing more until the next run
+			in.clear();
+			_receives.erase( _receives.begin() + k );
+			_peers.erase( _peers.begin() + k );
+		    }
+	    }
+
+	    /// drains the sending queues into the packets and sends the ones which are due
+	    bool send(IslandData<EOT>& data)
+	    {
+		// read first, what was queued before the flush is drained below
+		bool flush = _flush.exchange(false);
+		size_t sent = _packets;
+
+		Time now = std_or_boost::chrono::system_clock::now();
+
+		for (int peer = 0; peer < _world.size(); ++peer)
+		    {
+			if ( peer == _world.rank() ) { continue; }
+
+			Packet& out = _out[peer];
+
+			while ( ( _kinds & Migrants ) && !data.migratorSendingQueue.empty(peer) )
+			    {
+				std_or_boost::tuple<EOT, double, size_t> em = data.migratorSendingQueue.pop(peer);
+				if ( !out.size() ) { out.first = queued( now, std_or_boost::get<1>(em) ); }
+				out.migrants.push_back( std_or_boost::get<0>(em) );
+				if ( out.size() >= _maxPacket ) { ship(peer, now); }
+			    }
+
+			while ( ( _kinds & Feedbacks ) && !data.feedbackerSendingQueue.empty(peer) )
+			    {
+				std_or_boost::tuple<Fitness, double, size_t> fb = data.feedbackerSendingQueue.pop(peer);
+				if ( !out.size() ) { out.first = queued( now, std_or_boost::get<1>(fb) ); }
+				out.feedbacks.push_back( std_or_boost::get<0>(fb) );
+				if ( out.size() >= _maxPacket ) { ship(peer, now); }
+			    }
+
+			if ( out.size() && ( flush || waited(out, now) >= _maxDelay ) ) { ship(peer, now); }
+		    }
+
+		return _packets != sent;
+	    }
+
+	    /// sends the packet of a peer, the empty last ones not being counted
+	    void ship(int peer, Time now)
+	    {
+		Packet& out = _out[peer];
+
+		if ( out.size() )
+		    {
+			_packets += 1;
+			_items += out.size();
+			_latency += waited(out, now);
+		    }
+
+		_pending.push_back( Pending() );
+		Pending& p = _pending.back();
+		std::swap( p.packet.migrants, out.migrants );
+		std::swap( p.packet.feedbacks, out.feedbacks );
+		std::swap( p.packet.last, out.last );
+		p.request = _world.isend( peer, tag, p.packet );
+	    }
+
+	    /// sends every peer its last packet, with what is left of its migrants and feedbacks
+	    void end()
+	    {
+		Time now = std_or_boost::chrono::system_clock::now();
+
+		for (int peer = 0; peer < _world.size(); ++peer)
+		    {
+			if ( peer == _world.rank() ) { continue; }
+
+			_out[peer].last = true;
+			ship(peer, now);
+		    }
+	    }
+
+	    /// microseconds since the queueing of the oldest element of a packet
+	    static size_t waited(const Packet& packet, Time now)
+	    {
+		return std_or_boost::chrono::duration_cast<std_or_boost::chrono::microseconds>( now - packet.first ).count();
+	    }
+
+	    /// time of queueing of an element which waited elapsed milliseconds in its queue
+	    static Time queued(Time now, double elapsed)
+	    {
+		return now - std_or_boost::chrono::microseconds( static_cast<size_t>( elapsed * 1000 ) );
+	    }
+
+	    /// forgets the sends which are over, their packets being kept until then
+	    void complete()
+	    {
+		for (typename std::list<Pending>::iterator it = _pending.begin(); it != _pending.end(); )
+		    {
+			if ( it->request.test() ) { it = _pending.erase(it); } else { ++it; }
+		    }
+	    }
+
+	    boost::mpi::communicator _world;
+	    int _kinds;
+	    size_t _maxPacket;
+	    unsigned _maxDelay;
+	    unsigned _maxSleep;
+
+	    std_or_boost::atomic<bool> _flush;
+	    std_or_boost::atomic<size_t> _packets;
+	    std_or_boost::atomic<size_t> _items;
+	    std_or_boost::atomic<size_t> _latency; // microseconds
+
+	    std::vector<boost::mpi::request> _receives;
+	    std::vector<int> _peers; // peer of each receive, the ones which sent their last packet left out
+	    std::vector<Packet> _in;
+	    std::vector<Packet> _out;
+
+	    std::list<Pending> _pending;
+	};
+
+    }
+}
+
+#endif // !_CORE_PROGRESSENGINE_H_
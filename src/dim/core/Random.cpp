@@ -0,0 +1,213 @@
+// -*- mode: c++; c-indent-level: 4; c++-member-init-indent: 8; comment-column: 35; -*-
+
+/* This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+ * Authors:
+ * Caner Candan <caner.candan@univ-angers.fr>
+ */
+
+#if __cplusplus > 199711L
+#include <memory>
+#include <atomic>
+#else
+#include <boost/thread/tss.hpp>
+#include <boost/atomic.hpp>
+#endif
+
+#include "Random.h"
+
+namespace dim
+{
+    namespace core
+    {
+#if __cplusplus > 199711L
+	namespace std_or_boost = std;
+#else
+	namespace std_or_boost = boost;
+#endif
+
+	namespace
+	{
+	    const Random::uint64 JUMP[] = { 0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL, 0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL };
+	    const Random::uint64 LONG_JUMP[] = { 0x76e15d3efefdcbbfULL, 0xc5004e441c522fb3ULL, 0x77710069854ee241ULL, 0x39109bb02acbe635ULL };
+
+	    Random::uint64 splitmix(Random::uint64& x)
+	    {
+		Random::uint64 z = ( x += 0x9e3779b97f4a7c15ULL );
+		z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+		z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+		return z ^ (z >> 31);
+	    }
+
+	    Random::uint64 masterSeed = 0;
+	    std_or_boost::atomic<Random::uint64> threads(0);
+
+	    /// group and index of a thread, given by Random::local(group, index)
+	    struct Id
+	    {
+		Id(Random::uint64 g, Random::uint64 i) : group(g), index(i) {}
+		Random::uint64 group, index;
+	    };
+
+#if __cplusplus > 199711L
+	    thread_local Random* binding = NULL;
+	    thread_local std::unique_ptr<Random> owned;
+	    thread_local std::unique_ptr<Id> id;
+#else
+	    void keep(Random*) {}
+	    boost::thread_specific_ptr<Random> binding(keep);
+	    boost::thread_specific_ptr<Random> owned;
+	    boost::thread_specific_ptr<Id> id;
+#endif
+
+	    /// generator owned by a thread, seeded by its id or else by its rank among the threads seeded so far
+	    Random* own()
+	    {
+		const Random::uint64 seed = masterSeed ^ 0x9e3779b97f4a7c15ULL;
+		Random::uint64 x = id.get() ? id->group : 0;
+
+		// the groups get seeds apart from each other and from the threads without id
+		if ( id.get() ) { return new Random( seed ^ splitmix(x), id->index ); }
+		return new Random( seed, threads++ );
+	    }
+	}
+
+	void Random::seed(uint64 seed, uint64 stream)
+	{
+	    uint64 x = seed;
+	    for (int k = 0; k < 4; ++k) { _s[k][0] = splitmix(x); }
+
+	    for (uint64 i = 0; i < stream; ++i) { jump(0, LONG_JUMP); }
+
+	    for (unsigned l = 1; l < lanes; ++l)
+		{
+		    for (int k = 0; k < 4; ++k) { _s[k][l] = _s[k][l-1]; }
+		    jump(l, JUMP);
+		}
+
+	    _next = lanes;
+	}
+
+	void Random::jump(unsigned lane, const uint64* polynomial)
+	{
+	    uint64 s[4] = { _s[0][lane], _s[1][lane], _s[2][lane], _s[3][lane] };
+	    uint64 j[4] = { 0, 0, 0, 0 };
+
+	    for (int i = 0; i < 4; ++i)
+		{
+		    for (int b = 0; b < 64; ++b)
+			{
+			    if ( polynomial[i] & (uint64(1) << b) )
+				{
+				    for (int k = 0; k < 4; ++k) { j[k] ^= s[k]; }
+				}
+
+			    uint64 t = s[1] << 17;
+			    s[2] ^= s[0]; s[3] ^= s[1]; s[1] ^= s[2]; s[0] ^= s[3]; s[2] ^= t; s[3] = rotl(s[3], 45);
+			}
+		}
+
+	    for (int k = 0; k < 4; ++k) { _s[k][lane] = j[k]; }
+	}
+
+	void Random::step(uint64* out)
+	{
+	    uint64* s0 = _s[0];
+	    uint64* s1 = _s[1];
+	    uint64* s2 = _s[2];
+	    uint64* s3 = _s[3];
+
+	    for (unsigned l = 0; l < lanes; ++l)
+		{
+		    out[l] = rotl(s1[l] * 5, 7) * 9;
+
+		    uint64 t = s1[l] << 17;
+		    s2[l] ^= s0[l];
+		    s3[l] ^= s1[l];
+		    s1[l] ^= s2[l];
+		    s0[l] ^= s3[l];
+		    s2[l] ^= t;
+		    s3[l] = rotl(s3[l], 45);
+		}
+	}
+
+	void Random::fill(uint32* out, size_t count, uint32 n)
+	{
+	    // the numbers left by the scalar calls first, to keep the sequence
+	    for (; count && _next < lanes; --count) { *out++ = bound(_buffer[_next++], n); }
+
+	    uint64 block[lanes];
+	    for (; count >= lanes; count -= lanes, out += lanes)
+		{
+		    step(block);
+		    for (unsigned l = 0; l < lanes; ++l) { out[l] = bound(block[l], n); }
+		}
+
+	    for (; count; --count) { *out++ = random(n); }
+	}
+
+	void Random::fill(double* out, size_t count)
+	{
+	    for (; count && _next < lanes; --count) { *out++ = toDouble(_buffer[_next++]); }
+
+	    uint64 block[lanes];
+	    for (; count >= lanes; count -= lanes, out += lanes)
+		{
+		    step(block);
+		    for (unsigned l = 0; l < lanes; ++l) { out[l] = toDouble(block[l]); }
+		}
+
+	    for (; count; --count) { *out++ = uniform(); }
+	}
+
+	Random& Random::local()
+	{
+#if __cplusplus > 199711L
+	    if ( binding ) { return *binding; }
+#else
+	    if ( binding.get() ) { return *binding; }
+#endif
+	    if ( !owned.get() ) { owned.reset( own() ); }
+	    return *owned;
+	}
+
+	void Random::local(uint64 group, uint64 index)
+	{
+	    id.reset( new Id(group, index) );
+	    owned.reset();
+	}
+
+	void Random::local(Random* random)
+	{
+#if __cplusplus > 199711L
+	    binding = random;
+#else
+	    binding.reset(random);
+#endif
+	}
+
+	Random* Random::localBinding()
+	{
+#if __cplusplus > 199711L
+	    return binding;
+#else
+	    return binding.get();
+#endif
+	}
+
+	void Random::master(uint64 seed) { masterSeed = seed; }
+	Random::uint64 Random::master() { return masterSeed; }
+
+    }
+}
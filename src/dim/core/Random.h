@@ -0,0 +1,161 @@
+// -*- mode: c++; c-indent-level: 4; c++-member-init-indent: 8; comment-column: 35; -*-
+
+/* This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+ * Authors:
+ * Caner Candan <caner.candan@univ-angers.fr>
+ */
+#ifndef _CORE_RANDOM_H_
+#define _CORE_RANDOM_H_
+
+#include <boost/cstdint.hpp>
+
+#include <vector>
+#include <cstddef>
+
+namespace dim
+{
+    namespace core
+    {
+
+	/**
+	 * Random number generator of one island or one thread.
+	 *
+	 * It runs four xoshiro256** generators side by side, whose states are
+	 * stored word by word so that the bulk fill() functions advance the four
+	 * of them with vector instructions. The scalar functions read the same
+	 * sequence four numbers at a time, so mixing both interfaces does not
+	 * change the numbers drawn.
+	 *
+	 * The generators of the streams of a master seed are 2^192 steps apart
+	 * in the sequence of the seed (long jumps), and the four lanes of a
+	 * stream 2^128 steps apart (jumps), so a stream never overlaps another.
+	 *
+	 * The operators draw their numbers from local(), the generator bound to
+	 * the calling thread. The islands bind their own one, owned by their
+	 * IslandData and seeded with the master seed and their rank, so a run is
+	 * reproducible whatever the scheduling of the threads. A thread without
+	 * generator gets its own one on its first call, whose stream is given by
+	 * the id of the thread (see local(group, index)), the workers of a
+	 * ThreadPool being named after the pool and their index.
+	 */
+	class Random
+	{
+	public:
+	    typedef boost::uint64_t uint64;
+	    typedef boost::uint32_t uint32;
+
+	    static const unsigned lanes = 4;
+
+	    Random(uint64 seed = 0, uint64 stream = 0) { this->seed(seed, stream); }
+
+	    /**
+	     * Restarts the generator at the beginning of a stream of the seed.
+	     *
+	     * The stream is reached by that many long jumps, each costing 256
+	     * steps of the generator: fine for the numbers of islands and
+	     * threads, not for arbitrary large streams.
+	     */
+	    void seed(uint64 seed, uint64 stream = 0);
+
+	    /// 64 random bits
+	    inline uint64 next()
+	    {
+		if ( _next == lanes ) { step(_buffer); _next = 0; }
+		return _buffer[_next++];
+	    }
+
+	    /// 32 random bits, like eoRng::rand()
+	    inline uint32 rand() { return uint32( next() >> 32 ); }
+
+	    /// uniform integer in [0, n)
+	    inline uint32 random(uint32 n) { return bound( next(), n ); }
+
+	    /// uniform double in [0, 1)
+	    inline double uniform() { return toDouble( next() ); }
+
+	    /// true with the probability p
+	    inline bool flip(double p = 0.5) { return uniform() < p; }
+
+	    /// index drawn with a probability proportional to its weight, like eoRng::roulette_wheel()
+	    template <typename T>
+	    size_t roulette(const std::vector<T>& weights)
+	    {
+		double sum = 0;
+		for (size_t i = 0; i < weights.size(); ++i) { sum += weights[i]; }
+
+		double r = uniform() * sum;
+		size_t i = 0;
+		while ( i + 1 < weights.size() && ( r -= weights[i] ) >= 0 ) { ++i; }
+		return i;
+	    }
+
+	    /// fills out with count uniform integers in [0, n)
+	    void fill(uint32* out, size_t count, uint32 n);
+
+	    /// fills out with count uniform doubles in [0, 1)
+	    void fill(double* out, size_t count);
+
+	    /**
+	     * Generator of the calling thread.
+	     *
+	     * Either the one bound by local(Random*), or one owned by the thread
+	     * and seeded on its first call with a seed derived from the master
+	     * one. The stream is given by the id of the thread, or else is the
+	     * number of threads seeded before, which depends on the order the
+	     * threads start in and is not reproducible.
+	     */
+	    static Random& local();
+
+	    /// binds a generator to the calling thread, NULL falls back on its own one
+	    static void local(Random* random);
+
+	    /// generator bound to the calling thread by local(Random*), NULL if none
+	    static Random* localBinding();
+
+	    /**
+	     * Names the calling thread, its own generator being the stream index
+	     * of a seed derived from the master one and group, e.g. the worker
+	     * index of the pool group. The same names give the same numbers
+	     * whatever the order the threads start in.
+	     */
+	    static void local(uint64 group, uint64 index);
+
+	    /// seed of the streams of the islands and of the threads
+	    static void master(uint64 seed);
+	    static uint64 master();
+
+	private:
+	    /// advances the four lanes and writes their outputs
+	    void step(uint64* out);
+
+	    /// applies a jump polynomial to the state of one lane
+	    void jump(unsigned lane, const uint64* polynomial);
+
+	    static inline uint64 rotl(uint64 x, int k) { return (x << k) | (x >> (64 - k)); }
+
+	    /// multiply-shift reduction of the high 32 bits into [0, n)
+	    static inline uint32 bound(uint64 x, uint32 n) { return uint32( ( (x >> 32) * n ) >> 32 ); }
+
+	    static inline double toDouble(uint64 x) { return (x >> 11) * (1. / 9007199254740992.); }
+
+	    uint64 _s[4][lanes]; // word k of the state of each lane
+	    uint64 _buffer[lanes];
+	    unsigned _next;
+	};
+
+    }
+}
+
+#endif // !_CORE_RANDOM_H_
@@ -27,6 +27,7 @@
 // #endif
 
 #include <vector>
+#include <stdexcept>
 
 #include "BF.h"
 #include "Pop.h"
@@ -80,17 +81,33 @@ namespace dim
 	class ThreadsRunner
 	{
 	public:
+	    ThreadsRunner() : _main(NULL) {}
+
 	    void operator()(Pop<EOT>& pop, IslandData<EOT>& data)
 	    {
 #if __cplusplus > 199711L
 		for (auto& t : _vt) { t->build(pop, data); }
+		if ( _main ) { (*_main)(pop, data); }
 		for (auto& t : _vt) { t->join(); }
 #else
 		for (size_t i = 0; i < _vt.size(); ++i) { _vt[i]->build(pop, data); }
+		if ( _main ) { (*_main)(pop, data); }
 		for (size_t i = 0; i < _vt.size(); ++i) { _vt[i]->join(); }
 #endif
 	    }
 
+	    /**
+	     * Runs t on the calling thread once the other ones are started, for
+	     * the thread which has to be the main one, like the only thread
+	     * calling MPI with MPI_THREAD_FUNNELED.
+	     */
+	    ThreadsRunner& main(Thread<EOT>& t)
+	    {
+		if ( _main && _main != &t ) { throw std::runtime_error("ThreadsRunner: only one thread can run on the caller"); }
+		_main = &t;
+		return *this;
+	    }
+
 	    ThreadsRunner& add(Thread<EOT>& t)
 	    {
 		_vt.push_back(&t);
@@ -111,6 +128,7 @@ namespace dim
 
 	private:
 	    std::vector< Thread<EOT>* > _vt;
+	    Thread<EOT>* _main;
 	};
 
 #if __cplusplus > 199711L
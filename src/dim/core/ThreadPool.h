@@ -0,0 +1,249 @@
+// -*- mode: c++; c-indent-level: 4; c++-member-init-indent: 8; comment-column: 35; -*-
+
+/* This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+ * Authors:
+ * Caner Candan <caner.candan@univ-angers.fr>
+ */
+#ifndef _CORE_THREADPOOL_H_
+#define _CORE_THREADPOOL_H_
+
+#if __cplusplus > 199711L
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#else
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/chrono/chrono.hpp>
+#endif
+
+#include <boost/thread.hpp>
+
+#include <deque>
+#include <vector>
+#include <algorithm>
+
+#include "Random.h"
+
+namespace dim
+{
+    namespace core
+    {
+#if __cplusplus > 199711L
+	namespace std_or_boost = std;
+#else
+	namespace std_or_boost = boost;
+#endif
+
+	/**
+	 * Pool of worker threads shared by the islands of a process.
+	 *
+	 * run() splits a task in chunks which are executed by the workers and by
+	 * the calling thread itself, and returns once all of them are done. The
+	 * caller always takes part, so an island makes progress even when every
+	 * worker is busy with the chunks of other islands, and a pool without
+	 * worker simply runs the chunks in order.
+	 *
+	 * Chunks are handed out in increasing order but may complete in any
+	 * order: a task giving deterministic results stores the result of each
+	 * chunk apart and reduces them in chunk order once run() returns.
+	 *
+	 * The worker k of the pool id draws from the stream k of the group id
+	 * (see Random::local(group, index)). A worker runs other chunks from one
+	 * run to the next though, so a task drawing numbers in its chunks gives
+	 * each chunk its own generator (see evolver::Parallel).
+	 */
+	class ThreadPool
+	{
+	public:
+	    /// time spent by one run(), in seconds
+	    struct Stats
+	    {
+		Stats() : wall(0), busy(0), threads(0) {}
+
+		double wall; // from the call to the return of run()
+		double busy; // sum of the durations of the chunks
+		size_t threads; // number of threads which could take part
+
+		/// busy time over available time, 1 for a perfect parallel run
+		inline double efficiency() const { return wall > 0 && threads ? busy / (wall * threads) : 1; }
+	    };
+
+	    explicit ThreadPool(size_t workers = 0, size_t id = 0) : _stop(false)
+	    {
+		for (size_t k = 0; k < workers; ++k)
+		    {
+			_workers.push_back( new boost::thread(&ThreadPool::work, this, id, k) );
+		    }
+	    }
+
+	    ~ThreadPool()
+	    {
+		{
+		    std_or_boost::lock_guard<std_or_boost::mutex> lock(_mutex);
+		    _stop = true;
+		}
+		_pending.notify_all();
+
+		for (size_t k = 0; k < _workers.size(); ++k)
+		    {
+			_workers[k]->join();
+			delete _workers[k];
+		    }
+	    }
+
+	    /// number of worker threads
+	    inline size_t size() const { return _workers.size(); }
+
+	    /// number of threads running the chunks of one call, the caller included
+	    inline size_t concurrency() const { return _workers.size() + 1; }
+
+	    /**
+	     * Calls task(chunk) for every chunk in [0, chunks) and waits for them.
+	     *
+	     * @param stats if not null, filled with the timings of the call
+	     */
+	    template <typename Task>
+	    void run(Task& task, size_t chunks, Stats* stats = NULL)
+	    {
+		if ( !chunks ) { return; }
+
+		Clock::time_point start = Clock::now();
+
+		Batch batch( &call<Task>, &task, chunks, stats != NULL );
+
+		{
+		    std_or_boost::lock_guard<std_or_boost::mutex> lock(_mutex);
+		    _batches.push_back(&batch);
+		}
+		_pending.notify_all();
+
+		size_t chunk;
+		while ( claim(batch, chunk) ) { execute(batch, chunk); }
+
+		{
+		    std_or_boost::unique_lock<std_or_boost::mutex> lock(_mutex);
+		    while ( batch.done < batch.count ) { _finished.wait(lock); }
+		}
+
+		if ( stats )
+		    {
+			stats->wall = seconds( Clock::now() - start );
+			stats->busy = batch.busy;
+			stats->threads = std::min( concurrency(), chunks );
+		    }
+	    }
+
+	private:
+	    typedef std_or_boost::chrono::steady_clock Clock;
+
+	    struct Batch
+	    {
+		Batch(void (*c)(void*, size_t), void* t, size_t n, bool m)
+		    : call(c), task(t), count(n), next(0), done(0), timed(m), busy(0) {}
+
+		void (*call)(void*, size_t);
+		void* task;
+		size_t count;
+		size_t next;
+		size_t done;
+		bool timed;
+		double busy;
+	    };
+
+	    template <typename Task>
+	    static void call(void* task, size_t chunk) { (*static_cast<Task*>(task))(chunk); }
+
+	    static double seconds(Clock::duration d) { return std_or_boost::chrono::duration_cast< std_or_boost::chrono::duration<double> >(d).count(); }
+
+	    /// takes the next chunk of the batch, the lock being held
+	    void next(Batch& batch, size_t& chunk)
+	    {
+		chunk = batch.next++;
+		if ( batch.next == batch.count )
+		    {
+			_batches.erase( std::find(_batches.begin(), _batches.end(), &batch) );
+		    }
+	    }
+
+	    bool claim(Batch& batch, size_t& chunk)
+	    {
+		std_or_boost::lock_guard<std_or_boost::mutex> lock(_mutex);
+		if ( batch.next == batch.count ) { return false; }
+		next(batch, chunk);
+		return true;
+	    }
+
+	    void execute(Batch& batch, size_t chunk)
+	    {
+		double busy = 0;
+
+		if ( batch.timed )
+		    {
+			Clock::time_point start = Clock::now();
+			batch.call(batch.task, chunk);
+			busy = seconds( Clock::now() - start );
+		    }
+		else
+		    {
+			batch.call(batch.task, chunk);
+		    }
+
+		bool last;
+		{
+		    std_or_boost::lock_guard<std_or_boost::mutex> lock(_mutex);
+		    batch.busy += busy;
+		    last = ++batch.done == batch.count;
+		}
+
+		// the caller owns the batch and may leave as soon as it sees the last chunk done
+		if ( last ) { _finished.notify_all(); }
+	    }
+
+	    void work(size_t id, size_t k)
+	    {
+		Random::local(id, k);
+
+		for (;;)
+		    {
+			Batch* batch;
+			size_t chunk;
+
+			{
+			    std_or_boost::unique_lock<std_or_boost::mutex> lock(_mutex);
+			    while ( !_stop && _batches.empty() ) { _pending.wait(lock); }
+			    if ( _batches.empty() ) { return; }
+
+			    batch = _batches.front();
+			    next(*batch, chunk);
+			}
+
+			execute(*batch, chunk);
+		    }
+	    }
+
+	    std::vector<boost::thread*> _workers;
+	    std::deque<Batch*> _batches; // batches with chunks left to hand out
+	    bool _stop;
+
+	    std_or_boost::mutex _mutex;
+	    std_or_boost::condition_variable _pending;
+	    std_or_boost::condition_variable _finished;
+	};
+
+    } // !core
+} // !dim
+
+#endif /* _CORE_THREADPOOL_H_ */
@@ -24,22 +24,22 @@
 #define _CORE_VECTOR_H_
 
 #include <vector>
-#include <list>
 #include <iterator>
+#include <cassert>
 #include <EO.h>
 #include <utils/eoLogger.h>
 
 #include <boost/mpi.hpp>
 
-#include <boost/archive/text_oarchive.hpp>
-#include <boost/archive/text_iarchive.hpp>
-
 #include <boost/serialization/vector.hpp>
-#include <boost/serialization/list.hpp>
 #include <boost/serialization/base_object.hpp>
 #include <boost/serialization/utility.hpp>
 #include <boost/serialization/assume_abstract.hpp>
 
+#include "History.h"
+#include "Memory.h"
+#include "Zobrist.h"
+
 namespace dim
 {
     namespace core
@@ -64,22 +64,24 @@ namespace dim
 	    GeneType must have the following methods: void ctor (needed for the
 	    std::vector<>), copy ctor,
 
+	    Alloc allocates the genes, see memory::DefaultAllocator.
+
 	*/
-	template <class FitT, class GeneType>
-	class Vector : public EO<FitT>, public std::vector<GeneType>
+	template <class FitT, class GeneType, class Alloc = typename memory::DefaultAllocator<GeneType>::type>
+	class Vector : public EO<FitT>, public std::vector<GeneType, Alloc>
 	{
 	public:
 	    friend class boost::serialization::access;
 
 	    using EO<FitT>::invalidate;
-	    using std::vector<GeneType>::operator[];
-	    using std::vector<GeneType>::begin;
-	    using std::vector<GeneType>::end;
-	    using std::vector<GeneType>::resize;
-	    using std::vector<GeneType>::size;
+	    using std::vector<GeneType, Alloc>::operator[];
+	    using std::vector<GeneType, Alloc>::begin;
+	    using std::vector<GeneType, Alloc>::end;
+	    using std::vector<GeneType, Alloc>::resize;
+	    using std::vector<GeneType, Alloc>::size;
 
 	    typedef GeneType                AtomType;
-	    typedef std::vector<GeneType>   ContainerType;
+	    typedef std::vector<GeneType, Alloc> ContainerType;
 
 	    /** default constructor
 
@@ -87,15 +89,18 @@ namespace dim
 		@param _value Initial value of all elements (default is default value of type GeneType)
 	    */
 	    Vector(unsigned _size = 0, GeneType _value = GeneType())
-		: EO<FitT>(), std::vector<GeneType>(_size, _value)
+		: EO<FitT>(), ContainerType(_size, _value)
 #if __cplusplus <= 199711L
-		, historySize(1), receivedTime(1.)
+		, historySize(1), _hash(0), _hashed(false), receivedTime(1.)
 #endif
 	    {}
 
 	    /// copy ctor abstracting from the FitT
 	    template <class OtherFitnessType>
-	    Vector(const Vector<OtherFitnessType, GeneType>& _vec) : std::vector<GeneType>(_vec)
+	    Vector(const Vector<OtherFitnessType, GeneType, Alloc>& _vec) : ContainerType(_vec)
+#if __cplusplus <= 199711L
+		, _hash(0), _hashed(false)
+#endif
 	    {}
 
 	    // we can't have a Ctor from a std::vector, it would create ambiguity
@@ -111,10 +116,23 @@ namespace dim
 
 		std::copy(_v.begin(), _v.end(), begin());
 		invalidate();
+		unhash();
+	    }
+
+	    /// exchanges two individuals without copying their genes
+	    void swap(Vector& _vec)
+	    {
+		std::swap( static_cast< EO<FitT>& >(*this), static_cast< EO<FitT>& >(_vec) );
+		ContainerType::swap(_vec);
+		std::swap(historySize, _vec.historySize);
+		std::swap(history, _vec.history);
+		std::swap(receivedTime, _vec.receivedTime);
+		std::swap(_hash, _vec._hash);
+		std::swap(_hashed, _vec._hashed);
 	    }
 
 	    /// to avoid conflicts between EO::operator< and std::vector<GeneType>::operator<
-	    bool operator<(const Vector<FitT, GeneType>& _eo) const
+	    bool operator<(const Vector& _eo) const
 	    {
 		return EO<FitT>::operator<(_eo);
 	    }
@@ -147,83 +165,83 @@ namespace dim
 			is >> atom;
 			operator[](i) = atom;
 		    }
+
+		unhash();
 	    }
 
+	    /**
+	     * Zobrist hash of the genes (see zobrist::hash()), only meaningful
+	     * if hashed(). It is carried by the copies and the migrants, and
+	     * kept by the operators which are a zobrist::Keeper.
+	     *
+	     * Whatever writes the genes has to keep the hash or call unhash(),
+	     * otherwise a later Keeper updates a stale hash and the fitness
+	     * cache answers for another genome. evolver::Easy does it for the
+	     * operators it applies, the other writers do it themselves.
+	     */
+	    inline zobrist::Hash hash() const { return _hash; }
+	    inline void hash(zobrist::Hash h) { _hash = h; _hashed = true; }
+	    inline bool hashed() const { return _hashed; }
+	    inline void unhash() { _hashed = false; }
+
 	public:
 	    void addIsland( size_t isl )
 	    {
+		FitT fitness = this->invalid() ? -1 : this->fitness();
+
 		if ( getLastIsland() == int(isl) )
 		    {
-			++(lastIslands.back().first);
-			lastFitnesses.back() = this->invalid() ? -1 : this->fitness();
+			++(history.back().count);
+			history.back().fitness = fitness;
 		    }
 		else
 		    {
-			lastIslands.push_back( std::make_pair( 0, isl ) );
-			lastFitnesses.push_back( this->invalid() ? -1 : this->fitness() );
-		    }
-
-		if (!historySize) { return; }
-
-		// check if we overtake the history size
-		while (lastIslands.size() > historySize)
-		    {
-			lastIslands.pop_front();
-			lastFitnesses.pop_front();
+			history.push( isl, fitness, historySize );
 		    }
 	    }
 
-	    inline int getLastIsland() const { return lastIslands.empty() ? -1 : lastIslands.back().second; }
-	    inline int getLastIslandCount() const { return lastIslands.empty() ? -1 : lastIslands.back().first; }
-	    inline FitT getLastFitness() const { return lastFitnesses.empty() ? -1 : lastFitnesses.back(); }
+	    inline int getLastIsland() const { return history.empty() ? -1 : history.back().island; }
+	    inline int getLastIslandCount() const { return history.empty() ? -1 : history.back().count; }
+	    inline FitT getLastFitness() const { return history.empty() ? -1 : history.back().fitness; }
 
-	    inline const std::list< std::pair< size_t, size_t > >& getLastIslands() const { return lastIslands; }
-	    inline const std::list<FitT>& getLastFitnesses() const { return lastFitnesses; }
+	    inline const History<FitT>& getHistory() const { return history; }
+	    inline History<FitT>& getHistory() { return history; }
 
 	    void printLastIslands() const
 	    {
-		if (!lastIslands.size()) { return; }
-
-		size_t count = lastIslands.back().first;
-		size_t last = lastIslands.back().second;
+		if (history.empty()) { return; }
 
-		if ( count > 0 )
+		for (size_t i = 0; i < history.size(); ++i)
 		    {
-			std::cout << "(" << last << "," << count << ")";
-		    }
-		else
-		    {
-			std::cout << last;
-		    }
-		std::cout.flush();
+			const typename History<FitT>::Entry& e = history[history.size() - 1 - i];
 
-		size_t i = 0;
+			if ( i > 0 ) { std::cout << " < "; }
 
-#if __cplusplus > 199711L
-		for (auto it = lastIslands.crbegin(); it != lastIslands.crend(); ++it, ++i)
-#else
-		for (std::list< std::pair< size_t, size_t > >::reverse_iterator it = lastIslands.rbegin(); it != lastIslands.rend(); ++it, ++i)
-#endif
-		    {
-			size_t count = it->first;
-			size_t last = it->second;
-			if ( i > 0 )
+			if ( i > 0 || e.count > 0 )
 			    {
-				std::cout << " < (" << last << "," << count << ")";
+				std::cout << "(" << e.island << "," << e.count << ")";
 			    }
 			else
 			    {
-				std::cout << " < " << last;
+				std::cout << e.island;
 			    }
-			std::cout.flush();
 		    }
 		std::cout << std::endl;
 		std::cout.flush();
 	    }
 
-	    inline size_t getLastIslandsSize() const {return lastIslands.size();}
+	    inline size_t getLastIslandsSize() const {return history.size();}
 
-	    inline void setHistorySize(size_t size) { historySize = size; }
+	    /**
+	     * Number of islands kept in the history, 0 for as many as History can hold.
+	     * The history is a fixed ring of VECTOR_HISTORY_CAPACITY entries, so larger
+	     * sizes are rejected: define VECTOR_HISTORY_CAPACITY to keep more.
+	     */
+	    inline void setHistorySize(size_t size)
+	    {
+		assert( size <= VECTOR_HISTORY_CAPACITY );
+		historySize = size;
+	    }
 	    inline size_t getHistorySize() const { return historySize; }
 
 	private:
@@ -232,8 +250,15 @@ namespace dim
 #else
 	    size_t historySize;
 #endif
-	    std::list< std::pair< size_t, size_t > > lastIslands;
-	    std::list< FitT > lastFitnesses;
+	    History<FitT> history;
+
+#if __cplusplus > 199711L
+	    zobrist::Hash _hash = 0;
+	    bool _hashed = false;
+#else
+	    zobrist::Hash _hash;
+	    bool _hashed;
+#endif
 
 	public:
 #if __cplusplus > 199711L
@@ -248,8 +273,10 @@ namespace dim
 	    void serialize(Archive & ar, const unsigned int /*version*/)
             {
 		ar & boost::serialization::base_object< EO<FitT> >(*this);
-		ar & boost::serialization::base_object< std::vector<GeneType> >(*this);
-		ar & lastIslands & lastFitnesses;
+		ar & boost::serialization::base_object< ContainerType >(*this);
+		ar & history;
+		ar & _hash;
+		ar & _hashed;
 	    }
         };
 	/** @example t-Vector.cpp
@@ -260,8 +287,8 @@ namespace dim
 	    This is impemented to avoid conflicts between EO::operator< and
 	    std::vector<GeneType>::operator<
 	*/
-	template <class FitT, class GeneType>
-	bool operator<(const Vector<FitT, GeneType>& _eo1, const Vector<FitT, GeneType>& _eo2)
+	template <class FitT, class GeneType, class Alloc>
+	bool operator<(const Vector<FitT, GeneType, Alloc>& _eo1, const Vector<FitT, GeneType, Alloc>& _eo2)
 	{
 	    return _eo1.operator<(_eo2);
 	}
@@ -272,8 +299,8 @@ namespace dim
 	    This is impemented to avoid conflicts between EO::operator> and
 	    std::vector<GeneType>::operator>
 	*/
-	template <class FitT, class GeneType>
-	bool operator>(const Vector<FitT, GeneType>& _eo1, const Vector<FitT, GeneType>& _eo2)
+	template <class FitT, class GeneType, class Alloc>
+	bool operator>(const Vector<FitT, GeneType, Alloc>& _eo1, const Vector<FitT, GeneType, Alloc>& _eo2)
 	{
 	    return _eo1.operator>(_eo2);
 	}
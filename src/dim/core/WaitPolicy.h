@@ -0,0 +1,181 @@
+// -*- mode: c++; c-indent-level: 4; c++-member-init-indent: 8; comment-column: 35; -*-
+
+/* This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+ * Authors:
+ * Caner Candan <caner.candan@univ-angers.fr>
+ */
+
+#ifndef _CORE_WAITPOLICY_H_
+#define _CORE_WAITPOLICY_H_
+
+#if __cplusplus > 199711L
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#else
+#include <boost/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/chrono/chrono.hpp>
+#include <boost/atomic.hpp>
+#endif
+
+#include <string>
+#include <stdexcept>
+
+namespace dim
+{
+    namespace core
+    {
+#if __cplusplus > 199711L
+	namespace std_or_boost = std;
+#else
+	namespace std_or_boost = boost;
+#endif
+
+	/**
+	 * How a consumer waits for a queue to be fulfilled.
+	 *
+	 * - Spin: busy loop on empty(), the historical behaviour.
+	 * - Backoff: spin a little, then sleep with an exponential backoff
+	 *   bounded by maxSleep microseconds.
+	 * - Park: spin a little, then sleep on a condition variable. Producers
+	 *   call notify() after each push and only take the lock when a consumer
+	 *   is actually parked.
+	 *
+	 * Parks and wakes are counted so that the number of spins can be tuned.
+	 * A parked consumer wakes up by itself every maxSleep microseconds, so a
+	 * missed notification can never block it forever.
+	 */
+	class WaitPolicy
+	{
+	public:
+	    enum Strategy { Spin, Backoff, Park };
+
+	    WaitPolicy(Strategy strategy = Spin, unsigned spins = 1000, unsigned maxSleep = 1000)
+		: _strategy(strategy), _spins(spins), _maxSleep(maxSleep), _waiters(0), _parks(0), _wakes(0)
+	    {}
+
+	    /// only the configuration is copied, not the counters
+	    WaitPolicy(const WaitPolicy& w)
+		: _strategy(w._strategy), _spins(w._spins), _maxSleep(w._maxSleep), _waiters(0), _parks(0), _wakes(0)
+	    {}
+
+	    WaitPolicy& operator=(const WaitPolicy& w)
+	    {
+		if ( &w != this )
+		    {
+			_strategy = w._strategy;
+			_spins = w._spins;
+			_maxSleep = w._maxSleep;
+		    }
+		return *this;
+	    }
+
+	    /// "spin", "backoff" or "park"
+	    static Strategy parse(const std::string& name)
+	    {
+		if ( name == "spin" ) { return Spin; }
+		if ( name == "backoff" ) { return Backoff; }
+		if ( name == "park" ) { return Park; }
+		throw std::runtime_error("WaitPolicy: unknown strategy " + name + ", expected spin, backoff or park.");
+	    }
+
+	    inline void strategy(Strategy s) { _strategy = s; }
+	    inline Strategy strategy() const { return _strategy; }
+
+	    inline void spins(unsigned n) { _spins = n; }
+	    inline void maxSleep(unsigned us) { _maxSleep = us; }
+
+	    inline size_t parks() const { return _parks.load(); }
+	    inline size_t wakes() const { return _wakes.load(); }
+
+	    /// Blocks the calling thread until the queue is not empty anymore.
+	    template <typename Queue>
+	    void wait(Queue& queue)
+	    {
+		if ( _strategy == Spin )
+		    {
+			while ( queue.empty() ) {}
+			return;
+		    }
+
+		for (unsigned i = 0; i < _spins; ++i)
+		    {
+			if ( !queue.empty() ) { return; }
+		    }
+
+		if ( _strategy == Backoff )
+		    {
+			unsigned sleep = 1;
+			while ( queue.empty() )
+			    {
+				std_or_boost::this_thread::sleep_for( std_or_boost::chrono::microseconds(sleep) );
+				if ( sleep < _maxSleep ) { sleep *= 2; }
+			    }
+			return;
+		    }
+
+		_waiters.fetch_add(1);
+		{
+		    std_or_boost::unique_lock<std_or_boost::mutex> lock(_mutex);
+		    if ( queue.empty() )
+			{
+			    // counted once per park, not once per timed wakeup
+			    _parks.fetch_add(1, std_or_boost::memory_order_relaxed);
+			}
+		    while ( queue.empty() )
+			{
+			    _cv.wait_for( lock, std_or_boost::chrono::microseconds(_maxSleep) );
+			}
+		}
+		_waiters.fetch_sub(1);
+	    }
+
+	    /// To be called by producers once the element is visible in the queue.
+	    void notify()
+	    {
+		if ( _strategy != Park ) { return; }
+
+		// pairs with the increment of _waiters done by the consumer before checking the queue
+		std_or_boost::atomic_thread_fence(std_or_boost::memory_order_seq_cst);
+		if ( !_waiters.load() ) { return; }
+
+		{
+		    std_or_boost::lock_guard<std_or_boost::mutex> lock(_mutex);
+		}
+		_cv.notify_one();
+		_wakes.fetch_add(1, std_or_boost::memory_order_relaxed);
+	    }
+
+	private:
+	    Strategy _strategy;
+	    unsigned _spins;
+	    unsigned _maxSleep;
+
+	    std_or_boost::atomic<unsigned> _waiters;
+	    std_or_boost::atomic<size_t> _parks;
+	    std_or_boost::atomic<size_t> _wakes;
+
+	    std_or_boost::mutex _mutex;
+	    std_or_boost::condition_variable _cv;
+	};
+
+    } // !core
+} // !dim
+
+#endif /* _CORE_WAITPOLICY_H_ */
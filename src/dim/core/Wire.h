@@ -0,0 +1,504 @@
+// -*- mode: c++; c-indent-level: 4; c++-member-init-indent: 8; comment-column: 35; -*-
+
+/* This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+ * Authors:
+ * Caner Candan <caner.candan@univ-angers.fr>
+ */
+
+#ifndef _CORE_WIRE_H_
+#define _CORE_WIRE_H_
+
+#include <vector>
+#include <algorithm>
+#include <cstring>
+#include <cstddef>
+#include <stdexcept>
+
+#include <boost/mpi.hpp>
+
+#include <boost/cstdint.hpp>
+#include <boost/serialization/vector.hpp>
+#include <boost/mpl/bool.hpp>
+
+#include "Vector.h"
+#include "PackedBit.h"
+
+namespace dim
+{
+    namespace core
+    {
+
+	/**
+	 * Binary wire format of the individuals exchanged between the ranks.
+	 *
+	 * An individual is a fixed-size header followed by its genes:
+	 * - the number of genes, the validity of the fitness and of the hash,
+	 *   the width of a gene and the number of entries of the history,
+	 * - the fitness, the zobrist hash and the received time,
+	 * - the whole history ring (VECTOR_HISTORY_CAPACITY entries),
+	 * - the genes: 64 bits words for the bit strings (Bit and PackedBit),
+	 *   16 or 32 bits indices for the unsigned genes (Route) depending on
+	 *   the largest one, the raw genes otherwise.
+	 *
+	 * The vectors of individuals deriving from Vector are serialized as
+	 * one array of bytes in this format (see wire::serialize(), used by Pop
+	 * and the packets of ProgressEngine), which boost::mpi copies at once
+	 * instead of going through every member of every individual.
+	 *
+	 * The fitness and the genes are copied as they are in memory, so the
+	 * ranks have to share their representation of the basic types, as for
+	 * the MPI_BYTE messages.
+	 */
+	namespace wire
+	{
+	    namespace detail
+	    {
+		template <typename T>
+		inline char* put(char* out, const T& value)
+		{
+		    std::memcpy(out, &value, sizeof(T));
+		    return out + sizeof(T);
+		}
+
+		template <typename T>
+		inline const char* get(const char* in, T& value)
+		{
+		    std::memcpy(&value, in, sizeof(T));
+		    return in + sizeof(T);
+		}
+
+		inline size_t nwords(size_t bits) { return (bits + 63) / 64; }
+
+		/**
+		 * Genes of the individuals, by representation: bytes() and
+		 * width() give the size of the payload and of a gene, accepts()
+		 * tells whether a width can be read, write() and read() copy it.
+		 */
+
+		// raw genes
+		template <class FitT, class GeneType, class Alloc>
+		inline boost::uint8_t width(const Vector<FitT, GeneType, Alloc>&) { return sizeof(GeneType); }
+
+		template <class FitT, class GeneType, class Alloc>
+		inline bool accepts(const Vector<FitT, GeneType, Alloc>&, boost::uint8_t width) { return width == sizeof(GeneType); }
+
+		template <class FitT, class GeneType, class Alloc>
+		inline size_t bytes(const Vector<FitT, GeneType, Alloc>& ind, boost::uint8_t) { return ind.size() * sizeof(GeneType); }
+
+		template <class FitT, class GeneType, class Alloc>
+		inline char* write(const Vector<FitT, GeneType, Alloc>& ind, boost::uint8_t, char* out)
+		{
+		    for (size_t i = 0; i < ind.size(); ++i) { out = put(out, ind[i]); }
+		    return out;
+		}
+
+		template <class FitT, class GeneType, class Alloc>
+		inline const char* read(Vector<FitT, GeneType, Alloc>& ind, size_t n, boost::uint8_t, const char* in)
+		{
+		    ind.resize(n);
+		    for (size_t i = 0; i < n; ++i) { in = get(in, ind[i]); }
+		    return in;
+		}
+
+		// cities, on 16 bits when they all fit
+		template <class FitT, class Alloc>
+		inline boost::uint8_t width(const Vector<FitT, unsigned, Alloc>& ind)
+		{
+		    for (size_t i = 0; i < ind.size(); ++i) { if ( ind[i] > 0xffff ) { return 4; } }
+		    return 2;
+		}
+
+		template <class FitT, class Alloc>
+		inline bool accepts(const Vector<FitT, unsigned, Alloc>&, boost::uint8_t width) { return width == 2 || width == 4; }
+
+		template <class FitT, class Alloc>
+		inline size_t bytes(const Vector<FitT, unsigned, Alloc>& ind, boost::uint8_t width) { return ind.size() * width; }
+
+		template <class FitT, class Alloc>
+		inline char* write(const Vector<FitT, unsigned, Alloc>& ind, boost::uint8_t width, char* out)
+		{
+		    if ( width == 4 )
+			{
+			    for (size_t i = 0; i < ind.size(); ++i) { out = put( out, static_cast<boost::uint32_t>(ind[i]) ); }
+			}
+		    else
+			{
+			    for (size_t i = 0; i < ind.size(); ++i) { out = put( out, static_cast<boost::uint16_t>(ind[i]) ); }
+			}
+		    return out;
+		}
+
+		template <class FitT, class Alloc>
+		inline const char* read(Vector<FitT, unsigned, Alloc>& ind, size_t n, boost::uint8_t width, const char* in)
+		{
+		    ind.resize(n);
+		    if ( width == 4 )
+			{
+			    boost::uint32_t g;
+			    for (size_t i = 0; i < n; ++i) { in = get(in, g); ind[i] = g; }
+			}
+		    else
+			{
+			    boost::uint16_t g;
+			    for (size_t i = 0; i < n; ++i) { in = get(in, g); ind[i] = g; }
+			}
+		    return in;
+		}
+
+		// bits, packed in words
+		template <class FitT, class Alloc>
+		inline boost::uint8_t width(const Vector<FitT, bool, Alloc>&) { return 0; }
+
+		template <class FitT, class Alloc>
+		inline bool accepts(const Vector<FitT, bool, Alloc>&, boost::uint8_t width) { return width == 0; }
+
+		template <class FitT, class Alloc>
+		inline size_t bytes(const Vector<FitT, bool, Alloc>& ind, boost::uint8_t) { return nwords( ind.size() ) * 8; }
+
+		template <class FitT, class Alloc>
+		inline char* write(const Vector<FitT, bool, Alloc>& ind, boost::uint8_t, char* out)
+		{
+		    for (size_t w = 0; w < nwords( ind.size() ); ++w)
+			{
+			    boost::uint64_t word = 0;
+			    size_t end = std::min( ind.size(), (w + 1) * 64 );
+			    for (size_t i = w * 64; i < end; ++i) { word |= boost::uint64_t( ind[i] ) << (i % 64); }
+			    out = put(out, word);
+			}
+		    return out;
+		}
+
+		template <class FitT, class Alloc>
+		inline const char* read(Vector<FitT, bool, Alloc>& ind, size_t n, boost::uint8_t, const char* in)
+		{
+		    ind.resize(n);
+		    for (size_t w = 0; w < nwords(n); ++w)
+			{
+			    boost::uint64_t word;
+			    in = get(in, word);
+			    size_t end = std::min( n, (w + 1) * 64 );
+			    for (size_t i = w * 64; i < end; ++i) { ind[i] = ( word >> (i % 64) ) & 1; }
+			}
+		    return in;
+		}
+
+		// packed bits, as their words
+		template <class FitT>
+		inline boost::uint8_t width(const PackedBit<FitT>&) { return 0; }
+
+		template <class FitT>
+		inline bool accepts(const PackedBit<FitT>&, boost::uint8_t width) { return width == 0; }
+
+		template <class FitT>
+		inline size_t bytes(const PackedBit<FitT>& ind, boost::uint8_t) { return ind.nwords() * 8; }
+
+		template <class FitT>
+		inline char* write(const PackedBit<FitT>& ind, boost::uint8_t, char* out)
+		{
+		    if ( ind.nwords() ) { std::memcpy( out, ind.words(), ind.nwords() * 8 ); }
+		    return out + ind.nwords() * 8;
+		}
+
+		template <class FitT>
+		inline const char* read(PackedBit<FitT>& ind, size_t n, boost::uint8_t, const char* in)
+		{
+		    ind.resize(n);
+		    if ( ind.nwords() ) { std::memcpy( ind.words(), in, ind.nwords() * 8 ); }
+		    return in + ind.nwords() * 8;
+		}
+
+		// the individuals written in this format
+		template <class FitT, class GeneType, class Alloc>
+		char encoded(const Vector<FitT, GeneType, Alloc>*);
+		long encoded(...);
+	    }
+
+	    /// true if the individuals of type EOT have a wire format
+	    template <class EOT>
+	    struct Encoded
+	    {
+		static const bool value = sizeof( detail::encoded( static_cast<EOT*>(0) ) ) == 1;
+	    };
+
+	    /// size of the header of the individuals of type EOT
+	    template <class EOT>
+	    inline size_t header()
+	    {
+		typedef typename EOT::Fitness Fitness;
+		return 8 + sizeof(Fitness) + 8 + 8 + History<Fitness>::capacity() * ( 8 + sizeof(Fitness) );
+	    }
+
+	    /// number of bytes of an individual
+	    template <class EOT>
+	    inline size_t size(const EOT& ind)
+	    {
+		return header<EOT>() + detail::bytes( ind, detail::width(ind) );
+	    }
+
+	    /// writes an individual to out, returning the end of what was written
+	    template <class EOT>
+	    char* write(const EOT& ind, char* out)
+	    {
+		typedef typename EOT::Fitness Fitness;
+
+		boost::uint8_t width = detail::width(ind);
+		const History<Fitness>& history = ind.getHistory();
+
+		out = detail::put( out, boost::uint32_t( ind.size() ) );
+		out = detail::put( out, boost::uint8_t( !ind.invalid() ) );
+		out = detail::put( out, boost::uint8_t( ind.hashed() ) );
+		out = detail::put( out, width );
+		out = detail::put( out, boost::uint8_t( history.size() ) );
+
+		out = detail::put( out, ind.invalid() ? Fitness() : ind.fitness() );
+		out = detail::put( out, boost::uint64_t( ind.hash() ) );
+		out = detail::put( out, ind.receivedTime );
+
+		for (size_t i = 0; i < History<Fitness>::capacity(); ++i)
+		    {
+			if ( i < history.size() )
+			    {
+				const typename History<Fitness>::Entry& e = history[i];
+				out = detail::put( out, e.count );
+				out = detail::put( out, e.island );
+				out = detail::put( out, e.fitness );
+			    }
+			else
+			    {
+				std::memset( out, 0, 8 + sizeof(Fitness) );
+				out += 8 + sizeof(Fitness);
+			    }
+		    }
+
+		return detail::write(ind, width, out);
+	    }
+
+	    /**
+	     * Reads an individual from in, returning the end of what was read.
+	     *
+	     * Throws if the width of the genes written does not fit the
+	     * representation of ind, the ranks not sharing the type of EOT.
+	     */
+	    template <class EOT>
+	    const char* read(EOT& ind, const char* in)
+	    {
+		typedef typename EOT::Fitness Fitness;
+
+		boost::uint32_t n;
+		boost::uint8_t valid, hashed, width, entries;
+		Fitness fitness;
+		boost::uint64_t hash;
+
+		in = detail::get(in, n);
+		in = detail::get(in, valid);
+		in = detail::get(in, hashed);
+		in = detail::get(in, width);
+		in = detail::get(in, entries);
+
+		if ( !detail::accepts(ind, width) ) { throw std::runtime_error("wire::read: the genes were written with another width than the one of the representation"); }
+
+		in = detail::get(in, fitness);
+		in = detail::get(in, hash);
+		in = detail::get(in, ind.receivedTime);
+
+		History<Fitness>& history = ind.getHistory();
+		history.clear();
+
+		for (size_t i = 0; i < History<Fitness>::capacity(); ++i)
+		    {
+			typename History<Fitness>::Entry e;
+			in = detail::get(in, e.count);
+			in = detail::get(in, e.island);
+			in = detail::get(in, e.fitness);
+
+			if ( i < entries )
+			    {
+				history.push(e.island, e.fitness, 0);
+				history.back().count = e.count;
+			    }
+		    }
+
+		in = detail::read(ind, n, width, in);
+
+		if ( valid ) { ind.fitness(fitness); } else { ind.invalidate(); }
+		if ( hashed ) { ind.hash(hash); } else { ind.unhash(); }
+
+		return in;
+	    }
+
+	    /// appends n individuals to bytes
+	    template <class EOT>
+	    void save(std::vector<char>& bytes, const EOT* inds, size_t n)
+	    {
+		size_t total = 0;
+		for (size_t i = 0; i < n; ++i) { total += wire::size(inds[i]); }
+
+		size_t offset = bytes.size();
+		bytes.resize(offset + total);
+
+		char* out = total ? &bytes[offset] : NULL;
+		for (size_t i = 0; i < n; ++i) { out = wire::write(inds[i], out); }
+	    }
+
+	    /// reads n individuals from bytes, returning the end of what was read
+	    template <class EOT, class Alloc>
+	    const char* load(const char* in, std::vector<EOT, Alloc>& inds, size_t n)
+	    {
+		inds.resize(n);
+		for (size_t i = 0; i < n; ++i) { in = wire::read(inds[i], in); }
+		return in;
+	    }
+
+	    namespace detail
+	    {
+		template <class Archive, class EOT, class Alloc>
+		void serialize(Archive& ar, std::vector<EOT, Alloc>& inds, boost::mpl::true_ /*encoded*/)
+		{
+		    boost::uint32_t n = inds.size();
+		    std::vector<char> bytes;
+
+		    if ( Archive::is_saving::value ) { wire::save(bytes, inds.empty() ? NULL : &inds[0], n); }
+
+		    ar & n;
+		    ar & bytes;
+
+		    if ( Archive::is_loading::value ) { wire::load(bytes.empty() ? NULL : &bytes[0], inds, n); }
+		}
+
+		template <class Archive, class EOT, class Alloc>
+		void serialize(Archive& ar, std::vector<EOT, Alloc>& inds, boost::mpl::false_)
+		{
+		    ar & inds;
+		}
+	    }
+
+	    /**
+	     * Serializes a vector of individuals in the wire format, or one by
+	     * one as usual if their type has none.
+	     */
+	    template <class Archive, class EOT, class Alloc>
+	    void serialize(Archive& ar, std::vector<EOT, Alloc>& inds)
+	    {
+		detail::serialize( ar, inds, boost::mpl::bool_< Encoded<EOT>::value >() );
+	    }
+
+	    /**
+	     * Individuals of the same size stored one after the other, for the
+	     * genomes of fixed length: every record takes stride() bytes, so the
+	     * whole frame is sent as count() elements of one derived datatype
+	     * (see datatype()) and received in a frame of the right count
+	     * without any serialization or size message.
+	     *
+	     * The stride is the size of the first individual pushed, unless it
+	     * is given to the constructor, which is needed to receive.
+	     *
+	     * The frames are meant for point-to-point exchanges whose both ends
+	     * know the stride, the migrators and Collective send byte arrays of
+	     * individuals of any length instead (see save()).
+	     */
+	    template <class EOT>
+	    class Frame
+	    {
+	    public:
+		Frame(size_t stride = 0, size_t count = 0) : _stride(stride), _bytes(stride * count), _type(MPI_DATATYPE_NULL) {}
+
+		Frame(const Frame& f) : _stride(f._stride), _bytes(f._bytes), _type(MPI_DATATYPE_NULL) {}
+
+		Frame& operator=(const Frame& f)
+		{
+		    if ( &f != this )
+			{
+			    if ( f._stride != _stride ) { release(); }
+			    _stride = f._stride;
+			    _bytes = f._bytes;
+			}
+		    return *this;
+		}
+
+		~Frame() { release(); }
+
+		/// stride of a frame of individuals like ind
+		static size_t strideOf(const EOT& ind) { return wire::size(ind); }
+
+		inline size_t stride() const { return _stride; }
+		inline size_t count() const { return _stride ? _bytes.size() / _stride : 0; }
+
+		inline char* data() { return _bytes.empty() ? NULL : &_bytes[0]; }
+		inline const char* data() const { return _bytes.empty() ? NULL : &_bytes[0]; }
+
+		/// makes room for count records, to receive them
+		void resize(size_t count) { _bytes.resize(_stride * count); }
+
+		void clear() { _bytes.clear(); }
+
+		void push_back(const EOT& ind)
+		{
+		    size_t bytes = wire::size(ind);
+		    if ( !_stride ) { release(); _stride = bytes; }
+		    if ( bytes != _stride ) { throw std::runtime_error("Frame: the individuals of a frame have the same size"); }
+
+		    _bytes.resize( _bytes.size() + _stride );
+		    wire::write( ind, &_bytes[ _bytes.size() - _stride ] );
+		}
+
+		void get(size_t i, EOT& ind) const { wire::read( ind, &_bytes[i * _stride] ); }
+
+		/// appends the individuals of the frame to inds
+		template <class Container>
+		void appendTo(Container& inds) const
+		{
+		    for (size_t i = 0; i < count(); ++i)
+			{
+			    inds.push_back( EOT() );
+			    get( i, inds.back() );
+			}
+		}
+
+		/**
+		 * Contiguous type of stride() bytes, committed on the first call
+		 * and freed with the frame, so a frame kept from one exchange to
+		 * the next commits it once.
+		 */
+		MPI_Datatype datatype() const
+		{
+		    if ( _type == MPI_DATATYPE_NULL )
+			{
+			    MPI_Type_contiguous( static_cast<int>(_stride), MPI_BYTE, &_type );
+			    MPI_Type_commit( &_type );
+			}
+		    return _type;
+		}
+
+	    private:
+		void release()
+		{
+		    if ( _type == MPI_DATATYPE_NULL ) { return; }
+
+		    int finalized;
+		    MPI_Finalized( &finalized );
+		    if ( !finalized ) { MPI_Type_free( &_type ); }
+		    _type = MPI_DATATYPE_NULL;
+		}
+
+		size_t _stride;
+		std::vector<char> _bytes;
+		mutable MPI_Datatype _type;
+	    };
+	}
+
+    } // !core
+} // !dim
+
+#endif // !_CORE_WIRE_H_
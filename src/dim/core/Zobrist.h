@@ -0,0 +1,100 @@
+// -*- mode: c++; c-indent-level: 4; c++-member-init-indent: 8; comment-column: 35; -*-
+
+/* This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+ * Authors:
+ * Caner Candan <caner.candan@univ-angers.fr>
+ */
+
+#ifndef _CORE_ZOBRIST_H_
+#define _CORE_ZOBRIST_H_
+
+#include <cstddef>
+#include <cstring>
+
+#include <boost/cstdint.hpp>
+
+namespace dim
+{
+    namespace core
+    {
+
+	/**
+	 * Zobrist hashing of the genes of an individual.
+	 *
+	 * The hash of an individual is the xor of one key per position, the key
+	 * depending on the position and the value of the gene it holds. Changing
+	 * some genes only takes the xor of their keys before and after the
+	 * change, so the operators keep the hash carried by the individual (see
+	 * Vector::hash()) up to date in the time of the change itself.
+	 *
+	 * The keys are computed by mixing the position and the gene instead of
+	 * being read from random tables, so they are the same in every process
+	 * and do not depend on the number of values a gene can take.
+	 */
+	namespace zobrist
+	{
+	    typedef boost::uint64_t Hash;
+
+	    /**
+	     * Marks the operators keeping the hash of the individuals they
+	     * change, if it is known. The hash of an individual changed by
+	     * another operator is given up (see evolver::Easy).
+	     */
+	    class Keeper
+	    {
+	    public:
+		virtual ~Keeper() {}
+	    };
+
+	    /// the bits of a gene, integral genes being taken by value
+	    template <typename T>
+	    inline Hash gene(const T& value) { return Hash(value); }
+
+	    inline Hash gene(double value) { Hash h; std::memcpy(&h, &value, sizeof(h)); return h; }
+	    inline Hash gene(float value) { return gene( double(value) ); }
+
+	    /// key of a gene at a position (finalizer of splitmix64)
+	    inline Hash key(size_t position, Hash value)
+	    {
+		Hash z = Hash(position) * 0x9e3779b97f4a7c15ULL + value * 0xd1b54a32d192ed03ULL + 0x94d049bb133111ebULL;
+		z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+		z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+		return z ^ (z >> 31);
+	    }
+
+	    /// xor of the keys of the genes of sol in [from, to]
+	    template <typename EOT>
+	    inline Hash range(const EOT& sol, size_t from, size_t to)
+	    {
+		Hash h = 0;
+		for (size_t k = from; k <= to; ++k) { h ^= key( k, gene( sol[k] ) ); }
+		return h;
+	    }
+
+	    /// hash of the whole individual
+	    template <typename EOT>
+	    inline Hash hash(const EOT& sol)
+	    {
+		return sol.size() ? range(sol, 0, sol.size() - 1) : 0;
+	    }
+
+	    /// change of the hash when the bit at a position is flipped
+	    inline Hash flip(size_t position) { return key(position, 0) ^ key(position, 1); }
+	}
+
+    }
+}
+
+#endif // !_CORE_ZOBRIST_H_
@@ -41,7 +41,7 @@ namespace dim
 	{
 
 	    template <typename EOT>
-	    utils::CheckPoint<EOT>& checkpoint(eoParser& _parser, eoState& _state, continuator::Base<EOT>& _continue, variation::IncrementalEvalCounter<EOT>& _eval, core::IslandData<EOT>& data, unsigned _frequency = 1, unsigned stepTimer = 1000 )
+	    utils::CheckPoint<EOT>& checkpoint(eoParser& _parser, eoState& _state, continuator::Base<EOT>& _continue, variation::IncrementalEvalCounter<EOT>& _eval, core::IslandData<EOT>& data, unsigned _frequency = 1, unsigned stepTimer = 1000, core::FitnessCache<typename EOT::Fitness>* cache = NULL, core::ProgressEngine<EOT>* engine = NULL )
 	    {
 		const size_t ALL = data.size();
 		const size_t RANK = data.rank();
@@ -198,6 +198,36 @@ namespace dim
 			if (printBest) { stdMonitor->add(feedbacks); }
 		    }
 
+		if ( cache )
+		    {
+			ss.str(""); ss << "cache_hit_rate_isl" << RANK;
+			utils::CacheHitRate<EOT>& hitRate = _state.storeFunctor( new utils::CacheHitRate<EOT>( *cache, ss.str() ) );
+			checkpoint.add(hitRate);
+			fileMonitor.add(hitRate);
+			if (printBest) { stdMonitor->add(hitRate); }
+
+			ss.str(""); ss << "cache_miss_rate_isl" << RANK;
+			utils::CacheMissRate<EOT>& missRate = _state.storeFunctor( new utils::CacheMissRate<EOT>( *cache, ss.str() ) );
+			checkpoint.add(missRate);
+			fileMonitor.add(missRate);
+			if (printBest) { stdMonitor->add(missRate); }
+		    }
+
+		if ( engine )
+		    {
+			ss.str(""); ss << "packet_size_isl" << RANK;
+			utils::PacketSize<EOT>& packetSize = _state.storeFunctor( new utils::PacketSize<EOT>( *engine, ss.str() ) );
+			checkpoint.add(packetSize);
+			fileMonitor.add(packetSize);
+			if (printBest) { stdMonitor->add(packetSize); }
+
+			ss.str(""); ss << "flush_latency_isl" << RANK;
+			utils::FlushLatency<EOT>& flushLatency = _state.storeFunctor( new utils::FlushLatency<EOT>( *engine, ss.str() ) );
+			checkpoint.add(flushLatency);
+			fileMonitor.add(flushLatency);
+			if (printBest) { stdMonitor->add(flushLatency); }
+		    }
+
 		for (size_t i = 0; i < ALL; ++i)
 		    {
 			ss.str(""); ss << "nb_migrants_isl" << RANK << "to" << i;
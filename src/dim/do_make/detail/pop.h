@@ -34,6 +34,7 @@
 #include <utils/eoState.h>
 
 #include <dim/core/Pop.h>
+#include <dim/core/Random.h>
 
 namespace dim
 {
@@ -68,6 +69,7 @@ namespace dim
 		eoValueParam<uint32_t>& seedParam = _parser.getORcreateParam(uint32_t(0), "seed", "Random number seed", 'S');
 		if (seedParam.value() == 0)
 		    seedParam.value() = time(0);
+		core::Random::master(seedParam.value());
 		eoValueParam<unsigned>& popSize = _parser.getORcreateParam(unsigned(20), "popSize", "Population Size", 'P', "Evolution Engine");
 
 		// Either load or initialize
@@ -33,6 +33,8 @@
 #include <utils/eoState.h>
 
 #include <dim/core/Bit.h>
+#include <dim/core/PackedBit.h>
+#include <dim/initialization/PackedBit.h>
 
 namespace dim
 {
@@ -83,6 +85,24 @@ namespace dim
 		return *init;
 	    }
 
+	    /**
+	     * The same for the bitstrings stored in words, whose initializer
+	     * fills whole words.
+	     *
+	     * @ingroup bitstring
+	     * @ingroup Builders
+	     */
+	    template <class FitT>
+	    eoInit< core::PackedBit<FitT> > & genotype(eoParser& _parser, eoState& _state, core::PackedBit<FitT>, float _bias=0.5)
+	    {
+		unsigned theSize = _parser.getORcreateParam(unsigned(10), "chromSize", "The length of the bitstrings", 'n',"Problem").value();
+
+		initialization::PackedBit<FitT>* init = new initialization::PackedBit<FitT>(theSize, _bias);
+		// store in state
+		_state.storeFunctor(init);
+		return *init;
+	    }
+
 	} // !detail
     } // !do_make
 } // !dim
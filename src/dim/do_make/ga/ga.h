@@ -46,6 +46,7 @@
 #include <dim/algo/Base.h>
 #include <dim/core/Pop.h>
 #include <dim/core/Bit.h>
+#include <dim/core/PackedBit.h>
 #include <dim/utils/CheckPoint.h>
 #include <dim/variation/GenOp.h>
 
@@ -66,6 +67,8 @@ namespace dim
 	// the genotypes
 	eoInit<core::Bit<double> > & genotype(eoParser& _parser, eoState& _state, core::Bit<double> _eo, float _bias=0.5);
 	eoInit<core::Bit<eoMinimizingFitness> > & genotype(eoParser& _parser, eoState& _state, core::Bit<eoMinimizingFitness> _eo, float _bias=0.5);
+	eoInit<core::PackedBit<double> > & genotype(eoParser& _parser, eoState& _state, core::PackedBit<double> _eo, float _bias=0.5);
+	eoInit<core::PackedBit<eoMinimizingFitness> > & genotype(eoParser& _parser, eoState& _state, core::PackedBit<eoMinimizingFitness> _eo, float _bias=0.5);
 
 	// the operators
 	variation::GenOp<core::Bit<double> >&  op(eoParser& _parser, eoState& _state, eoInit<core::Bit<double> >& _init);
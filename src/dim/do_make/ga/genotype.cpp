@@ -60,5 +60,15 @@ namespace dim
 	    return detail::genotype(_parser, _state, _eo, _bias);
 	}
 
+	eoInit<core::PackedBit<double> > & genotype(eoParser& _parser, eoState& _state, core::PackedBit<double> _eo, float _bias)
+	{
+	    return detail::genotype(_parser, _state, _eo, _bias);
+	}
+
+	eoInit<core::PackedBit<eoMinimizingFitness> > & genotype(eoParser& _parser, eoState& _state, core::PackedBit<eoMinimizingFitness> _eo, float _bias)
+	{
+	    return detail::genotype(_parser, _state, _eo, _bias);
+	}
+
     } // !do_make
 } // !dim
@@ -0,0 +1,141 @@
+// -*- mode: c++; c-indent-level: 4; c++-member-init-indent: 8; comment-column: 35; -*-
+
+/* This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+ * Authors:
+ * Caner Candan <caner.candan@univ-angers.fr>
+ */
+
+#ifndef _EVALUATION_BATCH_H_
+#define _EVALUATION_BATCH_H_
+
+#include <vector>
+#include <algorithm>
+
+#include <eoEvalFunc.h>
+#include <eoEvalFuncCounter.h>
+
+#include <dim/core/Pop.h>
+
+namespace dim
+{
+    namespace evaluation
+    {
+	/**
+	 * Evaluation of many individuals at once.
+	 *
+	 * Implemented next to eoEvalFunc by the evaluators which are faster on
+	 * several individuals together, for instance by evaluating a few of
+	 * them in the lanes of the same loop. The evaluate() functions below
+	 * use it when available and the scalar operator() otherwise.
+	 */
+	template <typename EOT>
+	class Batch
+	{
+	public:
+	    /// individuals evaluated together by the kernels
+	    static const size_t lanes = 8;
+
+	    virtual ~Batch() {}
+
+	    /// evaluates the count individuals of sols, valid or not
+	    virtual void evaluate(EOT* const* sols, size_t count) = 0;
+	};
+
+	namespace detail
+	{
+	    template <typename EOT>
+	    struct Invalid
+	    {
+		bool operator()(const EOT* sol) const { return sol->invalid(); }
+	    };
+
+	    /// true if the n individuals of sols have the same size
+	    template <typename EOT>
+	    bool sameSize(EOT* const* sols, size_t n)
+	    {
+		for (size_t l = 1; l < n; ++l) { if ( sols[l]->size() != sols[0]->size() ) { return false; } }
+		return true;
+	    }
+
+	    /// moves the invalid individuals first, returns their number
+	    template <typename EOT>
+	    size_t invalidFirst(EOT** sols, size_t count)
+	    {
+		return std::partition(sols, sols + count, Invalid<EOT>()) - sols;
+	    }
+	}
+
+	/**
+	 * Evaluates the invalid individuals of sols, in batch if eval implements Batch.
+	 *
+	 * The pointers of sols are reordered, the invalid individuals first.
+	 */
+	template <typename EOT>
+	void evaluate(eoEvalFunc<EOT>& eval, EOT** sols, size_t count)
+	{
+	    count = detail::invalidFirst(sols, count);
+
+	    Batch<EOT>* batch = dynamic_cast< Batch<EOT>* >(&eval);
+	    if ( batch ) { batch->evaluate(sols, count); return; }
+
+	    for (size_t i = 0; i < count; ++i) { eval(*sols[i]); }
+	}
+
+	/// evaluates the invalid individuals of a population, in batch if eval implements Batch
+	template <typename EOT>
+	void evaluate(eoEvalFunc<EOT>& eval, core::Pop<EOT>& pop)
+	{
+	    std::vector<EOT*> sols(pop.size());
+	    for (size_t i = 0; i < pop.size(); ++i) { sols[i] = &pop[i]; }
+	    if ( !sols.empty() ) { evaluate(eval, &sols[0], sols.size()); }
+	}
+
+	/**
+	 * eoEvalFuncCounter keeping the batch evaluation of the counted evaluator.
+	 *
+	 * A plain eoEvalFuncCounter hides the Batch interface of the evaluator
+	 * it wraps, so evaluate() would fall back to the scalar path.
+	 */
+	template <typename EOT>
+	class BatchCounter : public eoEvalFuncCounter<EOT>, public Batch<EOT>
+	{
+	public:
+	    BatchCounter(eoEvalFunc<EOT>& eval, std::string name = "Eval. ")
+		: eoEvalFuncCounter<EOT>(eval, name), _eval(eval), _batch( dynamic_cast< Batch<EOT>* >(&eval) ) {}
+
+	    /// only the invalid individuals are evaluated and counted
+	    virtual void evaluate(EOT* const* sols, size_t count)
+	    {
+		_invalid.clear();
+		for (size_t i = 0; i < count; ++i) { if ( sols[i]->invalid() ) { _invalid.push_back(sols[i]); } }
+		if ( _invalid.empty() ) { return; }
+
+		this->value() += _invalid.size();
+
+		if ( _batch ) { _batch->evaluate(&_invalid[0], _invalid.size()); return; }
+
+		for (size_t i = 0; i < _invalid.size(); ++i) { _eval(*_invalid[i]); }
+	    }
+
+	private:
+	    eoEvalFunc<EOT>& _eval;
+	    Batch<EOT>* _batch;
+	    std::vector<EOT*> _invalid;
+	};
+
+    } // !evaluation
+} // !dim
+
+#endif /* _EVALUATION_BATCH_H_ */
@@ -31,38 +31,58 @@
 #ifndef _EVALUATION_NKLANDSCAPES_H_
 #define _EVALUATION_NKLANDSCAPES_H_
 
+#include <vector>
+#include <string>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <cstdlib>
+
 #include <eoEvalFunc.h>
+#include <utils/eoRNG.h>
+
+#include "Batch.h"
 
 namespace dim
 {
     namespace evaluation
     {
 
-	template< class EOT >
-	class NKLandscapes : public eoEvalFunc<EOT>
+	/**
+	 * NK-landscapes.
+	 *
+	 * The N tables of contributions lie in one block, each one starting on
+	 * a cache line, and the K+1 links of each contribution are contiguous.
+	 * Value is the type of the contributions, float halves the memory of
+	 * the tables for the largest K.
+	 *
+	 * The contributions linked to each bit are indexed too (see loci()),
+	 * for the incremental evaluation of flips, see
+	 * variation::NKLandscapesBitFlipEval.
+	 */
+	template< class EOT, typename Value = double >
+	class NKLandscapes : public eoEvalFunc<EOT>, public Batch<EOT>
 	{
 	public:
+	    using Batch<EOT>::lanes;
+
+	    /// a contribution linked to a bit, and the bit of its table index given by this link
+	    struct Locus
+	    {
+		unsigned contribution;
+		unsigned mask;
+	    };
+
 	    // parameter N : size of the bit string
 	    unsigned N;
 
 	    // parameter K : number of epistatic links
 	    unsigned K;
 
-	    // Table of contributions
-	    double ** tables;
-
-	    // Links between each bit
-	    // links[i][0], ..., links[i][K] : the (K+1) links to the bit i
-	    unsigned ** links;
-
 	    /**
 	     * Empty constructor
 	     */
-	    NKLandscapes() : N(0), K(0)
-	    {
-		tables = NULL;
-		links  = NULL;
-	    };
+	    NKLandscapes() : N(0), K(0), _stride(0), _tables(NULL) {}
 
 	    /**
 	     * Constructor of random instance
@@ -71,24 +91,41 @@ namespace dim
 	     * @param _K number of the epistatic links
 	     * @param consecutive : if true then the links are consecutive (i, i+1, i+2, ..., i+K), else the links are randomly choose from (1..N)
 	     */
-	    NKLandscapes(int _N, int _K, bool consecutive = false) : N(_N), K(_K)
+	    NKLandscapes(int _N, int _K, bool consecutive = false) : N(_N), K(_K), _stride(0), _tables(NULL)
 	    {
 		if (consecutive)
 		    consecutiveTables();
 		else
 		    randomTables();
-	    };
+	    }
 
 	    /**
 	     * Constructor from a file instance
 	     *
 	     * @param _fileName the name of the file of the instance
 	     */
-	    NKLandscapes(const char * _fileName)
+	    NKLandscapes(const char * _fileName) : N(0), K(0), _stride(0), _tables(NULL)
 	    {
 		std::string fname(_fileName);
 		load(fname);
-	    };
+	    }
+
+	    NKLandscapes(const NKLandscapes& nk) : eoEvalFunc<EOT>(), N(0), K(0), _stride(0), _tables(NULL) { *this = nk; }
+
+	    NKLandscapes& operator=(const NKLandscapes& nk)
+	    {
+		if ( &nk != this )
+		    {
+			N = nk.N;
+			K = nk.K;
+			buildTables();
+			std::copy(nk._tables, nk._tables + N * _stride, _tables);
+			_links = nk._links;
+			_lociBegin = nk._lociBegin;
+			_loci = nk._loci;
+		    }
+		return *this;
+	    }
 
 	    /**
 	     * Default destructor of the table contribution and the links
@@ -96,43 +133,51 @@ namespace dim
 	    ~NKLandscapes()
 	    {
 		deleteTables();
-	    };
+	    }
+
+	    /// entries of the table of the contribution i, 2^(K+1) of them
+	    inline const Value* table(unsigned i) const { return _tables + i * _stride; }
+
+	    /// the K+1 bits linked to the contribution i
+	    inline const unsigned* link(unsigned i) const { return &_links[ i * (K+1) ]; }
+
+	    /// the contributions linked to the bit b, from begin to end
+	    inline const Locus* lociBegin(unsigned b) const { return &_loci[0] + _lociBegin[b]; }
+	    inline const Locus* lociEnd(unsigned b) const { return &_loci[0] + _lociBegin[b+1]; }
 
 	    /**
 	     * Reserve the space memory for the links and the table
 	     */
 	    void buildTables()
 	    {
-		links  = new unsigned*[N];
-		tables = new double*[N];
+		deleteTables();
 
-		for(unsigned i = 0; i < N; i++) {
-		    tables[i] = new double[1<<(K+1)];
-		    links[i]  = new unsigned[K+1];
-		}
-	    };
+		// each table starts on a cache line
+		const size_t perLine = 64 / sizeof(Value);
+		const size_t entries = size_t(1) << (K+1);
+		_stride = ( entries + perLine - 1 ) / perLine * perLine;
+
+		void* ptr = NULL;
+		if ( N && posix_memalign(&ptr, 64, N * _stride * sizeof(Value)) != 0 )
+		    {
+			throw std::runtime_error("NKLandscapes: not enough memory for the tables");
+		    }
+		_tables = static_cast<Value*>(ptr);
+
+		_links.assign( N * (K+1), 0 );
+	    }
 
 	    /**
 	     * Free the space memory of the table contributions and the links
 	     */
 	    void deleteTables()
 	    {
-		if (links != NULL) {
-		    for(int i = 0; i < N; i++) {
-			delete [] (links[i]);
-		    }
-		    delete [] links;
-		    links = NULL;
-		}
-
-		if (tables != NULL) {
-		    for(int i = 0; i < N; i++) {
-			delete [] (tables[i]);
-		    }
-		    delete [] tables;
-		    tables = NULL;
-		}
-	    };
+		free(_tables);
+		_tables = NULL;
+		_links.clear();
+		_lociBegin.clear();
+		_loci.clear();
+	    }
 
 	    /**
 	     * Load the instance from a file
@@ -203,12 +248,14 @@ namespace dim
 		    }
 
 		    file.close();
+
+		    buildLoci();
 		} else {
 		    std::string str = "NKLandscapes.load: Could not open file [" + _fileName + "]." ;
 		    throw std::runtime_error(str);
 		}
 
-	    };
+	    }
 
 	    /**
 	     * Read the links from the file
@@ -217,11 +264,11 @@ namespace dim
 	     */
 	    void loadLinks(std::fstream & file)
 	    {
-		for(int j = 0; j < K+1; j++)
+		for(unsigned j = 0; j < K+1; j++)
 		    {
-			for(int i = 0; i < N; i++)
+			for(unsigned i = 0; i < N; i++)
 			    {
-				file >> links[i][j];
+				file >> _links[ i * (K+1) + j ];
 			    }
 		    }
 	    }
@@ -233,11 +280,13 @@ namespace dim
 	     */
 	    void loadTables(std::fstream & file)
 	    {
-		for(int j = 0; j < (1<<(K+1)); j++)
+		for(unsigned j = 0; j < (1u<<(K+1)); j++)
 		    {
-			for(int i = 0; i < N; i++)
+			for(unsigned i = 0; i < N; i++)
 			    {
-				file >> tables[i][j];
+				double value;
+				file >> value;
+				_tables[ i * _stride + j ] = value;
 			    }
 		    }
 	    }
@@ -258,20 +307,20 @@ namespace dim
 			file << "p NK " << N << " " << K <<std::endl;
 
 			file << "p links" << std::endl;
-			for(int j=0; j<K+1; j++)
+			for(unsigned j=0; j<K+1; j++)
 			    {
-				for(int i=0; i<N; i++)
+				for(unsigned i=0; i<N; i++)
 				    {
-					file << links[i][j] << std::endl;
+					file << link(i)[j] << std::endl;
 				    }
 			    }
 
 			file << "p tables" << std::endl;
-			for(int j=0; j<(1<<(K+1)); j++)
+			for(unsigned j=0; j<(1u<<(K+1)); j++)
 			    {
-				for(int i=0; i<N; i++)
+				for(unsigned i=0; i<N; i++)
 				    {
-					file << tables[i][j] << " ";
+					file << table(i)[j] << " ";
 				    }
 				file << std::endl;
 			    }
@@ -283,34 +332,34 @@ namespace dim
 			std::string str = "NKLandscapes.save: Could not open file [" + fname + "]." ;
 			throw std::runtime_error(str);
 		    }
-	    };
+	    }
 
 	    /**
 	     * Print the instance to the screen
 	     */
 	    void print()
 	    {
-		int j;
-		for(int i=0; i<N; i++)
+		unsigned j;
+		for(unsigned i=0; i<N; i++)
 		    {
 			std::cout <<"link " <<i <<" : ";
 			for(j = 0; j <= K; j++)
 			    {
-				std::cout <<links[i][j] <<" ";
+				std::cout << link(i)[j] <<" ";
 			    }
 			std::cout << std::endl;
 		    }
 		std::cout << std::endl;
 
-		for(int i=0; i<N; i++)
+		for(unsigned i=0; i<N; i++)
 		    {
 			std::cout <<"table " << i << std::endl;
-			for(j=0; j<(1<<(K+1)); j++)
+			for(j=0; j<(1u<<(K+1)); j++)
 			    {
-				std::cout << tables[i][j] << std::endl;
+				std::cout << table(i)[j] << std::endl;
 			    }
 		    }
-	    };
+	    }
 
 	    /**
 	     * Compute the fitness value
@@ -321,15 +370,41 @@ namespace dim
 	    {
 		double accu = 0.0;
 
-		for(int i = 0; i < N; i++)
+		for(unsigned i = 0; i < N; i++)
 		    {
-			accu += tables[ i ][ sigma(_solution, i) ];
+			accu += table(i)[ sigma(_solution, i) ];
 		    }
 
 		_solution.fitness( accu / (double) N );
 	    }
 
-	protected:
+	    /**
+	     * The contributions of lanes solutions are summed in the same loop.
+	     *
+	     * The links and the table of each contribution are used by all the
+	     * lanes while they are in cache.
+	     */
+	    virtual void evaluate(EOT* const* sols, size_t count)
+	    {
+		size_t c = 0;
+
+		for (; c + lanes <= count; c += lanes)
+		    {
+			EOT* const* s = sols + c;
+			double accu[lanes];
+			for (size_t l = 0; l < lanes; ++l) { accu[l] = 0.0; }
+
+			for (unsigned i = 0; i < N; ++i)
+			    {
+				const Value* t = table(i);
+				for (size_t l = 0; l < lanes; ++l) { accu[l] += t[ sigma(*s[l], i) ]; }
+			    }
+
+			for (size_t l = 0; l < lanes; ++l) { s[l]->fitness( accu[l] / (double) N ); }
+		    }
+
+		for (; c < count; ++c) { (*this)(*sols[c]); }
+	    }
 
 	    /**
 	     * Compute the mask of the linked bits
@@ -337,21 +412,69 @@ namespace dim
 	     * @param _solution the solution to evaluate
 	     * @param i the bit of the contribution
 	     */
-	    unsigned int sigma(EOT & _solution, int i)
+	    inline unsigned int sigma(const EOT & _solution, unsigned i) const
 	    {
-		unsigned int n    = 1;
+		const unsigned* l = link(i);
 		unsigned int accu = 0;
 
-		for(int j = 0; j < K+1; j++)
+		for(unsigned j = 0; j < K+1; j++)
+		    {
+			if ( _solution[ l[j] ] ) { accu |= 1u << j; }
+		    }
+
+		return accu;
+	    }
+
+	protected:
+
+	    /**
+	     * Index the contributions linked to each bit, once the links are known
+	     *
+	     * A loaded instance may link a bit twice to the same contribution,
+	     * such a bit gets one locus whose mask holds both bits of the index.
+	     */
+	    void buildLoci()
+	    {
+		_lociBegin.assign( N + 1, 0 );
+		for (unsigned i = 0; i < N; ++i)
+		    {
+			for (unsigned j = 0; j < K+1; ++j)
+			    {
+				if ( first(i, j) ) { ++_lociBegin[ link(i)[j] + 1 ]; }
+			    }
+		    }
+		for (unsigned b = 0; b < N; ++b) { _lociBegin[b+1] += _lociBegin[b]; }
+
+		std::vector<unsigned> next( _lociBegin.begin(), _lociBegin.end() - 1 );
+		_loci.resize( _lociBegin[N] );
+
+		for (unsigned i = 0; i < N; ++i)
 		    {
-			if (_solution[ links[i][j] ] == 1)
+			const unsigned* l = link(i);
+			for (unsigned j = 0; j < K+1; ++j)
 			    {
-				accu = accu | n;
+				if ( !first(i, j) ) { continue; }
+
+				Locus& locus = _loci[ next[ l[j] ]++ ];
+				locus.contribution = i;
+				locus.mask = 0;
+				for (unsigned k = j; k < K+1; ++k)
+				    {
+					if ( l[k] == l[j] ) { locus.mask |= 1u << k; }
+				    }
 			    }
-			n = n << 1;
 		    }
+	    }
 
-		return accu;
+	    /// whether the j-th link of the contribution i is the first one to its bit
+	    bool first(unsigned i, unsigned j) const
+	    {
+		const unsigned* l = link(i);
+		for (unsigned k = 0; k < j; ++k)
+		    {
+			if ( l[k] == l[j] ) { return false; }
+		    }
+		return true;
 	    }
 
 	    /**
@@ -359,13 +482,13 @@ namespace dim
 	     *
 	     * @param tabTirage the table to initialize
 	     */
-	    void initTirage(int tabTirage[])
+	    void initTirage(std::vector<unsigned>& tabTirage)
 	    {
-		for(int i = 0; i<N; i++)
+		for(unsigned i = 0; i<N; i++)
 		    {
 			tabTirage[i] = i;
 		    }
-	    };
+	    }
 
 	    /**
 	     * To generate random instance without replacement : swap
@@ -374,12 +497,10 @@ namespace dim
 	     * @param i  first indice to swap
 	     * @param j second indice to swap
 	     */
-	    void perm(int tabTirage[],int i, int j)
+	    void perm(std::vector<unsigned>& tabTirage, unsigned i, unsigned j)
 	    {
-		int k = tabTirage[i];
-		tabTirage[i] = tabTirage[j];
-		tabTirage[j] = k;
-	    };
+		std::swap(tabTirage[i], tabTirage[j]);
+	    }
 
 	    /**
 	     * To generate random instance without replacement
@@ -388,14 +509,14 @@ namespace dim
 	     * @param i the bit of contribution
 	     * @param tabTirage the table of bits
 	     */
-	    void choose(int i, int tabTirage[])
+	    void choose(unsigned i, std::vector<unsigned>& tabTirage)
 	    {
-		int t[K+1];
-		for(int j=0; j<K+1; j++)
+		std::vector<unsigned> t(K+1);
+		for(unsigned j=0; j<K+1; j++)
 		    {
 			if (j==0) t[j]=i;
 			else t[j] = rng.random(N-j);
-			links[i][j] = tabTirage[t[j]];
+			_links[ i * (K+1) + j ] = tabTirage[t[j]];
 			perm(tabTirage, t[j], N-1-j);
 		    }
 		for(int j=K; j>=0; j--)
@@ -409,11 +530,11 @@ namespace dim
 	     *
 	     * @param i the bit of contribution
 	     */
-	    void consecutiveLinks(int i)
+	    void consecutiveLinks(unsigned i)
 	    {
-		for(int j = 0; j < K+1; j++)
+		for(unsigned j = 0; j < K+1; j++)
 		    {
-			links[i][j] = (i + j) % N;
+			_links[ i * (K+1) + j ] = (i + j) % N;
 		    }
 	    }
 
@@ -434,20 +555,22 @@ namespace dim
 	    {
 		buildTables();
 
-		int tabTirage[N];
+		std::vector<unsigned> tabTirage(N);
 		initTirage(tabTirage);
 
-		for(int i = 0; i < N; i++)
+		for(unsigned i = 0; i < N; i++)
 		    {
 			// random links to the bit
 			choose(i, tabTirage);
 
 			// table of contribution with random numbers from [0,1)
-			for(int j = 0; j < (1<<(K+1)); j++)
+			for(unsigned j = 0; j < (1u<<(K+1)); j++)
 			    {
-				tables[i][j] = contribution();
+				_tables[ i * _stride + j ] = contribution();
 			    }
 		    }
+
+		buildLoci();
 	    }
 
 	    /**
@@ -458,19 +581,27 @@ namespace dim
 	    {
 		buildTables();
 
-		for(int i = 0; i < N; i++)
+		for(unsigned i = 0; i < N; i++)
 		    {
 			// consecutive link to bit i
 			consecutiveLinks(i);
 
 			// table of contribution with random numbers from [0,1)
-			for(int j = 0; j < (1<<(K+1)); j++)
+			for(unsigned j = 0; j < (1u<<(K+1)); j++)
 			    {
-				tables[i][j] = contribution();
+				_tables[ i * _stride + j ] = contribution();
 			    }
 		    }
+
+		buildLoci();
 	    }
 
+	private:
+	    size_t _stride; // entries between two tables
+	    Value* _tables;
+	    std::vector<unsigned> _links; // the K+1 links of each contribution
+	    std::vector<unsigned> _lociBegin; // first locus of each bit, N+1 of them
+	    std::vector<Locus> _loci;
 	};
 
     } // !evaluation
@@ -21,6 +21,7 @@
 #define _EVALUATION_ONEMAX_H_
 
 #include <eoEvalFunc.h>
+#include <dim/core/PackedBit.h>
 
 namespace dim
 {
@@ -54,6 +55,17 @@ namespace dim
 	    }
 	};
 
+	/// the ones of a PackedBit are counted word by word
+	template< class FitT >
+	class OneMax< core::PackedBit<FitT> > : public eoEvalFunc< core::PackedBit<FitT> >
+	{
+	public:
+	    void operator() (core::PackedBit<FitT>& _sol)
+	    {
+		_sol.fitness( _sol.count() );
+	    }
+	};
+
     } // !evaluation
 } // !dim
 
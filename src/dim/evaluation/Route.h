@@ -39,6 +39,8 @@
 #include <dim/initialization/TSPLibGraph.h>
 #include <dim/representation/Route.h>
 
+#include "Batch.h"
+
 #ifndef _EVALUATION_ROUTE_H_
 #define _EVALUATION_ROUTE_H_
 
@@ -48,21 +50,75 @@ namespace dim
     {
 
 	template <typename FitT = double>
-	class Route : public eoEvalFunc< representation::Route<FitT> >
+	class Route : public eoEvalFunc< representation::Route<FitT> >, public Batch< representation::Route<FitT> >
 	{
 	public:
+	    typedef representation::Route<FitT> EOT;
+	    using Batch<EOT>::lanes;
+
 	    void operator()(representation::Route<FitT> & __route)
 	    {
+		const size_t n = __route.size();
 		double len = 0 ;
-		for (unsigned i = 0 ; i < initialization::TSPLibGraph::size()-1 ; i ++)
+
+		if ( n >= 2 )
 		    {
-			len -= initialization::TSPLibGraph::distance(__route[i], __route[(i + 1)]);
-		    }
+			for (size_t i = 0 ; i < n-1 ; i ++)
+			    {
+				len -= initialization::TSPLibGraph::distance(__route[i], __route[(i + 1)]);
+			    }
 
-		len -= initialization::TSPLibGraph::distance(__route[ initialization::TSPLibGraph::size()-1 ], __route[0]);
+			len -= initialization::TSPLibGraph::distance(__route[n-1], __route[0]);
+		    }
 
 		__route.fitness(len);
 	    }
+
+	    /**
+	     * The tours of lanes routes are summed in the same loop.
+	     *
+	     * The distances of the lanes are independent loads, so they are in
+	     * flight together instead of one after the other. The edges are
+	     * summed in the same order as operator(), which gives the same lengths.
+	     * Lanes of different lengths, or of less than two cities, go through
+	     * operator() one by one.
+	     */
+	    virtual void evaluate(EOT* const* sols, size_t count)
+	    {
+		size_t c = 0;
+
+		for (; c + lanes <= count; c += lanes)
+		    {
+			EOT* const* s = sols + c;
+			const size_t n = s[0]->size();
+
+			bool same = n >= 2;
+			for (size_t l = 1; l < lanes && same; ++l) { same = s[l]->size() == n; }
+			if ( !same )
+			    {
+				for (size_t l = 0; l < lanes; ++l) { (*this)(*s[l]); }
+				continue;
+			    }
+
+			const unsigned* r[lanes];
+			double len[lanes];
+
+			for (size_t l = 0; l < lanes; ++l) { r[l] = &(*s[l])[0]; len[l] = 0; }
+
+			for (size_t i = 0; i < n-1; ++i)
+			    {
+				for (size_t l = 0; l < lanes; ++l) { len[l] -= initialization::TSPLibGraph::distance(r[l][i], r[l][i+1]); }
+			    }
+
+			for (size_t l = 0; l < lanes; ++l)
+			    {
+				len[l] -= initialization::TSPLibGraph::distance(r[l][n-1], r[l][0]);
+				s[l]->fitness(len[l]);
+			    }
+		    }
+
+		for (; c < count; ++c) { (*this)(*sols[c]); }
+	    }
 	};
 
     } // !evaluation
@@ -22,6 +22,8 @@
 
 #include "Base.h"
 #include <dim/utils/Measure.h>
+#include <dim/evaluation/Batch.h>
+#include <dim/core/FitnessCache.h>
 
 #include <boost/utility/identity_type.hpp>
 
@@ -46,7 +48,20 @@ namespace dim
 	class Easy : public Base<EOT>
 	{
 	public:
-	    Easy(eoEvalFunc<EOT>& eval, eoMonOp<EOT>& op, bool invalidate = true, size_t nbmove = 1) : _eval(eval), _op(op), _invalidate(invalidate), _nbmove(nbmove) {}
+	    /**
+	     * @param batch generate the nbmove candidates of every individual
+	     *        first and evaluate them together (see evaluation::Batch),
+	     *        each individual is then replaced by its best candidate if
+	     *        it is better. Otherwise every candidate is evaluated as soon
+	     *        as it is generated and the next one starts from the winner.
+	     * @param cache if not null, the fitness of a candidate is looked up
+	     *        by its Zobrist hash before evaluating it, and stored after.
+	     *        The hash is kept through the operators which are a
+	     *        core::zobrist::Keeper and computed again after the others.
+	     */
+	    Easy(eoEvalFunc<EOT>& eval, eoMonOp<EOT>& op, bool invalidate = true, size_t nbmove = 1, bool batch = false, core::FitnessCache<typename EOT::Fitness>* cache = NULL)
+		: _eval(eval), _op(op), _invalidate(invalidate), _nbmove(nbmove), _batch(batch), _cache(cache),
+		  _keeper( dynamic_cast<core::zobrist::Keeper*>(&op) != NULL ) {}
 
 	    virtual void firstCall(core::Pop<EOT>& /*pop*/, core::IslandData<EOT>& data)
 	    {
@@ -66,6 +81,12 @@ namespace dim
 
 	    void operator()(core::Pop<EOT>& pop, core::IslandData<EOT>& /*data*/)
 	    {
+		if (_batch)
+		    {
+			DO_MEASURE( batch(pop); , _measureFiles, "evolve_total" );
+			return;
+		    }
+
 		DO_MEASURE(
 
 			   for (size_t i = 0; i < pop.size(); ++i)
@@ -77,7 +98,7 @@ namespace dim
 					   EOT candidate = ind;
 
 					   DO_MEASURE(
-						      _op( candidate );
+						      vary( candidate );
 						      , _measureFiles, "evolve_op" );
 
 					   if (_invalidate)
@@ -86,7 +107,7 @@ namespace dim
 					       }
 
 					   DO_MEASURE(
-						      _eval( candidate );
+						      if ( !lookup( candidate ) ) { _eval( candidate ); store( candidate ); }
 						      , _measureFiles, "evolve_eval" );
 
 					   if ( candidate.fitness() > ind.fitness() )
@@ -100,10 +121,82 @@ namespace dim
 	    }
 
 	private:
+	    /// applies the operator, the hash of the candidate being given up if the operator does not keep it
+	    inline void vary(EOT& candidate)
+	    {
+		if ( !_keeper ) { candidate.unhash(); }
+		_op( candidate );
+	    }
+
+	    /// gives the cached fitness of an invalid candidate, false if it has to be evaluated
+	    bool lookup(EOT& candidate)
+	    {
+		if ( !_cache || !candidate.invalid() ) { return false; }
+
+		if ( !candidate.hashed() ) { candidate.hash( core::zobrist::hash(candidate) ); }
+
+		typename EOT::Fitness fitness;
+		if ( !_cache->find( candidate.hash(), fitness ) ) { return false; }
+
+		candidate.fitness( fitness );
+		return true;
+	    }
+
+	    inline void store(const EOT& candidate)
+	    {
+		if ( _cache && candidate.hashed() ) { _cache->insert( candidate.hash(), candidate.fitness() ); }
+	    }
+
+	    void batch(core::Pop<EOT>& pop)
+	    {
+		_candidates.resize( pop.size() * _nbmove );
+		_sols.resize( _candidates.size() );
+
+		DO_MEASURE(
+			   for (size_t c = 0; c < _candidates.size(); ++c)
+			       {
+				   EOT& candidate = _candidates[c];
+				   candidate = pop[ c / _nbmove ];
+				   vary( candidate );
+				   if (_invalidate) { candidate.invalidate(); }
+				   _sols[c] = &candidate;
+			       }
+			   , _measureFiles, "evolve_op" );
+
+		// the candidates found in the cache are valid and left out of the batch
+		_misses.clear();
+		for (size_t c = 0; _cache && c < _sols.size(); ++c)
+		    {
+			if ( _sols[c]->invalid() && !lookup( *_sols[c] ) ) { _misses.push_back( _sols[c] ); }
+		    }
+
+		DO_MEASURE(
+			   if ( !_sols.empty() ) { evaluation::evaluate( _eval, &_sols[0], _sols.size() ); }
+			   , _measureFiles, "evolve_eval" );
+
+		for (size_t c = 0; c < _misses.size(); ++c) { store( *_misses[c] ); }
+
+		for (size_t c = 0; c < _candidates.size(); ++c)
+		    {
+			EOT& ind = pop[ c / _nbmove ];
+			if ( _candidates[c].fitness() > ind.fitness() )
+			    {
+				ind = _candidates[c];
+			    }
+		    }
+	    }
+
 	    eoEvalFunc<EOT>& _eval;
 	    eoMonOp<EOT>& _op;
 	    bool _invalidate;
 	    size_t _nbmove;
+	    bool _batch;
+	    core::FitnessCache<typename EOT::Fitness>* _cache;
+	    bool _keeper;
+
+	    std::vector<EOT> _candidates; // kept between the generations with their genes
+	    std::vector<EOT*> _sols;
+	    std::vector<EOT*> _misses;
 
 #ifdef MEASURE
 	    std::map<std::string, std::ofstream*> _measureFiles;
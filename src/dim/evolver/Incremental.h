@@ -0,0 +1,112 @@
+// -*- mode: c++; c-indent-level: 4; c++-member-init-indent: 8; comment-column: 35; -*-
+
+/* This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+ * Authors:
+ * Caner Candan <caner.candan@univ-angers.fr>
+ */
+
+#ifndef _EVOLVER_INCREMENTAL_H_
+#define _EVOLVER_INCREMENTAL_H_
+
+#include "Base.h"
+#include <dim/utils/Measure.h>
+#include <dim/variation/Move.h>
+
+namespace dim
+{
+    namespace evolver
+    {
+#if __cplusplus > 199711L
+	namespace std_or_boost = std;
+#else
+	namespace std_or_boost = boost;
+#endif
+
+	/**
+	 * Same as Easy with moves instead of an operator and a full evaluation.
+	 *
+	 * Each of the nbmove moves is drawn and evaluated on the individual
+	 * itself, and only applied if it improves it, so neither the individual
+	 * is copied nor its fitness computed again. The individuals of the
+	 * population have to be evaluated.
+	 */
+	template <typename EOT>
+	class Incremental : public Base<EOT>
+	{
+	public:
+	    typedef typename EOT::Fitness Fitness;
+
+	    Incremental(variation::Move<EOT>& move, size_t nbmove = 1) : _move(move), _nbmove(nbmove) {}
+
+	    virtual void firstCall(core::Pop<EOT>& /*pop*/, core::IslandData<EOT>& data)
+	    {
+		std::ostringstream ss;
+
+#ifdef MEASURE
+		ss.str(""); ss << data.monitorPrefix << ".evolve_total.time." << this->rank();
+		_measureFiles["evolve_total"] = new std::ofstream(ss.str().c_str());
+
+		ss.str(""); ss << data.monitorPrefix << ".evolve_op.time." << this->rank();
+		_measureFiles["evolve_op"] = new std::ofstream(ss.str().c_str());
+
+		ss.str(""); ss << data.monitorPrefix << ".evolve_eval.time." << this->rank();
+		_measureFiles["evolve_eval"] = new std::ofstream(ss.str().c_str());
+#endif // !MEASURE
+	    }
+
+	    void operator()(core::Pop<EOT>& pop, core::IslandData<EOT>& /*data*/)
+	    {
+		DO_MEASURE(
+
+			   for (size_t i = 0; i < pop.size(); ++i)
+			       {
+				   EOT& ind = pop[i];
+
+				   for (size_t k = 0; k < _nbmove; ++k)
+				       {
+					   Fitness delta;
+
+					   _move.draw( ind );
+
+					   DO_MEASURE(
+						      delta = _move.delta( ind );
+						      , _measureFiles, "evolve_eval" );
+
+					   if ( delta > 0 )
+					       {
+						   DO_MEASURE(
+							      _move.apply( ind );
+							      , _measureFiles, "evolve_op" );
+
+						   ind.fitness( ind.fitness() + delta );
+					       }
+				       }
+			       }
+
+			   , _measureFiles, "evolve_total" );
+	    }
+
+	private:
+	    variation::Move<EOT>& _move;
+	    size_t _nbmove;
+
+#ifdef MEASURE
+	    std::map<std::string, std::ofstream*> _measureFiles;
+#endif // !MEASURE
+	};
+    } // !evolver
+} // !dim
+
+#endif /* _EVOLVER_INCREMENTAL_H_ */
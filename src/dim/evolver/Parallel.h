@@ -0,0 +1,206 @@
+// -*- mode: c++; c-indent-level: 4; c++-member-init-indent: 8; comment-column: 35; -*-
+
+/* This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+ * Authors:
+ * Caner Candan <caner.candan@univ-angers.fr>
+ */
+
+#ifndef _EVOLVER_PARALLEL_H_
+#define _EVOLVER_PARALLEL_H_
+
+#include "Base.h"
+#include <dim/utils/Measure.h>
+#include <dim/core/ThreadPool.h>
+#include <dim/core/Random.h>
+
+#include <eoEvalFuncCounter.h>
+
+#include <stdexcept>
+
+namespace dim
+{
+    namespace evolver
+    {
+
+	/**
+	 * Same as Easy with the population split in parts evolved in parallel.
+	 *
+	 * The population is cut in as many contiguous slices as there are
+	 * parts, and each part evolves its slice with its own operator, its own
+	 * evaluator and its own random generator, bound to the thread running
+	 * it. The parts are run by a thread pool, possibly shared by the
+	 * islands of the process, the island thread taking part too.
+	 *
+	 * The generators of the parts are seeded in firstCall() from the one of
+	 * the island, so for a given number of parts the results of an island do
+	 * not depend on the pool nor on the scheduling of the threads.
+	 *
+	 * The evaluations done by the parts are added to the counter of the
+	 * island once all of them are over, so the continuators and monitors
+	 * relying on it see the total.
+	 */
+	template <typename EOT>
+	class Parallel : public Base<EOT>
+	{
+	public:
+	    /**
+	     * @param counter evaluation counter of the island
+	     * @param evals one evaluator per part, not shared with another part
+	     * @param ops one operator per part, not shared with another part
+	     * @param pool if null, the parts are run in turn by the island thread
+	     */
+	    Parallel(eoEvalFuncCounter<EOT>& counter, const std::vector< eoEvalFunc<EOT>* >& evals, const std::vector< eoMonOp<EOT>* >& ops, core::ThreadPool* pool = NULL, bool invalidate = true, size_t nbmove = 1)
+		: _counter(counter), _evals(evals), _ops(ops), _pool(pool), _invalidate(invalidate), _nbmove(nbmove),
+		  _randoms(evals.size()), _candidates(evals.size()), _evaluations(evals.size(), 0)
+	    {
+		if ( evals.empty() || evals.size() != ops.size() )
+		    {
+			throw std::runtime_error("evolver::Parallel: one evaluator and one operator per part");
+		    }
+	    }
+
+	    /// number of parts the population is split in
+	    inline size_t parts() const { return _evals.size(); }
+
+	    virtual void firstCall(core::Pop<EOT>& /*pop*/, core::IslandData<EOT>& data)
+	    {
+		for (size_t p = 0; p < parts(); ++p)
+		    {
+			_randoms[p].seed( data.random.next(), p );
+		    }
+
+		std::ostringstream ss;
+
+#ifdef MEASURE
+		ss.str(""); ss << data.monitorPrefix << ".evolve_total.time." << this->rank();
+		_measureFiles["evolve_total"] = new std::ofstream(ss.str().c_str());
+
+		if ( _pool )
+		    {
+			ss.str(""); ss << data.monitorPrefix << ".evolve_efficiency." << this->rank();
+			_measureFiles["evolve_efficiency"] = new std::ofstream(ss.str().c_str());
+		    }
+#endif // !MEASURE
+	    }
+
+	    void operator()(core::Pop<EOT>& pop, core::IslandData<EOT>& /*data*/)
+	    {
+		DO_MEASURE( evolve(pop); , _measureFiles, "evolve_total" );
+	    }
+
+	private:
+	    /// evolves the slice of one part, called by the pool
+	    class Part
+	    {
+	    public:
+		Part(Parallel& evolver, core::Pop<EOT>& pop) : _evolver(evolver), _pop(pop) {}
+
+		void operator()(size_t p) { _evolver.evolve(_pop, p); }
+
+	    private:
+		Parallel& _evolver;
+		core::Pop<EOT>& _pop;
+	    };
+
+	    void evolve(core::Pop<EOT>& pop)
+	    {
+		Part part(*this, pop);
+
+		if ( !_pool )
+		    {
+			for (size_t p = 0; p < parts(); ++p) { part(p); }
+		    }
+		else
+		    {
+#ifdef MEASURE
+			core::ThreadPool::Stats stats;
+			_pool->run(part, parts(), &stats);
+			*(_measureFiles["evolve_efficiency"]) << stats.efficiency() << std::endl;
+#else
+			_pool->run(part, parts());
+#endif // !MEASURE
+		    }
+
+		// the counters of the parts are not shared between threads, the one of the island is updated once they are over
+		for (size_t p = 0; p < parts(); ++p)
+		    {
+			_counter.value() += _evaluations[p];
+		    }
+	    }
+
+	    void evolve(core::Pop<EOT>& pop, size_t p)
+	    {
+		// a pool worker has no binding of its own, so that one is restored as well
+		core::Random* previous = core::Random::localBinding();
+		core::Random::local( &_randoms[p] );
+
+		eoEvalFunc<EOT>& eval = *_evals[p];
+		eoMonOp<EOT>& op = *_ops[p];
+		EOT& candidate = _candidates[p];
+		size_t evaluations = 0;
+
+		size_t end = pop.size() * (p + 1) / parts();
+		for (size_t i = pop.size() * p / parts(); i < end; ++i)
+		    {
+			EOT& ind = pop[i];
+
+			for (size_t k = 0; k < _nbmove; ++k)
+			    {
+				candidate = ind;
+
+				op( candidate );
+
+				if (_invalidate)
+				    {
+					candidate.invalidate();
+				    }
+
+				if ( candidate.invalid() )
+				    {
+					++evaluations;
+					eval( candidate );
+				    }
+
+				if ( candidate.fitness() > ind.fitness() )
+				    {
+					ind = candidate;
+				    }
+			    }
+		    }
+
+		_evaluations[p] = evaluations;
+
+		core::Random::local( previous );
+	    }
+
+	    eoEvalFuncCounter<EOT>& _counter;
+	    std::vector< eoEvalFunc<EOT>* > _evals;
+	    std::vector< eoMonOp<EOT>* > _ops;
+	    core::ThreadPool* _pool;
+	    bool _invalidate;
+	    size_t _nbmove;
+
+	    std::vector<core::Random> _randoms;
+	    std::vector<EOT> _candidates; // kept between the generations with their genes
+	    std::vector<size_t> _evaluations;
+
+#ifdef MEASURE
+	    std::map<std::string, std::ofstream*> _measureFiles;
+#endif // !MEASURE
+	};
+    } // !evolver
+} // !dim
+
+#endif /* _EVOLVER_PARALLEL_H_ */
@@ -35,6 +35,14 @@ namespace dim
 	    virtual void firstCall(core::Pop<EOT>&, core::IslandData<EOT>&) {}
 	    virtual void lastCall(core::Pop<EOT>&, core::IslandData<EOT>&) {}
 	    virtual void addTo(core::ThreadsRunner<EOT>&) {}
+
+	    /**
+	     * Split feedback of the overlapped loop of algo::Easy: post()
+	     * starts sending the feedbacks of pop and wait() folds the ones
+	     * received into data. By default post() does it all at once.
+	     */
+	    virtual void post(core::Pop<EOT>& pop, core::IslandData<EOT>& data) { (*this)(pop, data); }
+	    virtual void wait(core::Pop<EOT>& /*pop*/, core::IslandData<EOT>& /*data*/) {}
 	};
     }
 }
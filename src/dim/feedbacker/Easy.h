@@ -25,6 +25,8 @@
 #include <queue>
 
 #include "Base.h"
+#include <dim/core/ProgressEngine.h>
+#include <dim/core/Collective.h>
 #include <dim/utils/Measure.h>
 
 #include <boost/utility/identity_type.hpp>
@@ -122,12 +124,12 @@ namespace dim
 				********************/
 
 			       DO_MEASURE(
-					  while ( !data.feedbackerReceivingQueue.empty() )
+					  typename EOT::Fitness Fi;
+					  double t;
+					  size_t from;
+
+					  while ( data.feedbackerReceivingQueue.try_pop(Fi, t, from) )
 					      {
-						  AUTO(typename BOOST_IDENTITY_TYPE((std_or_boost::tuple<typename EOT::Fitness, double, size_t>))) fbr = data.feedbackerReceivingQueue.pop();
-						  AUTO(typename EOT::Fitness) Fi = std_or_boost::get<0>(fbr);
-						  // double t = std_or_boost::get<1>(fbr);
-						  AUTO(size_t) from = std_or_boost::get<2>(fbr);
 						  AUTO(typename EOT::Fitness)& Si = data.feedbacks[from];
 						  AUTO(std_or_boost::chrono::time_point< std_or_boost::chrono::system_clock >)& Ti = data.feedbackLastUpdatedTimes[from];
 						  AUTO(std_or_boost::chrono::time_point< std_or_boost::chrono::system_clock >) end = std_or_boost::chrono::system_clock::now(); // t
@@ -179,8 +181,19 @@ namespace dim
 
 		void operator()(core::Pop<EOT>& pop, core::IslandData<EOT>& data)
 		{
-		    std::vector< boost::mpi::request > reqs;
+		    send(pop);
+		    receive(data);
+		}
+
+		/// starts sending the feedbacks of pop
+		virtual void post(core::Pop<EOT>& pop, core::IslandData<EOT>& /*data*/) { send(pop); }
 
+		/// completes the exchange started by post(), updating the feedbacks of data
+		virtual void wait(core::Pop<EOT>& /*pop*/, core::IslandData<EOT>& data) { receive(data); }
+
+	    private:
+		void send(core::Pop<EOT>& pop)
+		{
 		    /************************************************
 		     * Send feedbacks back to all islands (ANALYSE) *
 		     ************************************************/
@@ -195,35 +208,27 @@ namespace dim
 			    ++nbs[ind.getLastIsland()];
 			}
 
+		    _out.resize(this->size());
+
 		    for (size_t i = 0; i < this->size(); ++i)
 			{
-			    if (i == this->rank()) { continue; }
-
-			    AUTO(double) effectiveness = nbs[i] > 0 ? sums[i] / nbs[i] : 0;
-			    reqs.push_back( this->world().isend( i, this->tag(), effectiveness ) );
+			    _out[i] = nbs[i] > 0 ? sums[i] / nbs[i] : 0;
 			}
 
+		    core::Collective<EOT>::shared().postFeedbacks( _out );
+		}
+
+		void receive(core::IslandData<EOT>& data)
+		{
 		    /**************************************
 		     * Receive feedbacks from all islands *
 		     **************************************/
 
-		    std::vector< typename EOT::Fitness > effectivenesses(this->size());
-
-		    for (size_t i = 0; i < this->size(); ++i)
-			{
-			    if (i == this->rank()) { continue; }
-
-			    reqs.push_back( this->world().irecv( i, this->tag(), effectivenesses[i] ) );
-			}
+		    std::vector< typename EOT::Fitness > effectivenesses;
+		    core::Collective<EOT>::shared().waitFeedbacks( effectivenesses );
 
 		    // for island itself because of the MPI communication optimizing.
-		    effectivenesses[this->rank()] = nbs[this->rank()] > 0 ? sums[this->rank()] / nbs[this->rank()] : 0;
-
-		    /****************************
-		     * Process all MPI requests *
-		     ****************************/
-
-		    boost::mpi::wait_all( reqs.begin(), reqs.end() );
+		    effectivenesses[this->rank()] = _out[this->rank()];
 
 		    /********************
 		     * Update feedbacks *
@@ -241,8 +246,8 @@ namespace dim
 			}
 		}
 
-	    private:
 		double _alpha;
+		std::vector< typename EOT::Fitness > _out; // own feedbacks of the exchange in flight
 #ifdef TRACE
 		std::ofstream _of;
 #endif // !TRACE
@@ -258,15 +263,6 @@ namespace dim
 	    public:
 		Easy(double alpha = 0.01, double sensitivity = 1., bool delta = true) : _alpha(alpha), _sensitivity(sensitivity), _delta(delta) {}
 
-		~Easy()
-		{
-		    for (size_t i = 0; i < this->_senders.size(); ++i)
-			{
-			    delete _senders[i];
-			    delete _receivers[i];
-			}
-		}
-
 		virtual void firstCall(core::Pop<EOT>& /*pop*/, core::IslandData<EOT>& /*data*/)
 		{
 #ifdef TRACE
@@ -306,12 +302,12 @@ namespace dim
 
 		    // _of << "[" << data.feedbackerReceivingQueue.size() << "] "; _of.flush();
 
-		    while ( !data.feedbackerReceivingQueue.empty() )
+		    typename EOT::Fitness Fi;
+		    double t;
+		    size_t from;
+
+		    while ( data.feedbackerReceivingQueue.try_pop(Fi, t, from) )
 			{
-			    AUTO(typename BOOST_IDENTITY_TYPE((std_or_boost::tuple<typename EOT::Fitness, double, size_t>))) fbr = data.feedbackerReceivingQueue.pop();
-			    AUTO(typename EOT::Fitness) Fi = std_or_boost::get<0>(fbr);
-			    // double t = std_or_boost::get<1>(fbr);
-			    AUTO(size_t) from = std_or_boost::get<2>(fbr);
 			    AUTO(typename EOT::Fitness)& Si = data.feedbacks[from];
 			    AUTO(std_or_boost::chrono::time_point< std_or_boost::chrono::system_clock >)& Ti = data.feedbackLastUpdatedTimes[from];
 
@@ -338,64 +334,17 @@ namespace dim
 			}
 		}
 
-		class Sender : public core::Thread<EOT>, public core::ParallelContext
-		{
-		public:
-		    Sender(size_t to, size_t tag = 0) : ParallelContext(tag), _to(to) {}
-
-		    void operator()(core::Pop<EOT>& /*pop*/, core::IslandData<EOT>& data)
-		    {
-			while (data.toContinue)
-			    {
-				AUTO(typename BOOST_IDENTITY_TYPE((std_or_boost::tuple<typename EOT::Fitness, double, size_t>))) fbs = data.feedbackerSendingQueue.pop( _to, true );
-				AUTO(typename EOT::Fitness) fit = std_or_boost::get<0>( fbs );
-
-				this->world().send(_to, this->size() * ( this->rank() + _to ) + this->tag(), fit);
-			    }
-		    }
-
-		private:
-		    size_t _to;
-		};
-
-		class Receiver : public core::Thread<EOT>, public core::ParallelContext
-		{
-		public:
-		    Receiver(size_t from, size_t tag = 0) : ParallelContext(tag), _from(from) {}
-
-		    void operator()(core::Pop<EOT>& /*pop*/, core::IslandData<EOT>& data)
-		    {
-			while (data.toContinue)
-			    {
-				typename EOT::Fitness fit;
-				this->world().recv(_from, this->size() * ( this->rank() + _from ) + this->tag(), fit);
-				data.feedbackerReceivingQueue.push( fit, _from );
-			    }
-		    }
-		private:
-		    size_t _from;
-		};
-
+	    public:
+		/// the messages are exchanged by the progress engine of the rank
 		virtual void addTo( core::ThreadsRunner<EOT>& tr )
 		{
-		    for (size_t i = 0; i < this->size(); ++i)
-			{
-			    if (i == this->rank()) { continue; }
-
-			    _senders.push_back( new Sender(i, this->tag()) );
-			    _receivers.push_back( new Receiver(i, this->tag()) );
-
-			    tr.add( _senders.back() );
-			    tr.add( _receivers.back() );
-			}
+		    core::ProgressEngine<EOT>::shared().serve( core::ProgressEngine<EOT>::Feedbacks, tr );
 		}
 
 	    private:
 		double _alpha;
 		double _sensitivity;
 		bool _delta;
-		std::vector<Sender*> _senders;
-		std::vector<Receiver*> _receivers;
 #ifdef TRACE
 		std::ofstream _of;
 #endif // !TRACE
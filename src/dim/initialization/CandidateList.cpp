@@ -0,0 +1,214 @@
+// -*- mode: c++; c-indent-level: 4; c++-member-init-indent: 8; comment-column: 35; -*-
+
+/* This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+ * Authors:
+ * Caner Candan <caner.candan@univ-angers.fr>
+ */
+
+#include <vector>
+#include <algorithm>
+#include <utility>
+#include <cmath>
+
+#include "TSPLibGraph.h"
+#include "CandidateList.h"
+
+namespace dim
+{
+    namespace initialization
+    {
+
+	namespace CandidateList
+	{
+	    namespace detail
+	    {
+		unsigned* lists = NULL;
+		unsigned k = 0;
+	    }
+
+	    using namespace detail;
+
+	    typedef std::pair<double, unsigned> Candidate; // (distance, city)
+
+	    /// sorts the candidates by their actual distance and stores them as the list of city i
+	    static void store(unsigned i, std::vector<Candidate>& candidates)
+	    {
+		for (size_t r = 0; r < candidates.size(); ++r)
+		    {
+			candidates[r].first = TSPLibGraph::distance(i, candidates[r].second);
+		    }
+
+		std::sort(candidates.begin(), candidates.end());
+
+		unsigned* list = lists + size_t(i) * k;
+		for (unsigned r = 0; r < k; ++r) { list[r] = candidates[r].second; }
+	    }
+
+	    /**
+	     * Bucketing of the cities in square cells holding two cities on average.
+	     *
+	     * Cells are visited by rings of increasing Chebyshev radius around the
+	     * cell of the city. Once k candidates are known, the search stops as soon
+	     * as the next ring is farther than the k-th candidate, which is exact for
+	     * the planar metrics.
+	     *
+	     * GEO coordinates are latitudes and longitudes: candidates are then
+	     * ranked by their actual distance and the rings are shrunk by the
+	     * cosine of the highest latitude. It is a close approximation which
+	     * ignores the neighbours across the antimeridian, only used when there
+	     * is no matrix to sort.
+	     */
+	    static void buildFromGrid(const double* x, const double* y, bool geo)
+	    {
+		const int n = TSPLibGraph::size();
+
+		double minx = *std::min_element(x, x + n), maxx = *std::max_element(x, x + n);
+		double miny = *std::min_element(y, y + n), maxy = *std::max_element(y, y + n);
+
+		double area = std::max(maxx - minx, 1e-9) * std::max(maxy - miny, 1e-9);
+		double side = std::sqrt( area * 2 / n );
+
+		const int gx = std::max(1, (int)std::ceil( (maxx - minx) / side ));
+		const int gy = std::max(1, (int)std::ceil( (maxy - miny) / side ));
+
+		std::vector<int> cellOf(n);
+		std::vector<unsigned> start(gx * gy + 1, 0);
+		std::vector<unsigned> order(n);
+
+		for (int i = 0; i < n; ++i)
+		    {
+			int cx = std::min(gx - 1, (int)( (x[i] - minx) / side ));
+			int cy = std::min(gy - 1, (int)( (y[i] - miny) / side ));
+			cellOf[i] = cy * gx + cx;
+			++start[ cellOf[i] + 1 ];
+		    }
+
+		for (int c = 0; c < gx * gy; ++c) { start[c + 1] += start[c]; }
+
+		// lower bound of a GEO distance per unit of coordinates
+		const double RRR = 6378.388;
+		double scale = RRR * std::cos( std::max(std::fabs(minx), std::fabs(maxx)) );
+
+		std::vector<unsigned> fill( start.begin(), start.end() - 1 );
+		for (int i = 0; i < n; ++i) { order[ fill[ cellOf[i] ]++ ] = i; }
+
+#pragma omp parallel for schedule(dynamic, 64)
+		for (int i = 0; i < n; ++i)
+		    {
+			// max-heap of the k closest cities found so far, by squared euclidean distance or GEO distance
+			std::vector<Candidate> heap;
+			heap.reserve(k + 1);
+
+			const int cx = cellOf[i] % gx;
+			const int cy = cellOf[i] / gx;
+
+			for (int r = 0; r <= std::max(gx, gy); ++r)
+			    {
+				for (int yy = cy - r; yy <= cy + r; ++yy)
+				    {
+					if ( yy < 0 || yy >= gy ) { continue; }
+
+					// inner rows of the ring only have their two ends
+					int step = ( yy == cy - r || yy == cy + r ) ? 1 : std::max(1, 2 * r);
+
+					for (int xx = cx - r; xx <= cx + r; xx += step)
+					    {
+						if ( xx < 0 || xx >= gx ) { continue; }
+
+						int c = yy * gx + xx;
+						for (unsigned t = start[c]; t < start[c + 1]; ++t)
+						    {
+							unsigned j = order[t];
+							if ( (int)j == i ) { continue; }
+
+							double dx = x[i] - x[j], dy = y[i] - y[j];
+							double d2 = geo ? TSPLibGraph::distance(i, j) : dx*dx + dy*dy;
+
+							if ( heap.size() < k )
+							    {
+								heap.push_back( Candidate(d2, j) );
+								std::push_heap( heap.begin(), heap.end() );
+							    }
+							else if ( d2 < heap.front().first )
+							    {
+								std::pop_heap( heap.begin(), heap.end() );
+								heap.back() = Candidate(d2, j);
+								std::push_heap( heap.begin(), heap.end() );
+							    }
+						    }
+					    }
+				    }
+
+				double reach = r * side;
+				double bound = geo ? scale * reach - 1 : reach * reach;
+				if ( heap.size() == k && heap.front().first <= bound ) { break; }
+			    }
+
+			store(i, heap);
+		    }
+	    }
+
+	    static void buildFromMatrix()
+	    {
+		const int n = TSPLibGraph::size();
+
+#pragma omp parallel for schedule(dynamic, 16)
+		for (int i = 0; i < n; ++i)
+		    {
+			std::vector<Candidate> row;
+			row.reserve(n - 1);
+
+			for (int j = 0; j < n; ++j)
+			    {
+				if ( j != i ) { row.push_back( Candidate(TSPLibGraph::distance(i, j), j) ); }
+			    }
+
+			std::nth_element( row.begin(), row.begin() + k - 1, row.end() );
+			row.resize(k);
+
+			store(i, row);
+		    }
+	    }
+
+	    void build(unsigned __k)
+	    {
+		unsigned n = TSPLibGraph::size();
+
+		delete[] lists;
+		lists = NULL;
+		k = std::min(__k, n ? n - 1 : 0);
+
+		if ( !k ) { return; }
+
+		lists = new unsigned[ size_t(n) * k ];
+
+		const double* x;
+		const double* y;
+
+		bool geo = TSPLibGraph::edgeWeightType() == "GEO";
+
+		if ( TSPLibGraph::coordinates(x, y) && !( geo && !TSPLibGraph::matrixFree() ) )
+		    {
+			buildFromGrid(x, y, geo);
+		    }
+		else
+		    {
+			buildFromMatrix();
+		    }
+	    }
+	}
+
+    }
+}
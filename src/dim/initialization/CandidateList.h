@@ -0,0 +1,61 @@
+// -*- mode: c++; c-indent-level: 4; c++-member-init-indent: 8; comment-column: 35; -*-
+
+/* This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+ * Authors:
+ * Caner Candan <caner.candan@univ-angers.fr>
+ */
+
+#ifndef _INITIALIZATION_CANDIDATELIST_H_
+#define _INITIALIZATION_CANDIDATELIST_H_
+
+#include <cstddef>
+
+namespace dim
+{
+    namespace initialization
+    {
+
+	/**
+	 * The k nearest neighbours of every city of the loaded TSPLibGraph.
+	 *
+	 * Restricting the local search to moves that create an edge towards
+	 * one of these candidates brings a step from O(n^2) down to O(n.k).
+	 *
+	 * Instances given by coordinates are bucketed in a uniform grid and each
+	 * city only looks at the cells around it. Instances given by their edge
+	 * weights fall back on a partial sort of every row of the matrix.
+	 */
+	namespace CandidateList
+	{
+	    namespace detail
+	    {
+		extern unsigned* lists;
+		extern unsigned k;
+	    }
+
+	    /// number of candidates per city
+	    inline unsigned size() { return detail::k; }
+
+	    /// the candidates of a city, sorted by increasing distance
+	    inline const unsigned* neighbors(unsigned __city) { return detail::lists + size_t(__city) * detail::k; }
+
+	    /// builds the lists of the loaded instance, k is bounded by the number of cities minus one
+	    void build(unsigned __k);
+	}
+
+    }
+}
+
+#endif // !_INITIALIZATION_CANDIDATELIST_H_
@@ -0,0 +1,78 @@
+// -*- mode: c++; c-indent-level: 4; c++-member-init-indent: 8; comment-column: 35; -*-
+
+/* This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+ * Authors:
+ * Caner Candan <caner.candan@univ-angers.fr>
+ */
+
+#ifndef _INITIALIZATION_PACKEDBIT_H_
+#define _INITIALIZATION_PACKEDBIT_H_
+
+#include <eoInit.h>
+#include <dim/core/PackedBit.h>
+#include <dim/core/Random.h>
+
+namespace dim
+{
+    namespace initialization
+    {
+
+	/**
+	 * Random PackedBit whose bits are ones with the probability bias.
+	 *
+	 * Unbiased strings are filled with whole random words, constant ones
+	 * directly, and the others bit by bit.
+	 */
+	template <typename FitT = double>
+	class PackedBit : public eoInit< core::PackedBit<FitT> >
+	{
+	public:
+	    typedef typename core::PackedBit<FitT>::Word Word;
+
+	    PackedBit(unsigned size, float bias = 0.5) : _size(size), _bias(bias) {}
+
+	    void operator()( core::PackedBit<FitT>& __sol )
+	    {
+		__sol.resize(0);
+		__sol.resize(_size, _bias >= 1);
+
+		if ( _bias > 0 && _bias < 1 )
+		    {
+			core::Random& random = core::Random::local();
+			Word* words = __sol.words();
+
+			if ( _bias == 0.5 )
+			    {
+				for (size_t w = 0; w < __sol.nwords(); ++w) { words[w] = random.next(); }
+				if ( __sol.nwords() ) { words[__sol.nwords() - 1] &= __sol.tailMask(); }
+			    }
+			else
+			    {
+				for (size_t i = 0; i < _size; ++i) { if ( random.flip(_bias) ) { __sol.flip(i); } }
+			    }
+		    }
+
+		__sol.invalidate();
+	    }
+
+	private:
+	    unsigned _size;
+	    float _bias;
+	};
+
+    }
+}
+
+#endif /* _INITIALIZATION_PACKEDBIT_H_ */
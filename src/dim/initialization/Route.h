@@ -39,7 +39,7 @@
 #ifndef _INITIALIZATION_ROUTE_H_
 #define _INITIALIZATION_ROUTE_H_
 
-#include <utils/eoRNG.h>
+#include <dim/core/Random.h>
 #include <eoInit.h>
 #include <dim/representation/Route.h>
 
@@ -61,9 +61,11 @@ namespace dim
 		for (unsigned i = 0 ; i < TSPLibGraph :: size () ; i ++)
 		    __route.push_back (i) ;
 
+		core::Random& random = core::Random::local();
+
 		// Swap. cities
 		for (unsigned i = 0 ; i < TSPLibGraph :: size () ; i ++) {
-		    unsigned j = (unsigned) (TSPLibGraph :: size () * (rand () / (RAND_MAX + 1.0))) ;
+		    unsigned j = random.random (TSPLibGraph :: size ()) ;
 		    unsigned city = __route [i] ;
 		    __route [i] = __route [j] ;
 		    __route [j] = city ;
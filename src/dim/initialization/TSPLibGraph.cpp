@@ -17,6 +17,20 @@
  * Caner Candan <caner.candan@univ-angers.fr>
  */
 
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/xml_parser.hpp>
+#include <boost/foreach.hpp>
+#include <boost/algorithm/string.hpp>
+
+#include <fstream>
+#include <iostream>
+#include <vector>
+#include <stdexcept>
+#include <cmath>
+#include <cstdlib>
+
+#include <sys/mman.h>
+
 #include "TSPLibGraph.h"
 
 namespace dim
@@ -26,27 +40,518 @@ namespace dim
 
 	namespace TSPLibGraph
 	{
-	    static Distance dist; // Distance Mat.
+	    namespace detail
+	    {
+		Atom* dist = NULL; // Distance Mat.
+		size_t stride = 0;
+		unsigned n = 0;
+#if defined(TSPLIB_DISTANCE_TRIANGULAR)
+		size_t* rows = NULL;
+#endif
+	    }
+
+	    using namespace detail;
+
+	    enum EdgeWeightType { EUC_2D, CEIL_2D, GEO, ATT, EXPLICIT };
+
+	    static EdgeWeightType edgeWeightTypeFromString(const std::string& type)
+	    {
+		if ( type == "EUC_2D" ) { return EUC_2D; }
+		if ( type == "CEIL_2D" ) { return CEIL_2D; }
+		if ( type == "GEO" ) { return GEO; }
+		if ( type == "ATT" ) { return ATT; }
+		if ( type == "EXPLICIT" ) { return EXPLICIT; }
+		throw std::runtime_error("TSPLibGraph: unsupported edge weight type " + type);
+	    }
+
+	    static void release()
+	    {
+		free(dist);
+		dist = NULL;
+#if defined(TSPLIB_DISTANCE_TRIANGULAR)
+		delete[] rows;
+		rows = NULL;
+#endif
+		n = 0;
+		stride = 0;
+	    }
+
+	    static void allocate(unsigned size, bool hugePages)
+	    {
+		release();
+
+		n = size;
+
+#if defined(TSPLIB_DISTANCE_TRIANGULAR)
+		rows = new size_t[n];
+		for (size_t i = 0; i < n; ++i) { rows[i] = i * n - i * (i + 1) / 2; }
+		size_t bytes = size_t(n) * (n + 1) / 2 * sizeof(Atom);
+#else
+		// each row starts on a cache line
+		const size_t perLine = 64 / sizeof(Atom);
+		stride = (n + perLine - 1) / perLine * perLine;
+		size_t bytes = size_t(n) * stride * sizeof(Atom);
+#endif
+
+		const size_t hugePageSize = 2 * 1024 * 1024;
+		size_t alignment = hugePages ? hugePageSize : 64;
+		if ( hugePages ) { bytes = (bytes + hugePageSize - 1) / hugePageSize * hugePageSize; }
+
+		void* ptr = NULL;
+		if ( posix_memalign(&ptr, alignment, bytes) != 0 )
+		    {
+			throw std::runtime_error("TSPLibGraph: not enough memory for the distance matrix");
+		    }
+
+#ifdef MADV_HUGEPAGE
+		if ( hugePages ) { madvise(ptr, bytes, MADV_HUGEPAGE); }
+#endif
+
+		dist = static_cast<Atom*>(ptr);
+	    }
+
+	    static inline Atom* row(unsigned i)
+	    {
+#if defined(TSPLIB_DISTANCE_TRIANGULAR)
+		return dist + rows[i];
+#else
+		return dist + i * stride;
+#endif
+	    }
+
+	    static inline void set(unsigned i, unsigned j, double d)
+	    {
+#if defined(TSPLIB_DISTANCE_INT)
+		d = std::floor(d + 0.5);
+#endif
+#if defined(TSPLIB_DISTANCE_TRIANGULAR)
+		if ( i > j ) { unsigned tmp = i; i = j; j = tmp; }
+		dist[ rows[i] + j ] = Atom(d);
+#else
+		dist[ i * stride + j ] = Atom(d);
+		dist[ j * stride + i ] = Atom(d);
+#endif
+	    }
+
+	    /*
+	     * Distance functions of TSPLIB, the coordinates of GEO instances
+	     * being already converted in radians.
+	     */
+
+	    struct Euc2D
+	    {
+		static inline double d(double xi, double yi, double xj, double yj)
+		{
+		    double dx = xi - xj, dy = yi - yj;
+		    return std::floor( std::sqrt(dx*dx + dy*dy) + 0.5 );
+		}
+	    };
+
+	    struct Ceil2D
+	    {
+		static inline double d(double xi, double yi, double xj, double yj)
+		{
+		    double dx = xi - xj, dy = yi - yj;
+		    return std::ceil( std::sqrt(dx*dx + dy*dy) );
+		}
+	    };
+
+	    struct Att
+	    {
+		static inline double d(double xi, double yi, double xj, double yj)
+		{
+		    double dx = xi - xj, dy = yi - yj;
+		    double rij = std::sqrt( (dx*dx + dy*dy) / 10.0 );
+		    double tij = std::floor(rij + 0.5);
+		    return tij < rij ? tij + 1 : tij;
+		}
+	    };
+
+	    struct Geo
+	    {
+		static inline double d(double xi, double yi, double xj, double yj)
+		{
+		    const double RRR = 6378.388;
+		    double q1 = std::cos(yi - yj);
+		    double q2 = std::cos(xi - xj);
+		    double q3 = std::cos(xi + xj);
+		    return (int)( RRR * std::acos( 0.5 * ( (1.0 + q1) * q2 - (1.0 - q1) * q3 ) ) + 1.0 );
+		}
+	    };
+
+	    static std::vector<double> X, Y; // Coordinates
+	    static EdgeWeightType metric = EUC_2D;
+	    static unsigned generation = 0; // incremented at each load, invalidates the caches
+
+	    /**
+	     * Fills the matrix from the coordinates.
+	     *
+	     * Rows are independent so they are shared between the OpenMP threads,
+	     * which also places the pages close to the threads using them first.
+	     * The inner loop has no dependency and is left to the vectorizer.
+	     */
+	    template <typename Metric>
+	    static void fill()
+	    {
+		const int N = n;
+		const double* x = &X[0];
+		const double* y = &Y[0];
+
+#pragma omp parallel for schedule(dynamic, 16)
+		for (int i = 0; i < N; ++i)
+		    {
+#if defined(TSPLIB_DISTANCE_TRIANGULAR)
+			const int first = i;
+#else
+			const int first = 0;
+#endif
+			Atom* r = row(i);
+			const double xi = x[i];
+			const double yi = y[i];
 
-	    unsigned size() { return dist.size(); }
-	    double distance(unsigned __from, unsigned __to) { return dist[__from][__to]; }
+			for (int j = first; j < N; ++j)
+			    {
+				r[j] = Atom( Metric::d(xi, yi, x[j], y[j]) );
+			    }
 
-	    void load(std::string filename)
+			r[i] = 0;
+		    }
+	    }
+
+	    template <typename Metric>
+	    static void batch(unsigned from, const unsigned* to, unsigned count, double* out)
+	    {
+		const double* x = &X[0];
+		const double* y = &Y[0];
+		const double xi = x[from];
+		const double yi = y[from];
+
+		for (unsigned k = 0; k < count; ++k)
+		    {
+			double d = Metric::d(xi, yi, x[to[k]], y[to[k]]);
+			out[k] = to[k] == from ? 0 : d;
+		    }
+	    }
+
+	    /*
+	     * Per-thread direct-mapped cache of GEO distances in matrix-free mode,
+	     * three cosines and one arccosine being much more expensive than a
+	     * lookup. A route or a local search keeps asking for the same few
+	     * neighbours of each city so most of the requests hit.
+	     */
+
+#ifndef TSPLIB_CACHE_BITS
+#define TSPLIB_CACHE_BITS 15
+#endif
+
+	    struct CacheEntry
+	    {
+		unsigned from, to;
+		double d;
+	    };
+
+#if __cplusplus > 199711L
+	    static thread_local std::vector<CacheEntry> cache;
+	    static thread_local unsigned cacheGeneration = 0;
+#else
+	    // never freed, there is one per island thread living as long as the process
+	    static __thread CacheEntry* cache = NULL;
+	    static __thread unsigned cacheGeneration = 0;
+#endif
+
+	    static double cachedGeo(unsigned from, unsigned to)
+	    {
+		const unsigned size = 1u << TSPLIB_CACHE_BITS;
+
+		if ( cacheGeneration != generation )
+		    {
+#if __cplusplus > 199711L
+			cache.resize(size);
+#else
+			if ( !cache ) { cache = new CacheEntry[size]; }
+#endif
+			for (unsigned k = 0; k < size; ++k) { cache[k].from = cache[k].to = unsigned(-1); }
+			cacheGeneration = generation;
+		    }
+
+		if ( from > to ) { unsigned tmp = from; from = to; to = tmp; }
+
+		unsigned h = ( (from * 2654435761u) ^ to ) * 2246822519u >> (32 - TSPLIB_CACHE_BITS);
+		CacheEntry& e = cache[h];
+
+		if ( e.from != from || e.to != to )
+		    {
+			e.from = from;
+			e.to = to;
+			e.d = Geo::d(X[from], Y[from], X[to], Y[to]);
+		    }
+
+		return e.d;
+	    }
+
+	    double detail::compute(unsigned __from, unsigned __to)
+	    {
+		if ( __from == __to ) { return 0; }
+
+		const double* x = &X[0];
+		const double* y = &Y[0];
+
+		switch (metric)
+		    {
+		    case EUC_2D: return Euc2D::d(x[__from], y[__from], x[__to], y[__to]);
+		    case CEIL_2D: return Ceil2D::d(x[__from], y[__from], x[__to], y[__to]);
+		    case ATT: return Att::d(x[__from], y[__from], x[__to], y[__to]);
+		    case GEO: return cachedGeo(__from, __to);
+		    default: return 0;
+		    }
+	    }
+
+	    void distances(unsigned __from, const unsigned* __to, unsigned __count, double* __out)
+	    {
+		if ( dist )
+		    {
+#if defined(TSPLIB_DISTANCE_TRIANGULAR)
+			for (unsigned k = 0; k < __count; ++k) { __out[k] = distance(__from, __to[k]); }
+#else
+			// a gather in one row of the matrix
+			const Atom* row = dist + size_t(__from) * stride;
+			for (unsigned k = 0; k < __count; ++k) { __out[k] = row[ __to[k] ]; }
+#endif
+			return;
+		    }
+
+		switch (metric)
+		    {
+		    case EUC_2D: batch<Euc2D>(__from, __to, __count, __out); break;
+		    case CEIL_2D: batch<Ceil2D>(__from, __to, __count, __out); break;
+		    case ATT: batch<Att>(__from, __to, __count, __out); break;
+		    case GEO: batch<Geo>(__from, __to, __count, __out); break;
+		    default: break;
+		    }
+	    }
+
+	    bool matrixFree() { return n && !dist; }
+
+	    std::string edgeWeightType()
+	    {
+		const char* names[] = { "EUC_2D", "CEIL_2D", "GEO", "ATT", "EXPLICIT" };
+		return names[metric];
+	    }
+
+	    bool coordinates(const double*& __x, const double*& __y)
+	    {
+		if ( X.empty() ) { return false; }
+		__x = &X[0];
+		__y = &Y[0];
+		return true;
+	    }
+
+	    static bool hugePagesOption = false;
+	    static bool matrixFreeOption = false;
+
+	    static void loadCoordinates(std::istream& f, unsigned dimension, bool indexed, EdgeWeightType type)
+	    {
+		if ( type == EXPLICIT )
+		    {
+			throw std::runtime_error("TSPLibGraph: coordinates given for an EXPLICIT instance");
+		    }
+
+		std::vector<double> x(dimension), y(dimension);
+		for (unsigned i = 0; i < dimension; ++i)
+		    {
+			unsigned id = i + 1;
+			if ( indexed ) { f >> id; }
+			if ( !f || id < 1 || id > dimension || !(f >> x[id-1] >> y[id-1]) )
+			    {
+				throw std::runtime_error("TSPLibGraph: malformed coordinates section");
+			    }
+		    }
+
+		if ( type == GEO )
+		    {
+			// latitudes and longitudes in radians
+			const double PI = 3.141592;
+			for (unsigned i = 0; i < dimension; ++i)
+			    {
+				double deg = (int)x[i];
+				x[i] = PI * (deg + 5.0 * (x[i] - deg) / 3.0) / 180.0;
+				deg = (int)y[i];
+				y[i] = PI * (deg + 5.0 * (y[i] - deg) / 3.0) / 180.0;
+			    }
+		    }
+
+		X.swap(x);
+		Y.swap(y);
+		metric = type;
+
+		if ( matrixFreeOption )
+		    {
+			release();
+			n = dimension;
+			return;
+		    }
+
+		allocate(dimension, hugePagesOption);
+
+		switch (type)
+		    {
+		    case EUC_2D: fill<Euc2D>(); break;
+		    case CEIL_2D: fill<Ceil2D>(); break;
+		    case ATT: fill<Att>(); break;
+		    case GEO: fill<Geo>(); break;
+		    default: break;
+		    }
+	    }
+
+	    static void loadExplicit(std::istream& f, std::string format)
+	    {
+		// a symmetric matrix read by columns is the same as the other triangle read by rows
+		if ( format == "UPPER_COL" ) { format = "LOWER_ROW"; }
+		else if ( format == "LOWER_COL" ) { format = "UPPER_ROW"; }
+		else if ( format == "UPPER_DIAG_COL" ) { format = "LOWER_DIAG_ROW"; }
+		else if ( format == "LOWER_DIAG_COL" ) { format = "UPPER_DIAG_ROW"; }
+
+		bool full = format == "FULL_MATRIX";
+		bool upper = format == "UPPER_ROW" || format == "UPPER_DIAG_ROW";
+		bool lower = format == "LOWER_ROW" || format == "LOWER_DIAG_ROW";
+		bool diag = format == "UPPER_DIAG_ROW" || format == "LOWER_DIAG_ROW";
+
+		if ( !full && !upper && !lower )
+		    {
+			throw std::runtime_error("TSPLibGraph: unsupported edge weight format " + format);
+		    }
+
+		for (unsigned i = 0; i < n; ++i)
+		    {
+			unsigned first = full || lower ? 0 : ( diag ? i : i + 1 );
+			unsigned last = full || upper ? n : ( diag ? i + 1 : i );
+
+			for (unsigned j = first; j < last; ++j)
+			    {
+				double d;
+				if ( !(f >> d) )
+				    {
+					throw std::runtime_error("TSPLibGraph: malformed edge weight section");
+				    }
+				set(i, j, d);
+			    }
+
+			set(i, i, 0);
+		    }
+	    }
+
+	    static void loadXML(const std::string& filename)
 	    {
 		using boost::property_tree::ptree;
 		ptree pt;
 
 		read_xml(filename, pt);
 
-		BOOST_FOREACH(ptree::value_type const& vertex, pt.get_child ("travellingSalesmanProblemInstance.graph"))
+		const ptree& graph = pt.get_child("travellingSalesmanProblemInstance.graph");
+		X.clear();
+		Y.clear();
+		metric = EXPLICIT;
+		allocate(graph.size(), hugePagesOption);
+
+		unsigned i = 0;
+		BOOST_FOREACH(ptree::value_type const& vertex, graph)
 		    {
-			std::map< unsigned, double > vertex_dist;
+			set(i, i, 0);
 			BOOST_FOREACH(ptree::value_type const& edge, vertex.second)
 			    {
-				vertex_dist[ edge.second.get<unsigned>("") ] = edge.second.get<double>("<xmlattr>.cost");
+				if ( edge.first != "edge" ) { continue; }
+				set( i, edge.second.get<unsigned>(""), edge.second.get<double>("<xmlattr>.cost") );
+			    }
+			++i;
+		    }
+	    }
+
+	    static void loadTSPLib(std::istream& f)
+	    {
+		std::string type = "EUC_2D";
+		std::string format = "FULL_MATRIX";
+		unsigned dimension = 0;
+		std::string line;
+
+		while ( std::getline(f, line) )
+		    {
+			std::string key = line, value;
+			size_t colon = line.find(':');
+			if ( colon != std::string::npos )
+			    {
+				key = line.substr(0, colon);
+				value = line.substr(colon + 1);
+			    }
+			boost::trim(key);
+			boost::trim(value);
+
+			if ( key == "DIMENSION" ) { dimension = atoi(value.c_str()); }
+			else if ( key == "EDGE_WEIGHT_TYPE" ) { type = value; }
+			else if ( key == "EDGE_WEIGHT_FORMAT" ) { format = value; }
+			else if ( key == "TYPE" && value != "TSP" )
+			    {
+				throw std::runtime_error("TSPLibGraph: only symmetric TSP instances are supported, not " + value);
 			    }
-			dist.push_back( vertex_dist );
+			else if ( key == "NODE_COORD_SECTION" || key == "EDGE_WEIGHT_SECTION" )
+			    {
+				if ( !dimension )
+				    {
+					throw std::runtime_error("TSPLibGraph: DIMENSION is missing before " + key);
+				    }
+
+				if ( key == "NODE_COORD_SECTION" )
+				    {
+					loadCoordinates( f, dimension, true, edgeWeightTypeFromString(type) );
+				    }
+				else
+				    {
+					// the weights are the matrix, there is no matrix-free mode for them
+					X.clear();
+					Y.clear();
+					metric = EXPLICIT;
+					allocate(dimension, hugePagesOption);
+					loadExplicit( f, format );
+				    }
+				return;
+			    }
+			else if ( key == "EOF" ) { break; }
+		    }
+
+		throw std::runtime_error("TSPLibGraph: no NODE_COORD_SECTION nor EDGE_WEIGHT_SECTION found");
+	    }
+
+	    void load(std::string filename, std::string edgeWeightType /*= "EUC_2D"*/, bool hugePages /*= false*/, bool matrixFree /*= false*/)
+	    {
+		hugePagesOption = hugePages;
+		matrixFreeOption = matrixFree;
+		++generation;
+
+		if ( boost::ends_with(filename, ".xml") )
+		    {
+			loadXML(filename);
+			return;
+		    }
+
+		std::ifstream f( filename.c_str() );
+
+		if ( !f )
+		    {
+			throw std::runtime_error("TSPLibGraph: " + filename + " doesn't exist");
 		    }
+
+		f >> std::ws;
+		int c = f.peek();
+
+		if ( isdigit(c) )
+		    {
+			// bare format: the number of cities followed by their coordinates
+			unsigned dimension;
+			f >> dimension;
+			loadCoordinates( f, dimension, false, edgeWeightTypeFromString(edgeWeightType) );
+			return;
+		    }
+
+		loadTSPLib(f);
 	    }
 	}
 
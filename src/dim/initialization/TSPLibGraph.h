@@ -20,24 +20,110 @@
 #ifndef _INITIALIZATION_TSPLIBGRAPH_H_
 #define _INITIALIZATION_TSPLIBGRAPH_H_
 
-#include <boost/property_tree/ptree.hpp>
-#include <boost/property_tree/xml_parser.hpp>
-#include <boost/foreach.hpp>
+#include <string>
 #include <vector>
 #include <map>
+#include <cstddef>
+
+#if defined(TSPLIB_DISTANCE_INT)
+#include <boost/cstdint.hpp>
+#endif
 
 namespace dim
 {
     namespace initialization
     {
 
+	/**
+	 * Distance matrix of a symmetric TSP instance.
+	 *
+	 * The distances are stored in one contiguous aligned block, either as a
+	 * full row-major matrix with 64-bytes aligned rows (default) or as an
+	 * upper triangle when TSPLIB_DISTANCE_TRIANGULAR is defined, which
+	 * halves the memory for the largest instances.
+	 *
+	 * The element type is double by default, float with
+	 * TSPLIB_DISTANCE_FLOAT or a 32 bits integer with TSPLIB_DISTANCE_INT.
+	 * Distances are always rounded as specified by TSPLIB so the three
+	 * types give the same tour lengths.
+	 *
+	 * Instances given by coordinates can also be loaded without matrix, the
+	 * distances being computed when needed (see load()).
+	 *
+	 * The supported files are:
+	 * - TSPLIB files with EUC_2D, CEIL_2D, GEO, ATT or EXPLICIT edge weights,
+	 * - the XML format of TSPLIB (*.xml),
+	 * - the bare "n\n x y\n ..." format of the files in application/TSP/benchs,
+	 *   in which case the edge weight type has to be given to load().
+	 */
 	namespace TSPLibGraph
 	{
-	    typedef std::vector< std::map< unsigned, double > > Distance;
+#if defined(TSPLIB_DISTANCE_INT)
+	    typedef boost::int32_t Atom;
+#elif defined(TSPLIB_DISTANCE_FLOAT)
+	    typedef float Atom;
+#else
+	    typedef double Atom;
+#endif
+
+	    namespace detail
+	    {
+		extern Atom* dist;
+		extern size_t stride;
+		extern unsigned n;
+#if defined(TSPLIB_DISTANCE_TRIANGULAR)
+		extern size_t* rows; // rows[i] + j is the index of (i,j) for i <= j
+#endif
+
+		/// distance computed from the coordinates in matrix-free mode
+		double compute(unsigned __from, unsigned __to);
+	    }
+
+	    inline unsigned size() { return detail::n; }
+
+	    inline double distance(unsigned __from, unsigned __to)
+	    {
+		if ( !detail::dist ) { return detail::compute(__from, __to); }
+
+#if defined(TSPLIB_DISTANCE_TRIANGULAR)
+		if ( __from > __to ) { unsigned tmp = __from; __from = __to; __to = tmp; }
+		return detail::dist[ detail::rows[__from] + __to ];
+#else
+		return detail::dist[ __from * detail::stride + __to ];
+#endif
+	    }
+
+	    /**
+	     * Distances from one city to many others, out[k] = distance(from, to[k]).
+	     *
+	     * In matrix-free mode the whole batch is computed by one vectorizable loop.
+	     */
+	    void distances(unsigned __from, const unsigned* __to, unsigned __count, double* __out);
+
+	    /// true if the distances are computed on the fly from the coordinates
+	    bool matrixFree();
+
+	    /// EUC_2D, CEIL_2D, GEO, ATT or EXPLICIT for instances given by their edge weights
+	    std::string edgeWeightType();
+
+	    /**
+	     * Coordinates of the cities (radians for GEO instances).
+	     *
+	     * @return false if the instance is given by its edge weights
+	     */
+	    bool coordinates(const double*& __x, const double*& __y);
 
-	    unsigned size();
-	    double distance(unsigned __from, unsigned __to);
-	    void load(std::string filename);
+	    /**
+	     * Loads an instance and builds its distance matrix.
+	     *
+	     * @param filename TSPLIB, XML or bare coordinates file
+	     * @param edgeWeightType only used by the bare format: EUC_2D, CEIL_2D, GEO or ATT
+	     * @param hugePages back the matrix with transparent huge pages when available
+	     * @param matrixFree keep only the coordinates of the cities and compute the
+	     *        distances on the fly, for instances whose matrix does not fit in
+	     *        memory. Explicit and XML instances always use a matrix.
+	     */
+	    void load(std::string filename, std::string edgeWeightType = "EUC_2D", bool hugePages = false, bool matrixFree = false);
 	}
 
     }
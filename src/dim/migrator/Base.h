@@ -35,6 +35,18 @@ namespace dim
 	    virtual void firstCall(core::Pop<EOT>&, core::IslandData<EOT>&) {}
 	    virtual void lastCall(core::Pop<EOT>&, core::IslandData<EOT>&) {}
 	    virtual void addTo(core::ThreadsRunner<EOT>&) {}
+
+	    /**
+	     * Split migration of the overlapped loop of algo::Easy: post()
+	     * starts sending the emigrants of pop, which keeps its residents,
+	     * and wait() completes it, the immigrants being given in arrivals.
+	     * By default post() migrates at once and wait() gets nothing.
+	     */
+	    virtual void post(core::Pop<EOT>& pop, core::IslandData<EOT>& data) { (*this)(pop, data); }
+	    virtual void wait(core::Pop<EOT>& /*arrivals*/, core::IslandData<EOT>& /*data*/) {}
+
+	    /// true if post() and wait() split the migration, false if post() migrates at once
+	    virtual bool split() const { return false; }
 	};
     }
 }
@@ -33,6 +33,9 @@
 #include <fstream>
 
 #include "Base.h"
+#include <dim/core/MigrantPool.h>
+#include <dim/core/ProgressEngine.h>
+#include <dim/core/Collective.h>
 #include <dim/utils/Measure.h>
 
 #include <boost/utility/identity_type.hpp>
@@ -67,7 +70,7 @@ namespace dim
 	    class Easy : public Base<EOT>
 	    {
 	    public:
-		Easy(std::vector< core::Pop<EOT>* >& islandPop, std::vector< core::IslandData<EOT>* >& islandData) : _islandPop(islandPop), _islandData(islandData) {}
+		Easy(std::vector< core::Pop<EOT>* >& islandPop, std::vector< core::IslandData<EOT>* >& islandData) : _islandPop(islandPop), _islandData(islandData), _pool(core::MigrantPool<EOT>::shared()) {}
 
 		virtual void firstCall(core::Pop<EOT>& pop, core::IslandData<EOT>& data)
 		{
@@ -130,7 +133,7 @@ namespace dim
 						       *************/
 
 						      double s = 0;
-						      int r = rng.rand() % 1000 + 1;
+						      int r = data.random.random(1000) + 1;
 
 						      size_t j;
 						      for ( j = 0; j < this->size() && r > s; ++j )
@@ -142,10 +145,11 @@ namespace dim
 						      DO_MEASURE(
 								 ++outputSizes[j];
 #ifdef TRACE
-								 _of << ind.getLastFitnesses().size() << " ";
+								 _of << ind.getLastIslandsSize() << " ";
 #endif // !TRACE
 
-								 _islandData[j]->migratorReceivingQueue.push(MOVE(ind), this->rank());
+								 // only the handle travels, the genes stay in the pool
+								 _islandData[j]->migrantHandles.push(_pool.put(ind), this->rank());
 
 								 , _measureFiles, "migrate_push");
 						  }
@@ -167,17 +171,15 @@ namespace dim
 
 			       DO_MEASURE(
 					  size_t inputSize = 0;
+					  typename core::MigrantPool<EOT>::Handle handle;
+					  size_t from;
+					  double waited;
 
-					  // size_t size = data.migratorReceivingQueue.size();
-					  // for (int k = 0; k < size; ++k);
-					  while ( !data.migratorReceivingQueue.empty() )
+					  while ( data.migrantHandles.try_pop(handle, waited, from) )
 					      {
-						  AUTO(typename BOOST_IDENTITY_TYPE((std_or_boost::tuple<EOT, double, size_t>))) imm = data.migratorReceivingQueue.pop();
-						  AUTO(EOT) ind = MOVE(std_or_boost::get<0>(imm));
-						  AUTO(double) time = std_or_boost::get<1>(imm);
-
-						  ind.receivedTime = time;
-						  pop.push_back( MOVE(ind) );
+						  pop.push_back( EOT() );
+						  _pool.take(handle, pop.back());
+						  pop.back().receivedTime = waited;
 						  ++inputSize;
 					      }
 
@@ -190,6 +192,7 @@ namespace dim
 	    private:
 		std::vector< core::Pop<EOT>* >& _islandPop;
 		std::vector< core::IslandData<EOT>* >& _islandData;
+		core::MigrantPool<EOT>& _pool;
 
 #ifdef TRACE
 		std::ofstream _of;
@@ -218,97 +221,91 @@ namespace dim
 
 		void operator()(core::Pop<EOT>& pop, core::IslandData<EOT>& data)
 		{
-		    std::vector< boost::mpi::request > reqs;
+		    post(pop, data);
 
-		    {
-			/********************
-			 * Send individuals *
-			 ********************/
+		    core::Pop<EOT> arrivals;
+		    wait(arrivals, data);
 
-			std::vector< size_t > outputSizes( this->size(), 0 );
-			std::vector< core::Pop<EOT> > pops( this->size() );
+		    /*********************
+		     * Update population *
+		     *********************/
 
-			for (size_t i = 0; i < pop.size(); ++i)
-			    {
-				EOT& ind = pop[i];
+		    for (size_t i = 0; i < arrivals.size(); ++i)
+			{
+			    pop.push_back( MOVE(arrivals[i]) );
+			}
 
-				/*************
-				 * Selection *
-				 *************/
+		    pop.setInputSize( arrivals.size() );
+		}
 
-				double s = 0;
-				int r = rng.rand() % 1000 + 1;
+		/// starts sending the emigrants, pop keeping the residents only
+		virtual void post(core::Pop<EOT>& pop, core::IslandData<EOT>& data)
+		{
+		    /********************
+		     * Send individuals *
+		     ********************/
 
-				size_t j;
-				for ( j = 0; j < this->size() && r > s; ++j )
-				    {
-					s += data.proba[j];
-				    }
-				--j;
+		    std::vector< size_t > outputSizes( this->size(), 0 );
+		    std::vector< core::Pop<EOT> > out( this->size() );
 
-				++outputSizes[j];
-				pops[j].push_back(ind);
-			    }
+		    for (size_t i = 0; i < pop.size(); ++i)
+			{
+			    EOT& ind = pop[i];
 
-			pop.clear();
+			    /*************
+			     * Selection *
+			     *************/
 
-			pop.setOutputSizes( outputSizes );
-			pop.setOutputSize( std::accumulate(outputSizes.begin(), outputSizes.end(), 0) );
+			    double s = 0;
+			    int r = data.random.random(1000) + 1;
 
-			for ( size_t i = 0; i < this->size(); ++i )
-			    {
-				if (i == this->rank()) { continue; }
-				reqs.push_back( this->world().isend( i, this->tag(), pops[i] ) );
-			    }
+			    size_t j;
+			    for ( j = 0; j < this->size() && r > s; ++j )
+				{
+				    s += data.proba[j];
+				}
+			    --j;
 
-			for (size_t i = 0; i < pops[this->rank()].size(); ++i)
-			    {
-				EOT& ind = pops[this->rank()][i];
-				pop.push_back( ind );
-			    }
-		    }
+			    ++outputSizes[j];
+			    out[j].push_back(ind);
+			}
 
-		    std::vector< core::Pop<EOT> > pops( this->size() );
+		    pop.clear();
 
-		    /****************************************
-		     * Receive individuals from all islands *
-		     ****************************************/
-		    {
-			for (size_t i = 0; i < this->size(); ++i)
-			    {
-				if (i == this->rank()) { continue; }
-				reqs.push_back( this->world().irecv( i, this->tag(), pops[i] ) );
-			    }
-		    }
+		    pop.setOutputSizes( outputSizes );
+		    pop.setOutputSize( std::accumulate(outputSizes.begin(), outputSizes.end(), 0) );
 
-		    /****************************
-		     * Process all MPI requests *
-		     ****************************/
+		    for (size_t i = 0; i < out[this->rank()].size(); ++i)
+			{
+			    pop.push_back( out[this->rank()][i] );
+			}
 
-		    boost::mpi::wait_all( reqs.begin(), reqs.end() );
+		    // serialized at once, out is not needed by the exchange in flight
+		    core::Collective<EOT>::shared().postMigration( out );
+		}
 
-		    /*********************
-		     * Update population *
-		     *********************/
-		    {
-			size_t inputSize = 0;
+		virtual bool split() const { return true; }
 
-			for (size_t i = 0; i < this->size(); ++i)
-			    {
-				if (i == this->rank()) { continue; }
+		/// completes the migration started by post(), arrivals getting the individuals received from the other islands
+		virtual void wait(core::Pop<EOT>& arrivals, core::IslandData<EOT>& /*data*/)
+		{
+		    /****************************************
+		     * Receive individuals from all islands *
+		     ****************************************/
 
-				core::Pop<EOT>& newpop = pops[i];
-				for (size_t j = 0; j < newpop.size(); ++j)
-				    {
-					EOT& ind = newpop[j];
-					pop.push_back( ind );
-				    }
+		    std::vector< core::Pop<EOT> > in;
+		    core::Collective<EOT>::shared().waitMigration( in );
 
-				inputSize += newpop.size();
-			    }
+		    for (size_t i = 0; i < this->size(); ++i)
+			{
+			    if (i == this->rank()) { continue; }
 
-			pop.setInputSize( inputSize );
-		    }
+			    core::Pop<EOT>& newpop = in[i];
+			    for (size_t j = 0; j < newpop.size(); ++j)
+				{
+				    arrivals.push_back( MOVE(newpop[j]) );
+				}
+			}
 		}
 
 	    private:
@@ -327,15 +324,6 @@ namespace dim
 	    public:
 		Easy(size_t nmigrations = 1) : _nmigrations(nmigrations) {}
 
-		~Easy()
-		{
-		    for (size_t i = 0; i < this->_senders.size(); ++i)
-			{
-			    delete _senders[i];
-			    delete _receivers[i];
-			}
-		}
-
 		virtual void firstCall(core::Pop<EOT>& pop, core::IslandData<EOT>& data)
 		{
 #ifdef TRACE
@@ -370,7 +358,7 @@ namespace dim
 			     *************/
 
 			    double s = 0;
-			    int r = rng.rand() % 1000 + 1;
+			    int r = data.random.random(1000) + 1;
 
 			    size_t j;
 			    for ( j = 0; j < this->size() && r > s; ++j )
@@ -390,6 +378,9 @@ namespace dim
 			    data.migratorSendingQueue.push( ind, j );
 			}
 
+		    // end of the generation, the migrants leave with the feedbacks queued before them
+		    core::ProgressEngine<EOT>::shared().flush();
+
 		    pop.clear();
 
 		    pop.setOutputSizes( outputSizes );
@@ -404,84 +395,36 @@ namespace dim
 		    // a loop just in case we want more than 1 individual per generation coming to island
 
 		    // waiting until the queue is fulfilled
-		    while ( data.migratorReceivingQueue.empty() ) {}
+		    data.migratorReceivingQueue.wait();
 
 		    size_t size = data.migratorReceivingQueue.size();
 		    if ( _nmigrations && _nmigrations < size ) { size = _nmigrations; }
 
 		    for (int k = 0; k < size; ++k)
 			{
-			    // This special pop function is waiting while the queue of individual is empty.
-			    AUTO(typename BOOST_IDENTITY_TYPE((std_or_boost::tuple<EOT, double, size_t>))) imm = data.migratorReceivingQueue.pop(true);
-			    AUTO(EOT) ind = std_or_boost::get<0>(imm);
-			    AUTO(double) time = std_or_boost::get<1>(imm);
+			    EOT ind;
+			    double time;
+			    size_t from;
+
+			    // the individual may still be half-linked by its producer
+			    while ( !data.migratorReceivingQueue.try_pop(ind, time, from) ) {}
 
 			    ind.receivedTime = time;
-			    pop.push_back( ind );
+			    pop.push_back( MOVE(ind) );
 			    ++inputSize;
 			}
 
 		    pop.setInputSize( inputSize );
 		}
 
-		class Sender : public core::Thread<EOT>, public core::ParallelContext
-		{
-		public:
-		    Sender(size_t to, size_t tag = 0) : ParallelContext(tag), _to(to) {}
-
-		    void operator()(core::Pop<EOT>& /*pop*/, core::IslandData<EOT>& data)
-		    {
-			while (data.toContinue)
-			    {
-				// waiting until there is an individual in the queue
-				AUTO(typename BOOST_IDENTITY_TYPE((std_or_boost::tuple<EOT, double, size_t>))) em = data.migratorSendingQueue.pop( _to, true );
-				AUTO(EOT) ind = std_or_boost::get<0>(em);
-
-				this->world().send(_to, this->size() * ( this->rank() + _to ) + this->tag(), ind);
-			    }
-		    }
-
-		private:
-		    size_t _to;
-		};
-
-		class Receiver : public core::Thread<EOT>, public core::ParallelContext
-		{
-		public:
-		    Receiver(size_t from, size_t tag = 0) : ParallelContext(tag), _from(from) {}
-
-		    void operator()(core::Pop<EOT>& /*pop*/, core::IslandData<EOT>& data)
-		    {
-			while (data.toContinue)
-			    {
-				EOT ind;
-				this->world().recv(_from, this->size() * ( this->rank() + _from ) + this->tag(), ind);
-				data.migratorReceivingQueue.push( ind, _from );
-			    }
-		    }
-
-		private:
-		    size_t _from;
-		};
-
+		/// the messages are exchanged by the progress engine of the rank
 		virtual void addTo( core::ThreadsRunner<EOT>& tr )
 		{
-		    for (size_t i = 0; i < this->size(); ++i)
-			{
-			    if (i == this->rank()) { continue; }
-
-			    _senders.push_back( new Sender(i, this->tag()) );
-			    _receivers.push_back( new Receiver(i, this->tag()) );
-
-			    tr.add( _senders.back() );
-			    tr.add( _receivers.back() );
-			}
+		    core::ProgressEngine<EOT>::shared().serve( core::ProgressEngine<EOT>::Migrants, tr );
 		}
 
 	    private:
 		size_t _nmigrations;
-		std::vector<Sender*> _senders;
-		std::vector<Receiver*> _receivers;
 #ifdef TRACE
 		std::ofstream _of;
 #endif // !TRACE
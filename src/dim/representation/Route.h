@@ -47,11 +47,11 @@ namespace dim
     {
 
 #if __cplusplus > 199711L
-	template <typename FitT = float>
-	using Route = core::Vector<FitT, unsigned>; // [Fitness (- length), Gene (city)]
+	template <typename FitT = float, typename Alloc = core::memory::DefaultAllocator<unsigned>::type>
+	using Route = core::Vector<FitT, unsigned, Alloc>; // [Fitness (- length), Gene (city)]
 #else
-	template <typename FitT>
-	class Route : public core::Vector<FitT, unsigned> {};
+	template <typename FitT, typename Alloc = core::memory::DefaultAllocator<unsigned>::type>
+	class Route : public core::Vector<FitT, unsigned, Alloc> {};
 #endif
 
     } // !representation
@@ -0,0 +1,64 @@
+// -*- mode: c++; c-indent-level: 4; c++-member-init-indent: 8; comment-column: 35; -*-
+
+/* This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+ * Authors:
+ * Caner Candan <caner.candan@univ-angers.fr>
+ */
+#ifndef _REPRESENTATION_ROUTEINDEX_H_
+#define _REPRESENTATION_ROUTEINDEX_H_
+
+#include <vector>
+#include <algorithm>
+
+namespace dim
+{
+    namespace representation
+    {
+
+	/**
+	 * Position of every city in a route, the inverse of the permutation.
+	 *
+	 * It is built in O(n) and, after a move touching the positions between
+	 * two indices, only this range has to be refreshed.
+	 */
+	template <typename EOT>
+	class RouteIndex
+	{
+	public:
+	    RouteIndex() {}
+	    RouteIndex(const EOT& route) { (*this)(route); }
+
+	    void operator()(const EOT& route)
+	    {
+		_positions.resize(route.size());
+		for (size_t i = 0; i < route.size(); ++i) { _positions[ route[i] ] = i; }
+	    }
+
+	    /// refreshes the positions between i and j (both included)
+	    void update(const EOT& route, size_t i, size_t j)
+	    {
+		for (size_t k = std::min(i,j); k <= std::max(i,j); ++k) { _positions[ route[k] ] = k; }
+	    }
+
+	    inline size_t operator[](unsigned city) const { return _positions[city]; }
+
+	private:
+	    std::vector<size_t> _positions;
+	};
+
+    } // !representation
+} // !dim
+
+#endif // !_REPRESENTATION_ROUTEINDEX_H_
@@ -0,0 +1,321 @@
+// -*- mode: c++; c-indent-level: 4; c++-member-init-indent: 8; comment-column: 35; -*-
+
+/* This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+ * Authors:
+ * Caner Candan <caner.candan@univ-angers.fr>
+ */
+#ifndef _REPRESENTATION_TWOLEVELLIST_H_
+#define _REPRESENTATION_TWOLEVELLIST_H_
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+namespace dim
+{
+    namespace representation
+    {
+
+	/**
+	 * Tour of the cities 0..n-1 stored as a list of about sqrt(n) segments.
+	 *
+	 * Every segment keeps its cities in a small array and a reversed bit
+	 * telling in which direction the array has to be read. Reversing a path
+	 * of the tour splits at most two segments at its ends, then reverses the
+	 * order of the segments in between and flips their bits, so that a 2-opt
+	 * move costs O(sqrt(n)) instead of O(n). A path lying inside one segment
+	 * is reversed in place. Once the splits have doubled the number of
+	 * segments the list is rebuilt with balanced segments.
+	 *
+	 * When a distance function is given, the cost of the edge between two
+	 * consecutive cities of a segment array is cached. It does not depend on
+	 * the reversed bit so it survives the reversals and the splits.
+	 */
+	class TwoLevelList
+	{
+	public:
+	    typedef double (*Distance)(unsigned, unsigned);
+
+	    TwoLevelList(Distance distance = NULL) : _distance(distance), _n(0), _maxSegments(0) {}
+
+	    template <typename Route>
+	    void build(const Route& route)
+	    {
+		_n = route.size();
+
+		size_t group = std::max<size_t>(8, (size_t)std::sqrt((double)_n));
+		size_t count = (_n + group - 1) / group;
+		_maxSegments = 2 * count + 2;
+
+		_segments.assign(count, Segment());
+		_order.resize(count);
+		_rank.resize(count);
+		_segmentOf.resize(_n);
+		_index.resize(_n);
+		_link.assign(_n, 0);
+
+		for (size_t s = 0; s < count; ++s)
+		    {
+			Segment& seg = _segments[s];
+			seg.reversed = false;
+			seg.start = s * group;
+
+			for (size_t p = seg.start; p < std::min(_n, seg.start + group); ++p)
+			    {
+				unsigned c = route[p];
+				_segmentOf[c] = s;
+				_index[c] = seg.cities.size();
+				seg.cities.push_back(c);
+			    }
+
+			if ( _distance )
+			    {
+				for (size_t k = 0; k + 1 < seg.cities.size(); ++k)
+				    {
+					_link[ seg.cities[k] ] = _distance( seg.cities[k], seg.cities[k+1] );
+				    }
+			    }
+
+			_order[s] = s;
+			_rank[s] = s;
+		    }
+	    }
+
+	    /// writes the cities in tour order, starting from the first segment
+	    template <typename Route>
+	    void toRoute(Route& route) const
+	    {
+		route.resize(_n);
+		size_t p = 0;
+		for (size_t r = 0; r < _order.size(); ++r)
+		    {
+			for (size_t k = 0; k < _segments[ _order[r] ].cities.size(); ++k)
+			    {
+				route[p++] = element(_order[r], k);
+			    }
+		    }
+	    }
+
+	    inline size_t size() const { return _n; }
+	    inline size_t segments() const { return _order.size(); }
+
+	    /// position of a city in the tour
+	    inline size_t position(unsigned c) const { return _segments[ _segmentOf[c] ].start + offset(c); }
+
+	    inline unsigned next(unsigned c) const
+	    {
+		size_t s = _segmentOf[c];
+		size_t k = offset(c) + 1;
+		if ( k < _segments[s].cities.size() ) { return element(s, k); }
+
+		size_t r = _rank[s] + 1;
+		if ( r == _order.size() ) { r = 0; }
+		return element(_order[r], 0);
+	    }
+
+	    inline unsigned prev(unsigned c) const
+	    {
+		size_t s = _segmentOf[c];
+		size_t k = offset(c);
+		if ( k > 0 ) { return element(s, k - 1); }
+
+		size_t r = _rank[s] ? _rank[s] - 1 : _order.size() - 1;
+		return element(_order[r], _segments[ _order[r] ].cities.size() - 1);
+	    }
+
+	    /// cost of the edge between c and next(c), cached inside the segments
+	    inline double nextCost(unsigned c) const
+	    {
+		const Segment& seg = _segments[ _segmentOf[c] ];
+		size_t i = _index[c];
+
+		if ( !seg.reversed && i + 1 < seg.cities.size() ) { return _link[c]; }
+		if ( seg.reversed && i > 0 ) { return _link[ seg.cities[i - 1] ]; }
+
+		return _distance( c, next(c) );
+	    }
+
+	    /**
+	     * Reverses the path going forward from a to b, both included.
+	     *
+	     * If the path goes over the end of the tour, the rest of the tour is
+	     * reversed instead, which gives the same cycle.
+	     */
+	    void reverse(unsigned a, unsigned b)
+	    {
+		size_t i = position(a);
+		size_t j = position(b);
+
+		if ( i > j )
+		    {
+			if ( i == j + 1 ) { return; } // the whole tour
+			size_t tmp = i;
+			i = j + 1;
+			j = tmp - 1;
+		    }
+
+		if ( i == j ) { return; }
+
+		size_t s = _order[ segmentAt(i) ];
+		if ( j < _segments[s].start + _segments[s].cities.size() )
+		    {
+			reverseInside( s, i - _segments[s].start, j - _segments[s].start );
+			return;
+		    }
+
+		split(i);
+		if ( j + 1 < _n ) { split(j + 1); }
+
+		size_t first = segmentAt(i);
+		size_t last = segmentAt(j);
+
+		std::reverse( _order.begin() + first, _order.begin() + last + 1 );
+
+		size_t p = i;
+		for (size_t r = first; r <= last; ++r)
+		    {
+			Segment& seg = _segments[ _order[r] ];
+			seg.reversed = !seg.reversed;
+			seg.start = p;
+			p += seg.cities.size();
+			_rank[ _order[r] ] = r;
+		    }
+
+		if ( _order.size() > _maxSegments )
+		    {
+			std::vector<unsigned> tour;
+			toRoute(tour);
+			build(tour);
+		    }
+	    }
+
+	private:
+	    struct Segment
+	    {
+		std::vector<unsigned> cities;
+		bool reversed;
+		size_t start; // position of the first city in tour order
+	    };
+
+	    /// k-th city of a segment in tour order
+	    inline unsigned element(size_t s, size_t k) const
+	    {
+		const Segment& seg = _segments[s];
+		return seg.reversed ? seg.cities[ seg.cities.size() - 1 - k ] : seg.cities[k];
+	    }
+
+	    inline size_t offset(unsigned c) const
+	    {
+		const Segment& seg = _segments[ _segmentOf[c] ];
+		return seg.reversed ? seg.cities.size() - 1 - _index[c] : _index[c];
+	    }
+
+	    /// rank of the segment holding the position p
+	    size_t segmentAt(size_t p) const
+	    {
+		size_t lo = 0, hi = _order.size();
+		while ( hi - lo > 1 )
+		    {
+			size_t mid = (lo + hi) / 2;
+			if ( _segments[ _order[mid] ].start <= p ) { lo = mid; } else { hi = mid; }
+		    }
+		return lo;
+	    }
+
+	    /// makes a segment start at the position p
+	    void split(size_t p)
+	    {
+		size_t r = segmentAt(p);
+		size_t s = _order[r];
+		size_t k = p - _segments[s].start;
+		if ( !k ) { return; }
+
+		size_t id = _segments.size();
+		_segments.push_back( Segment() );
+
+		Segment& seg = _segments[s];
+		Segment& tail = _segments[id];
+		size_t m = seg.cities.size();
+
+		tail.reversed = seg.reversed;
+		tail.start = p;
+
+		if ( !seg.reversed )
+		    {
+			tail.cities.assign( seg.cities.begin() + k, seg.cities.end() );
+			seg.cities.resize(k);
+		    }
+		else
+		    {
+			// the end of the tour order is the beginning of the array
+			tail.cities.assign( seg.cities.begin(), seg.cities.begin() + (m - k) );
+			seg.cities.erase( seg.cities.begin(), seg.cities.begin() + (m - k) );
+			for (size_t t = 0; t < seg.cities.size(); ++t) { _index[ seg.cities[t] ] = t; }
+		    }
+
+		for (size_t t = 0; t < tail.cities.size(); ++t)
+		    {
+			_segmentOf[ tail.cities[t] ] = id;
+			_index[ tail.cities[t] ] = t;
+		    }
+
+		_order.insert( _order.begin() + r + 1, id );
+		_rank.push_back(0);
+		for (size_t t = r + 1; t < _order.size(); ++t) { _rank[ _order[t] ] = t; }
+	    }
+
+	    /// reverses the tour offsets k1..k2 of one segment in its array
+	    void reverseInside(size_t s, size_t k1, size_t k2)
+	    {
+		Segment& seg = _segments[s];
+		size_t m = seg.cities.size();
+		size_t lo = seg.reversed ? m - 1 - k2 : k1;
+		size_t hi = seg.reversed ? m - 1 - k1 : k2;
+
+		// the edges inside the range are kept, in the opposite order
+		std::vector<double> costs;
+		if ( _distance )
+		    {
+			for (size_t t = lo; t < hi; ++t) { costs.push_back( _link[ seg.cities[t] ] ); }
+		    }
+
+		std::reverse( seg.cities.begin() + lo, seg.cities.begin() + hi + 1 );
+		for (size_t t = lo; t <= hi; ++t) { _index[ seg.cities[t] ] = t; }
+
+		if ( _distance )
+		    {
+			for (size_t t = lo; t < hi; ++t) { _link[ seg.cities[t] ] = costs[ hi - 1 - t ]; }
+			if ( lo > 0 ) { _link[ seg.cities[lo - 1] ] = _distance( seg.cities[lo - 1], seg.cities[lo] ); }
+			if ( hi + 1 < m ) { _link[ seg.cities[hi] ] = _distance( seg.cities[hi], seg.cities[hi + 1] ); }
+		    }
+	    }
+
+	    Distance _distance;
+	    size_t _n;
+	    size_t _maxSegments;
+
+	    std::vector<Segment> _segments;
+	    std::vector<size_t> _order; // segments in tour order
+	    std::vector<size_t> _rank; // rank of every segment in _order
+	    std::vector<size_t> _segmentOf; // segment of every city
+	    std::vector<size_t> _index; // index of every city in the array of its segment
+	    std::vector<double> _link; // cost towards the next city of the array
+	};
+
+    } // !representation
+} // !dim
+
+#endif // !_REPRESENTATION_TWOLEVELLIST_H_
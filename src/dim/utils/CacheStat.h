@@ -0,0 +1,78 @@
+// -*- mode: c++; c-indent-level: 4; c++-member-init-indent: 8; comment-column: 35; -*-
+
+/* This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+ * Authors:
+ * Caner Candan <caner.candan@univ-angers.fr>
+ */
+
+#ifndef _UTILS_CACHESTAT_H_
+#define _UTILS_CACHESTAT_H_
+
+#include <dim/core/FitnessCache.h>
+
+#include "Stat.h"
+
+namespace dim
+{
+    namespace utils
+    {
+
+	/**
+	   Share of the lookups of a fitness cache which spared an evaluation,
+	   since its construction. A cache shared by islands gives the same
+	   value to each of them.
+
+	   @ingroup Stats
+	*/
+	template <typename EOT>
+	class CacheHitRate : public Stat<EOT, double>
+	{
+	public:
+	    CacheHitRate( core::FitnessCache<typename EOT::Fitness>& cache, std::string description = "CacheHitRate" )
+		: Stat<EOT, double>(0, description), _cache(cache) {}
+
+	    virtual void operator()(const core::Pop<EOT>&) { this->value() = _cache.hitRate(); }
+
+	    virtual std::string className(void) const { return "CacheHitRate"; }
+
+	private:
+	    core::FitnessCache<typename EOT::Fitness>& _cache;
+	};
+
+	/**
+	   Share of the lookups of a fitness cache which led to an evaluation,
+	   since its construction.
+
+	   @ingroup Stats
+	*/
+	template <typename EOT>
+	class CacheMissRate : public Stat<EOT, double>
+	{
+	public:
+	    CacheMissRate( core::FitnessCache<typename EOT::Fitness>& cache, std::string description = "CacheMissRate" )
+		: Stat<EOT, double>(0, description), _cache(cache) {}
+
+	    virtual void operator()(const core::Pop<EOT>&) { this->value() = _cache.missRate(); }
+
+	    virtual std::string className(void) const { return "CacheMissRate"; }
+
+	private:
+	    core::FitnessCache<typename EOT::Fitness>& _cache;
+	};
+
+    } // !utils
+} // !dim
+
+#endif // !_UTILS_CACHESTAT_H_
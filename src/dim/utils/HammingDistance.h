@@ -0,0 +1,45 @@
+// -*- mode: c++; c-indent-level: 4; c++-member-init-indent: 8; comment-column: 35; -*-
+
+/* This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+ * Authors:
+ * Caner Candan <caner.candan@univ-angers.fr>
+ */
+
+#ifndef _UTILS_HAMMINGDISTANCE_H_
+#define _UTILS_HAMMINGDISTANCE_H_
+
+#include <utils/eoDistance.h>
+#include <dim/core/PackedBit.h>
+
+namespace dim
+{
+    namespace utils
+    {
+
+	/// number of differing bits of two PackedBit, counted word by word (see core::PackedBit::hamming)
+	template < typename EOT >
+	class HammingDistance : public eoDistance<EOT>
+	{
+	public:
+	    double operator()(const EOT& _a, const EOT& _b)
+	    {
+		return _a.hamming(_b);
+	    }
+	};
+
+    } // !utils
+} // !dim
+
+#endif /* _UTILS_HAMMINGDISTANCE_H_ */
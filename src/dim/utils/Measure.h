@@ -37,9 +37,19 @@
 	*(measureFiles[name]) << elapsed << std::endl; measureFiles[name]->flush(); \
     }
 
+/// adds the microseconds taken by op to total
+# define DO_ACCUMULATE(op, total)					\
+    {									\
+	std_or_boost::chrono::time_point< std_or_boost::chrono::system_clock > start = std_or_boost::chrono::system_clock::now(); \
+	op;								\
+	std_or_boost::chrono::time_point< std_or_boost::chrono::system_clock > end = std_or_boost::chrono::system_clock::now();	\
+	total += std_or_boost::chrono::duration_cast<std_or_boost::chrono::microseconds>(end-start).count(); \
+    }
+
 #else
 
 # define DO_MEASURE(op, measureFiles, name) { op; }
+# define DO_ACCUMULATE(op, total) { op; }
 
 #endif // !MEASURE
 
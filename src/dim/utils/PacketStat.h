@@ -0,0 +1,78 @@
+// -*- mode: c++; c-indent-level: 4; c++-member-init-indent: 8; comment-column: 35; -*-
+
+/* This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+ * Authors:
+ * Caner Candan <caner.candan@univ-angers.fr>
+ */
+
+#ifndef _UTILS_PACKETSTAT_H_
+#define _UTILS_PACKETSTAT_H_
+
+#include <dim/core/ProgressEngine.h>
+
+#include "Stat.h"
+
+namespace dim
+{
+    namespace utils
+    {
+
+	/**
+	   Average number of migrants and feedbacks coalesced into the packets
+	   sent by a progress engine, since the start of the run.
+
+	   @ingroup Stats
+	*/
+	template <typename EOT>
+	class PacketSize : public Stat<EOT, double>
+	{
+	public:
+	    PacketSize( core::ProgressEngine<EOT>& engine, std::string description = "PacketSize" )
+		: Stat<EOT, double>(0, description), _engine(engine) {}
+
+	    virtual void operator()(const core::Pop<EOT>&) { this->value() = _engine.packetSize(); }
+
+	    virtual std::string className(void) const { return "PacketSize"; }
+
+	private:
+	    core::ProgressEngine<EOT>& _engine;
+	};
+
+	/**
+	   Average time in milliseconds a packet of a progress engine waits
+	   between the queueing of its first migrant or feedback and its
+	   sending, since the start of the run.
+
+	   @ingroup Stats
+	*/
+	template <typename EOT>
+	class FlushLatency : public Stat<EOT, double>
+	{
+	public:
+	    FlushLatency( core::ProgressEngine<EOT>& engine, std::string description = "FlushLatency" )
+		: Stat<EOT, double>(0, description), _engine(engine) {}
+
+	    virtual void operator()(const core::Pop<EOT>&) { this->value() = _engine.flushLatency(); }
+
+	    virtual std::string className(void) const { return "FlushLatency"; }
+
+	private:
+	    core::ProgressEngine<EOT>& _engine;
+	};
+
+    } // !utils
+} // !dim
+
+#endif // !_UTILS_PACKETSTAT_H_
@@ -76,7 +76,7 @@ namespace dim
 
 	    size_t operator() ( const core::Pop<EOT>& )
 	    {
-		return _data.migratorReceivingQueue.size();
+		return _data.migratorReceivingQueue.size() + _data.migrantHandles.size();
 	    }
 
 	private:
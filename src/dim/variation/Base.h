@@ -22,6 +22,8 @@
 
 #include <eoOp.h>
 #include <dim/utils/Measure.h>
+#include <dim/core/ThreadPool.h>
+#include <dim/core/Random.h>
 
 #include "PartialOp.h"
 #include "IncrementalEval.h"
@@ -36,7 +38,11 @@ namespace dim
 	class Base : public eoMonOp<EOT>
 	{
 	public:
-	    Base() : rank(-1), monitorPrefix("result") {}
+	    /**
+	     * @param pool if not null, the operators supporting it split their
+	     *        neighbourhood in chunks run by this pool
+	     */
+	    Base(core::ThreadPool* pool = NULL) : rank(-1), monitorPrefix("result"), _pool(pool) {}
 
 	    virtual void firstCall()
 	    {
@@ -48,6 +54,12 @@ namespace dim
 
 		ss.str(""); ss << this->monitorPrefix << ".variation_compute_delta.time." << this->rank;
 		_measureFiles["variation_compute_delta"] = new std::ofstream(ss.str().c_str());
+
+		if ( _pool )
+		    {
+			ss.str(""); ss << this->monitorPrefix << ".variation_efficiency." << this->rank;
+			_measureFiles["variation_efficiency"] = new std::ofstream(ss.str().c_str());
+		    }
 #endif // !MEASURE
 	    }
 
@@ -56,6 +68,39 @@ namespace dim
 	    std::string monitorPrefix;
 
 	protected:
+	    /// number of chunks to split work units in, 1 without pool
+	    size_t chunks(size_t work) const
+	    {
+		if ( !_pool ) { return 1; }
+		return std::max( size_t(1), std::min(work, 4 * _pool->concurrency()) );
+	    }
+
+	    /**
+	     * Runs task(chunk) for every chunk, by the pool if any.
+	     *
+	     * The parallel efficiency of each run is written in the
+	     * variation_efficiency file of the measurements.
+	     */
+	    template <typename Task>
+	    void run(Task& task, size_t chunks)
+	    {
+		if ( !_pool )
+		    {
+			for (size_t c = 0; c < chunks; ++c) { task(c); }
+			return;
+		    }
+
+#ifdef MEASURE
+		core::ThreadPool::Stats stats;
+		_pool->run(task, chunks, &stats);
+		*(_measureFiles["variation_efficiency"]) << stats.efficiency() << std::endl;
+#else
+		_pool->run(task, chunks);
+#endif // !MEASURE
+	    }
+
+	    core::ThreadPool* _pool;
+
 #ifdef MEASURE
 	    std::map<std::string, std::ofstream*> _measureFiles;
 #endif // !MEASURE
@@ -0,0 +1,151 @@
+// -*- mode: c++; c-indent-level: 4; c++-member-init-indent: 8; comment-column: 35; -*-
+
+/* This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+ * Authors:
+ * Caner Candan <caner.candan@univ-angers.fr>
+ */
+#ifndef _VARIATION_BESTIMPROVEMENTKERNEL_H_
+#define _VARIATION_BESTIMPROVEMENTKERNEL_H_
+
+#include <vector>
+
+#include <utils/eoParam.h>
+
+#include "Base.h"
+#include "Neighborhood.h"
+
+namespace dim
+{
+    namespace variation
+    {
+
+	/**
+	 * BestImprovementMutation with the move and the comparison given as
+	 * compile-time policies (see neighborhood), the deltas being computed
+	 * row by row. It selects the same neighbour as
+	 * BestImprovementMutation with the matching adapters.
+	 *
+	 * With a thread pool, the rows are split in chunks of consecutive rows
+	 * whose best neighbours are reduced in chunk order.
+	 *
+	 * Each delta computed is counted in the given parameter.
+	 */
+	template<typename EOT, typename Move, typename Comparison = neighborhood::Strict>
+	class BestImprovementKernel : public Base<EOT>
+	{
+	public:
+	    BestImprovementKernel(eoValueParam<unsigned int>& evaluations, core::ThreadPool* pool = NULL) : Base<EOT>(pool), _evaluations(evaluations) {}
+
+	    /// The class name.
+	    virtual std::string className() const { return "BestImprovementKernel"; }
+
+	    bool operator()(EOT& sol)
+	    {
+		// keep a best solution with its best delta
+		size_t best_i = 0;
+		size_t best_j = 0;
+		double best_delta = 0;
+
+		if ( sol.size() < 2 ) { return false; }
+
+		const size_t count = sol.size()-1;
+
+		neighborhood::Tour tour;
+		Scan scan(tour, count, this->chunks(count));
+
+		DO_MEASURE(
+
+			   tour.load(sol, Move::skips);
+
+			   DO_MEASURE( this->run(scan, scan.chunks());, this->_measureFiles, "variation_compute_delta" );
+
+			   for (size_t c = 0; c < scan.chunks(); ++c)
+			       {
+				   const typename Scan::Result& r = scan.results[c];
+
+				   if ( r.found && Comparison::better(r.delta, best_delta) )
+				       {
+					   best_delta = r.delta;
+					   best_i = r.i;
+					   best_j = r.j;
+				       }
+			       }
+
+			   _evaluations.value() += count * (count-1);
+
+			   , this->_measureFiles, "variation_total" );
+
+		// if the best delta is negative, we apply the operator to the solution with the best indicies
+		if ( best_delta < 0 )
+		    {
+			Move::apply(sol, best_i, best_j);
+			sol.unhash();
+			sol.fitness( sol.fitness() - best_delta );
+			return true;
+		    }
+
+		return false;
+	    }
+
+	private:
+	    /// best neighbour of each chunk of rows
+	    struct Scan
+	    {
+		struct Result
+		{
+		    Result() : found(false), delta(0), i(0), j(0) {}
+
+		    bool found;
+		    double delta;
+		    size_t i;
+		    size_t j;
+		};
+
+		Scan(const neighborhood::Tour& t, size_t n, size_t chunks) : tour(t), count(n), results(chunks) {}
+
+		inline size_t chunks() const { return results.size(); }
+
+		void operator()(size_t chunk)
+		{
+		    Result& r = results[chunk];
+		    neighborhood::Rows rows(count + 1);
+
+		    for (size_t i = chunk * count / chunks(); i < (chunk + 1) * count / chunks(); ++i)
+			{
+			    double delta;
+			    size_t j = neighborhood::bestOfRow<Move, Comparison>(tour, rows, i, 0, count, delta);
+
+			    if ( Comparison::better(delta, r.delta) )
+				{
+				    r.found = true;
+				    r.delta = delta;
+				    r.i = i;
+				    r.j = j;
+				}
+			}
+		}
+
+		const neighborhood::Tour& tour;
+		size_t count;
+		std::vector<Result> results;
+	    };
+
+	    eoValueParam<unsigned int>& _evaluations;
+	};
+
+    }
+}
+
+#endif /* _VARIATION_BESTIMPROVEMENTKERNEL_H_ */
@@ -21,23 +21,32 @@
 #define _VARIATION_BESTIMPROVEMENTMUTATION_H_
 
 #include "Base.h"
+#include "NeighborhoodScan.h"
 
 namespace dim
 {
     namespace variation
     {
 
+	/**
+	 * Applies the best neighbour of the whole neighbourhood.
+	 *
+	 * With a thread pool, the neighbourhood is split in chunks of rows and
+	 * the neighbour applied is still the one of the sequential scan.
+	 */
 	template<typename EOT>
 	class BestImprovementMutation : public Base<EOT>
 	{
 	public:
-	    BestImprovementMutation(PartialOp<EOT>& op, IncrementalEval<EOT>& eval, ComparisonOp<EOT>& comp) : _op(op), _eval(eval), _comp(comp) {}
+	    BestImprovementMutation(PartialOp<EOT>& op, IncrementalEval<EOT>& eval, ComparisonOp<EOT>& comp, core::ThreadPool* pool = NULL) : Base<EOT>(pool), _op(op), _eval(eval), _comp(comp) {}
 
 	    /// The class name.
 	    virtual std::string className() const { return "BestImprovementMutation"; }
 
 	    bool operator()(EOT& sol)
 	    {
+		if ( this->_pool ) { return parallel(sol); }
+
 		// keep a best solution with its best delta
 		size_t best_i = 0;
 		size_t best_j = 0;
@@ -72,7 +81,7 @@ namespace dim
 		if ( best_delta < 0 )
 		    {
 			_op(sol, best_i, best_j);
-			sol.fitness( sol.fitness() + best_delta );
+			sol.fitness( sol.fitness() - best_delta );
 			return true;
 		    }
 
@@ -80,6 +89,37 @@ namespace dim
 	    }
 
 	private:
+	    bool parallel(EOT& sol)
+	    {
+		size_t best_i = 0;
+		size_t best_j = 0;
+		typename EOT::Fitness best_delta = 0;
+
+		// the counter is not shared between threads, it is updated once the scan is over
+		IncrementalEvalCounter<EOT>* counter = dynamic_cast< IncrementalEvalCounter<EOT>* >(&_eval);
+
+		const size_t rows = sol.size()-1;
+		NeighborhoodScan<EOT> scan(sol, counter ? counter->eval() : _eval, _comp, 0, rows, rows, this->chunks(rows));
+
+		DO_MEASURE(
+
+			   this->run(scan, scan.chunks());
+			   scan.best(best_i, best_j, best_delta);
+
+			   , this->_measureFiles, "variation_total" );
+
+		if ( counter ) { counter->value() += scan.evaluations(); }
+
+		if ( best_delta < 0 )
+		    {
+			_op(sol, best_i, best_j);
+			sol.fitness( sol.fitness() - best_delta );
+			return true;
+		    }
+
+		return false;
+	    }
+
 	    PartialOp<EOT>& _op;
 	    IncrementalEval<EOT>& _eval;
 	    ComparisonOp<EOT>& _comp;
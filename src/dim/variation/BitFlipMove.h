@@ -0,0 +1,249 @@
+// -*- mode: c++; c-indent-level: 4; c++-member-init-indent: 8; comment-column: 35; -*-
+
+/* This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+ * Authors:
+ * Caner Candan <caner.candan@univ-angers.fr>
+ */
+
+#ifndef _VARIATION_BITFLIPMOVE_H_
+#define _VARIATION_BITFLIPMOVE_H_
+
+#include <vector>
+#include <algorithm>
+
+#include <dim/evaluation/NKLandscapes.h>
+
+#include "Move.h"
+#include "BitSampling.h"
+
+namespace dim
+{
+    namespace variation
+    {
+
+	/// fitness variation of a bit string when some of its bits are flipped
+	template <typename EOT>
+	class BitFlipEval
+	{
+	public:
+	    virtual ~BitFlipEval() {}
+	    virtual typename EOT::Fitness operator()(const EOT& sol, const std::vector<size_t>& bits) = 0;
+	};
+
+	/// every flipped bit adds or removes one to the number of ones
+	template <typename EOT>
+	class OneMaxBitFlipEval : public BitFlipEval<EOT>
+	{
+	public:
+	    virtual typename EOT::Fitness operator()(const EOT& sol, const std::vector<size_t>& bits)
+	    {
+		int delta = 0;
+		for (size_t k = 0; k < bits.size(); ++k) { delta += sol[ bits[k] ] ? -1 : 1; }
+		return delta;
+	    }
+	};
+
+	/**
+	 * Only the contributions linked to a flipped bit are computed again.
+	 *
+	 * The index of each contribution is computed once from the solution and
+	 * the bits of the flipped links are xored into it, so a single flip
+	 * costs (K+1) contributions of K+1 bits whatever N. The masks of the
+	 * affected contributions are kept between the calls, so an instance is
+	 * only used by one island.
+	 */
+	template <typename EOT, typename Value = double>
+	class NKLandscapesBitFlipEval : public BitFlipEval<EOT>
+	{
+	public:
+	    typedef typename EOT::Fitness Fitness;
+	    typedef evaluation::NKLandscapes<EOT, Value> NK;
+	    typedef typename NK::Locus Locus;
+
+	    NKLandscapesBitFlipEval(NK& nk) : _nk(nk), _masks(nk.N, 0) {}
+
+	    /// the bits have to be distinct
+	    virtual Fitness operator()(const EOT& sol, const std::vector<size_t>& bits)
+	    {
+		if ( bits.size() == 1 ) { return flip(sol, bits[0]); }
+		return flips(sol, bits, NULL);
+	    }
+
+	    /// delta of the flip of the bit b
+	    Fitness flip(const EOT& sol, size_t b) const
+	    {
+		double accu = 0.0;
+
+		for (const Locus* l = _nk.lociBegin(b); l != _nk.lociEnd(b); ++l)
+		    {
+			const Value* table = _nk.table(l->contribution);
+			unsigned s = _nk.sigma(sol, l->contribution);
+			accu += table[ s ^ l->mask ] - table[s];
+		    }
+
+		return accu / (double) _nk.N;
+	    }
+
+	    /**
+	     * Deltas of the N single flips of sol, out[b] for the bit b.
+	     *
+	     * Each contribution is computed once for the whole neighbourhood.
+	     */
+	    void neighbours(const EOT& sol, std::vector<Fitness>& out)
+	    {
+		sigmas(sol);
+		out.resize(_nk.N);
+
+		for (unsigned b = 0; b < _nk.N; ++b)
+		    {
+			double accu = 0.0;
+			for (const Locus* l = _nk.lociBegin(b); l != _nk.lociEnd(b); ++l)
+			    {
+				const Value* table = _nk.table(l->contribution);
+				unsigned s = _sigmas[ l->contribution ];
+				accu += table[ s ^ l->mask ] - table[s];
+			    }
+			out[b] = accu / (double) _nk.N;
+		    }
+	    }
+
+	    /**
+	     * Deltas of many sets of distinct flipped bits of the same solution.
+	     *
+	     * The contributions of sol are computed once for all the candidates.
+	     */
+	    void operator()(const EOT& sol, const std::vector< std::vector<size_t> >& candidates, std::vector<Fitness>& out)
+	    {
+		sigmas(sol);
+		out.resize(candidates.size());
+
+		for (size_t c = 0; c < candidates.size(); ++c)
+		    {
+			out[c] = flips(sol, candidates[c], &_sigmas[0]);
+		    }
+	    }
+
+	private:
+	    /// the contributions of sol are taken from sigmas when given
+	    Fitness flips(const EOT& sol, const std::vector<size_t>& bits, const unsigned* sigmas)
+	    {
+		_touched.clear();
+
+		for (size_t k = 0; k < bits.size(); ++k)
+		    {
+			for (const Locus* l = _nk.lociBegin(bits[k]); l != _nk.lociEnd(bits[k]); ++l)
+			    {
+				if ( !_masks[ l->contribution ] ) { _touched.push_back( l->contribution ); }
+				_masks[ l->contribution ] |= l->mask;
+			    }
+		    }
+
+		double accu = 0.0;
+
+		for (size_t k = 0; k < _touched.size(); ++k)
+		    {
+			unsigned i = _touched[k];
+			const Value* table = _nk.table(i);
+			unsigned s = sigmas ? sigmas[i] : _nk.sigma(sol, i);
+			accu += table[ s ^ _masks[i] ] - table[s];
+			_masks[i] = 0;
+		    }
+
+		return accu / (double) _nk.N;
+	    }
+
+	    void sigmas(const EOT& sol)
+	    {
+		_sigmas.resize(_nk.N);
+		for (unsigned i = 0; i < _nk.N; ++i) { _sigmas[i] = _nk.sigma(sol, i); }
+	    }
+
+	    NK& _nk;
+	    std::vector<unsigned> _masks; // bits of the flipped links of each contribution
+	    std::vector<unsigned> _touched;
+	    std::vector<unsigned> _sigmas;
+	};
+
+	/// flips a set of distinct bits drawn by the subclasses
+	template <typename EOT>
+	class BitFlipMove : public Move<EOT>
+	{
+	public:
+	    typedef typename EOT::Fitness Fitness;
+
+	    BitFlipMove(BitFlipEval<EOT>& eval) : _eval(eval) {}
+
+	    virtual Fitness delta(const EOT& sol)
+	    {
+		return _eval(sol, _bits);
+	    }
+
+	    virtual void apply(EOT& sol)
+	    {
+		detail::flip( sol, _bits );
+	    }
+
+	    /// the bits drawn
+	    inline const std::vector<size_t>& bits() const { return _bits; }
+
+	protected:
+	    BitFlipEval<EOT>& _eval;
+	    std::vector<size_t> _bits;
+	};
+
+	/// flips exactly k distinct bits, like eoDetSingleBitFlip, drawn by Floyd's sampling
+	template <typename EOT>
+	class DetBitFlipMove : public BitFlipMove<EOT>
+	{
+	public:
+	    DetBitFlipMove(BitFlipEval<EOT>& eval, unsigned k = 1) : BitFlipMove<EOT>(eval), _k(k) {}
+
+	    /// The class name.
+	    virtual std::string className() const { return "DetBitFlipMove"; }
+
+	    virtual void draw(const EOT& sol)
+	    {
+		_sampler.floyd( sol.size(), _k, this->_bits );
+	    }
+
+	private:
+	    unsigned _k;
+	    BitSampler _sampler;
+	};
+
+	/// flips each bit with a probability rate / size, like eoBitMutation(rate, true), drawn by skip sampling
+	template <typename EOT>
+	class BitMutationMove : public BitFlipMove<EOT>
+	{
+	public:
+	    BitMutationMove(BitFlipEval<EOT>& eval, double rate = 1) : BitFlipMove<EOT>(eval), _rate(rate) {}
+
+	    /// The class name.
+	    virtual std::string className() const { return "BitMutationMove"; }
+
+	    virtual void draw(const EOT& sol)
+	    {
+		_sampler.geometric( sol.size(), _rate / sol.size(), this->_bits );
+	    }
+
+	private:
+	    double _rate;
+	    BitSampler _sampler;
+	};
+
+    }
+}
+
+#endif /* _VARIATION_BITFLIPMOVE_H_ */
@@ -0,0 +1,194 @@
+// -*- mode: c++; c-indent-level: 4; c++-member-init-indent: 8; comment-column: 35; -*-
+
+/* This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+ * Authors:
+ * Caner Candan <caner.candan@univ-angers.fr>
+ */
+
+#ifndef _VARIATION_BITSAMPLING_H_
+#define _VARIATION_BITSAMPLING_H_
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+#include <eoOp.h>
+#include <dim/core/PackedBit.h>
+#include <dim/core/Random.h>
+#include <dim/core/Zobrist.h>
+
+namespace dim
+{
+    namespace variation
+    {
+
+	/**
+	 * Draws the positions of the bits to flip directly, in O(k) random
+	 * numbers for k flipped bits instead of one number per bit.
+	 */
+	class BitSampler
+	{
+	public:
+	    BitSampler() : _stamp(0) {}
+
+	    /**
+	     * Positions of the bits among n flipped each with the probability p,
+	     * in increasing order.
+	     *
+	     * The gaps between two flipped bits follow a geometric law and are
+	     * drawn from one uniform each (skip sampling).
+	     */
+	    void geometric(size_t n, double p, std::vector<size_t>& bits)
+	    {
+		bits.clear();
+
+		if ( p <= 0 ) { return; }
+		if ( p >= 1 ) { for (size_t b = 0; b < n; ++b) { bits.push_back(b); } return; }
+
+		core::Random& random = core::Random::local();
+		const double scale = 1 / std::log(1 - p);
+
+		for (size_t b = 0; b < n; ++b)
+		    {
+			// 1 - uniform is in (0, 1], so the skip is finite
+			double skip = std::floor( std::log(1 - random.uniform()) * scale );
+			if ( skip >= double(n - b) ) { break; }
+			b += size_t(skip);
+			bits.push_back(b);
+		    }
+	    }
+
+	    /**
+	     * k distinct positions among n, or all of them if k >= n, drawn by
+	     * Floyd's algorithm with k random numbers.
+	     *
+	     * The positions drawn are marked with the stamp of the call, so
+	     * checking a position does not depend on k.
+	     */
+	    void floyd(size_t n, size_t k, std::vector<size_t>& bits)
+	    {
+		bits.clear();
+		if ( k > n ) { k = n; }
+
+		if ( _marks.size() < n ) { _marks.resize(n, 0); }
+		if ( ++_stamp == 0 ) { std::fill(_marks.begin(), _marks.end(), 0); _stamp = 1; }
+
+		core::Random& random = core::Random::local();
+
+		for (size_t j = n - k; j < n; ++j)
+		    {
+			size_t b = random.random(j + 1);
+			if ( _marks[b] == _stamp ) { b = j; }
+			_marks[b] = _stamp;
+			bits.push_back(b);
+		    }
+	    }
+
+	private:
+	    std::vector<unsigned> _marks;
+	    unsigned _stamp;
+	};
+
+	namespace detail
+	{
+	    template <typename EOT>
+	    inline void flip(EOT& sol, size_t b) { sol[b] = !sol[b]; }
+
+	    template <typename FitT>
+	    inline void flip(core::PackedBit<FitT>& sol, size_t b) { sol.flip(b); }
+
+	    /// flips the bits and keeps the Zobrist hash of sol if it is known
+	    template <typename EOT>
+	    inline void flip(EOT& sol, const std::vector<size_t>& bits)
+	    {
+		core::zobrist::Hash h = sol.hash();
+		for (size_t k = 0; k < bits.size(); ++k)
+		    {
+			flip( sol, bits[k] );
+			h ^= core::zobrist::flip( bits[k] );
+		    }
+		if ( sol.hashed() ) { sol.hash(h); }
+	    }
+	}
+
+	/**
+	 * Flips each bit with a probability rate, or rate / size if normalized,
+	 * like eoBitMutation, with skip sampling.
+	 *
+	 * Works on core::Bit and core::PackedBit. The positions flipped by the
+	 * last call are given by bits().
+	 */
+	template <typename EOT>
+	class SkipBitMutation : public eoMonOp<EOT>, public core::zobrist::Keeper
+	{
+	public:
+	    SkipBitMutation(double rate = 0.01, bool normalize = false) : _rate(rate), _normalize(normalize) {}
+
+	    /// The class name.
+	    virtual std::string className() const { return "SkipBitMutation"; }
+
+	    bool operator()(EOT& sol)
+	    {
+		_sampler.geometric( sol.size(), _normalize ? _rate / sol.size() : _rate, _bits );
+		detail::flip( sol, _bits );
+		return !_bits.empty();
+	    }
+
+	    /// the bits flipped by the last call
+	    inline const std::vector<size_t>& bits() const { return _bits; }
+
+	private:
+	    double _rate;
+	    bool _normalize;
+	    BitSampler _sampler;
+	    std::vector<size_t> _bits;
+	};
+
+	/**
+	 * Flips exactly k distinct bits, like eoDetPermutBitFlip, with Floyd's
+	 * sampling.
+	 *
+	 * Works on core::Bit and core::PackedBit. The positions flipped by the
+	 * last call are given by bits().
+	 */
+	template <typename EOT>
+	class DetBitFlip : public eoMonOp<EOT>, public core::zobrist::Keeper
+	{
+	public:
+	    DetBitFlip(unsigned k = 1) : _k(k) {}
+
+	    /// The class name.
+	    virtual std::string className() const { return "DetBitFlip"; }
+
+	    bool operator()(EOT& sol)
+	    {
+		_sampler.floyd( sol.size(), _k, _bits );
+		detail::flip( sol, _bits );
+		return !_bits.empty();
+	    }
+
+	    /// the bits flipped by the last call
+	    inline const std::vector<size_t>& bits() const { return _bits; }
+
+	private:
+	    unsigned _k;
+	    BitSampler _sampler;
+	    std::vector<size_t> _bits;
+	};
+
+    }
+}
+
+#endif // !_VARIATION_BITSAMPLING_H_
@@ -0,0 +1,85 @@
+// -*- mode: c++; c-indent-level: 4; c++-member-init-indent: 8; comment-column: 35; -*-
+
+/* This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+ * Authors:
+ * Caner Candan <caner.candan@univ-angers.fr>
+ */
+#ifndef _VARIATION_CANDIDATEFIRSTIMPROVEMENTMUTATION_H_
+#define _VARIATION_CANDIDATEFIRSTIMPROVEMENTMUTATION_H_
+
+#include "Base.h"
+#include "CandidateMoves.h"
+
+namespace dim
+{
+    namespace variation
+    {
+
+	/**
+	 * FirstImprovementMutation restricted to the candidate moves (see
+	 * initialization::CandidateList): the indices are scanned from a random
+	 * one and the first improving candidate move is applied.
+	 */
+	template<typename EOT>
+	class CandidateFirstImprovementMutation : public Base<EOT>
+	{
+	public:
+	    CandidateFirstImprovementMutation(PartialOp<EOT>& op, IncrementalEval<EOT>& eval, ComparisonOp<EOT>& comp) : _op(op), _eval(eval), _comp(comp) {}
+
+	    /// The class name.
+	    virtual std::string className() const { return "CandidateFirstImprovementMutation"; }
+
+	    bool operator()(EOT& sol)
+	    {
+		const size_t last = sol.size()-1;
+		size_t first = core::Random::local().random(last);
+
+		representation::RouteIndex<EOT> index(sol);
+		std::vector<size_t> moves;
+
+		for (size_t k = 0; k < last; ++k)
+		    {
+			size_t i = (first + k) % last;
+
+			candidateMoves(sol, index, i, moves);
+
+			for (size_t m = 0; m < moves.size(); ++m)
+			    {
+				size_t j = moves[m];
+
+				// incremental eval
+				typename EOT::Fitness delta = _eval(sol, i, j);
+
+				if (_comp(delta, 0))
+				    {
+					_op(sol, i, j);
+					sol.fitness( sol.fitness() - delta );
+					return true;
+				    }
+			    }
+		    }
+		return false;
+	    }
+
+	private:
+	    PartialOp<EOT>& _op;
+	    IncrementalEval<EOT>& _eval;
+	    ComparisonOp<EOT>& _comp;
+	};
+
+    }
+}
+
+#endif /* _VARIATION_CANDIDATEFIRSTIMPROVEMENTMUTATION_H_ */
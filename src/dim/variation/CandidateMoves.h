@@ -0,0 +1,68 @@
+// -*- mode: c++; c-indent-level: 4; c++-member-init-indent: 8; comment-column: 35; -*-
+
+/* This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+ * Authors:
+ * Caner Candan <caner.candan@univ-angers.fr>
+ */
+#ifndef _VARIATION_CANDIDATEMOVES_H_
+#define _VARIATION_CANDIDATEMOVES_H_
+
+#include <vector>
+
+#include <dim/initialization/CandidateList.h>
+#include <dim/representation/RouteIndex.h>
+
+namespace dim
+{
+    namespace variation
+    {
+
+	/**
+	 * Second indices of the moves (i,j) worth evaluating from i.
+	 *
+	 * A swap, a shift or an inversion can only bring the city at i next to
+	 * one of its candidates if j is the position of this candidate or one of
+	 * the positions around it. Like the exhaustive operators, the last
+	 * position of the route is never used.
+	 *
+	 * @return the number of indices written in moves, at most 3 times the size of the candidate lists
+	 */
+	template <typename EOT>
+	size_t candidateMoves(const EOT& sol, const representation::RouteIndex<EOT>& index, size_t i, std::vector<size_t>& moves)
+	{
+	    const unsigned* neighbors = initialization::CandidateList::neighbors( sol[i] );
+	    const size_t k = initialization::CandidateList::size();
+	    const size_t last = sol.size() - 1;
+
+	    moves.clear();
+
+	    for (size_t r = 0; r < k; ++r)
+		{
+		    size_t p = index[ neighbors[r] ];
+
+		    for (size_t j = p ? p - 1 : p; j <= p + 1; ++j)
+			{
+			    if ( j == i || j >= last ) { continue; }
+			    moves.push_back(j);
+			}
+		}
+
+	    return moves.size();
+	}
+
+    }
+}
+
+#endif /* _VARIATION_CANDIDATEMOVES_H_ */
@@ -41,6 +41,7 @@
 
 #include <eoOp.h>
 #include <dim/representation/Route.h>
+#include <dim/core/Random.h>
 
 namespace dim
 {
@@ -55,8 +56,10 @@ namespace dim
 	public:
 	    bool operator() (representation::Route<FitT> & __route)
 	    {
-		std :: swap (__route [rng.random (__route.size ())],
-			     __route [rng.random (__route.size ())]) ;
+		core::Random& random = core::Random::local();
+
+		std :: swap (__route [random.random (__route.size ())],
+			     __route [random.random (__route.size ())]) ;
 
 		__route.invalidate () ;
 
@@ -20,6 +20,8 @@
 #ifndef _VARIATION_COMPARISONOP_H_
 #define _VARIATION_COMPARISONOP_H_
 
+#include "Neighborhood.h"
+
 namespace dim
 {
     namespace variation
@@ -36,14 +38,14 @@ namespace dim
 	class NeutralComparisonOp : public ComparisonOp<EOT>
 	{
 	public:
-	    virtual bool operator()(typename EOT::Fitness delta, typename EOT::Fitness fit) { return delta <= fit; }
+	    virtual bool operator()(typename EOT::Fitness delta, typename EOT::Fitness fit) { return neighborhood::Neutral::better(delta, fit); }
 	};
 
 	template <typename EOT>
 	class StrictComparisonOp : public ComparisonOp<EOT>
 	{
 	public:
-	    virtual bool operator()(typename EOT::Fitness delta, typename EOT::Fitness fit) { return delta < fit; }
+	    virtual bool operator()(typename EOT::Fitness delta, typename EOT::Fitness fit) { return neighborhood::Strict::better(delta, fit); }
 	};
     }
 }
@@ -21,30 +21,43 @@
 #define _VARIATION_FIRSTIMPROVEMENTMUTATION_H_
 
 #include "Base.h"
+#include "NeighborhoodScan.h"
 
 namespace dim
 {
     namespace variation
     {
 
+	/**
+	 * Applies the first improving neighbour among n-1 random ones.
+	 *
+	 * With a thread pool, the random neighbours are drawn first and probed
+	 * in parallel, the probes being cancelled as soon as an improving one is
+	 * found. The neighbour applied is the same as in the sequential scan,
+	 * though all the random numbers are drawn.
+	 */
 	template<typename EOT>
 	class FirstImprovementMutation : public Base<EOT>
 	{
 	public:
-	    FirstImprovementMutation(PartialOp<EOT>& op, IncrementalEval<EOT>& eval, ComparisonOp<EOT>& comp) : _op(op), _eval(eval), _comp(comp) {}
+	    FirstImprovementMutation(PartialOp<EOT>& op, IncrementalEval<EOT>& eval, ComparisonOp<EOT>& comp, core::ThreadPool* pool = NULL) : Base<EOT>(pool), _op(op), _eval(eval), _comp(comp) {}
 
 	    /// The class name.
 	    virtual std::string className() const { return "FirstImprovementMutation"; }
 
 	    bool operator()(EOT& sol)
 	    {
+		if ( this->_pool ) { return parallel(sol); }
+
+		core::Random& random = core::Random::local();
+
 		for (size_t k = 0; k < sol.size()-1; ++k)
 		    {
 			unsigned i, j;
 
 			// generate two different indices
-			i=eo::rng.random(sol.size());
-			do { j = eo::rng.random(sol.size()); } while (i == j);
+			i=random.random(sol.size());
+			do { j = random.random(sol.size()); } while (i == j);
 
 			// incremental eval
 			typename EOT::Fitness delta = _eval(sol, i, j);
@@ -52,7 +65,7 @@ namespace dim
 			if (_comp(delta, 0))
 			    {
 				_op(sol, i, j);
-				sol.fitness( sol.fitness() + delta );
+				sol.fitness( sol.fitness() - delta );
 				return true;
 			    }
 		    }
@@ -60,6 +73,44 @@ namespace dim
 	    }
 
 	private:
+	    bool parallel(EOT& sol)
+	    {
+		std::vector< typename NeighborhoodProbe<EOT>::Move > moves(sol.size()-1);
+		core::Random& random = core::Random::local();
+
+		for (size_t k = 0; k < moves.size(); ++k)
+		    {
+			unsigned i, j;
+
+			// generate two different indices
+			i=random.random(sol.size());
+			do { j = random.random(sol.size()); } while (i == j);
+
+			moves[k] = std::make_pair(i, j);
+		    }
+
+		// the counter is not shared between threads, it is updated once the probes are over
+		IncrementalEvalCounter<EOT>* counter = dynamic_cast< IncrementalEvalCounter<EOT>* >(&_eval);
+
+		NeighborhoodProbe<EOT> probe(sol, counter ? counter->eval() : _eval, _comp, moves, std::min(moves.size(), this->_pool->concurrency()));
+
+		this->run(probe, probe.chunks());
+
+		if ( counter ) { counter->value() += probe.evaluations(); }
+
+		typename NeighborhoodProbe<EOT>::Move move;
+		typename EOT::Fitness delta;
+
+		if ( probe.first(move, delta) )
+		    {
+			_op(sol, move.first, move.second);
+			sol.fitness( sol.fitness() - delta );
+			return true;
+		    }
+
+		return false;
+	    }
+
 	    PartialOp<EOT>& _op;
 	    IncrementalEval<EOT>& _eval;
 	    ComparisonOp<EOT>& _comp;
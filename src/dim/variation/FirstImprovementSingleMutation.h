@@ -21,17 +21,25 @@
 #define _VARIATION_FIRSTIMPROVEMENTSINGLEMUTATION_H_
 
 #include "Base.h"
+#include "NeighborhoodScan.h"
 
 namespace dim
 {
     namespace variation
     {
 
+	/**
+	 * Applies the first improving neighbour among n-1 distinct random ones.
+	 *
+	 * With a thread pool, the neighbours are probed in parallel and the
+	 * probes cancelled as soon as an improving one is found, the neighbour
+	 * applied being the same as in the sequential scan.
+	 */
 	template<typename EOT>
 	class FirstImprovementSingleMutation : public Base<EOT>
 	{
 	public:
-	    FirstImprovementSingleMutation(PartialOp<EOT>& op, IncrementalEval<EOT>& eval, ComparisonOp<EOT>& comp) : _op(op), _eval(eval), _comp(comp) {}
+	    FirstImprovementSingleMutation(PartialOp<EOT>& op, IncrementalEval<EOT>& eval, ComparisonOp<EOT>& comp, core::ThreadPool* pool = NULL) : Base<EOT>(pool), _op(op), _eval(eval), _comp(comp) {}
 
 	    /// The class name.
 	    virtual std::string className() const { return "FirstImprovementSingleMutation"; }
@@ -39,6 +47,7 @@ namespace dim
 	    bool operator()(EOT& sol)
 	    {
 		std::vector< std::pair< size_t, size_t > > selected;
+		core::Random& random = core::Random::local();
 
 		// check for duplicate
 		for (size_t k = 0; k < sol.size()-1; ++k)
@@ -47,13 +56,15 @@ namespace dim
 			do
 			    {
 				// generate two different indices
-				i = eo::rng.random(sol.size());
-				do { j = eo::rng.random(sol.size()); } while (i == j);
+				i = random.random(sol.size());
+				do { j = random.random(sol.size()); } while (i == j);
 			    }
 			while ( find( selected.begin(), selected.end(), std::make_pair(i,j) ) != selected.end() );
 			selected.push_back(std::make_pair(i,j));
 		    }
 
+		if ( this->_pool ) { return parallel(sol, selected); }
+
 		for (size_t k = 0; k < sol.size()-1; ++k)
 		    {
 			size_t i = selected[k].first;
@@ -65,7 +76,7 @@ namespace dim
 			if (_comp(delta, 0))
 			    {
 				_op(sol, i, j);
-				sol.fitness( sol.fitness() + delta );
+				sol.fitness( sol.fitness() - delta );
 				return true;
 			    }
 		    }
@@ -73,6 +84,30 @@ namespace dim
 	    }
 
 	private:
+	    bool parallel(EOT& sol, const std::vector< std::pair< size_t, size_t > >& selected)
+	    {
+		// the counter is not shared between threads, it is updated once the probes are over
+		IncrementalEvalCounter<EOT>* counter = dynamic_cast< IncrementalEvalCounter<EOT>* >(&_eval);
+
+		NeighborhoodProbe<EOT> probe(sol, counter ? counter->eval() : _eval, _comp, selected, std::min(selected.size(), this->_pool->concurrency()));
+
+		this->run(probe, probe.chunks());
+
+		if ( counter ) { counter->value() += probe.evaluations(); }
+
+		typename NeighborhoodProbe<EOT>::Move move;
+		typename EOT::Fitness delta;
+
+		if ( probe.first(move, delta) )
+		    {
+			_op(sol, move.first, move.second);
+			sol.fitness( sol.fitness() - delta );
+			return true;
+		    }
+
+		return false;
+	    }
+
 	    PartialOp<EOT>& _op;
 	    IncrementalEval<EOT>& _eval;
 	    ComparisonOp<EOT>& _comp;
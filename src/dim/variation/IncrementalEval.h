@@ -20,11 +20,7 @@
 #ifndef _VARIATION_INCREMENTALEVAL_H_
 #define _VARIATION_INCREMENTALEVAL_H_
 
-#include <dim/initialization/TSPLibGraph.h>
-
-#undef D
-#define D(sol, i, j) (initialization::TSPLibGraph::distance((sol)[(i)%(sol).size()], \
-							    (sol)[(j)%(sol).size()]))
+#include "Neighborhood.h"
 
 namespace dim
 {
@@ -35,7 +31,7 @@ namespace dim
 	class IncrementalEval
 	{
 	public:
-	    virtual typename EOT::Fitness operator()(EOT& sol, size_t i, size_t j) = 0;
+	    virtual typename EOT::Fitness operator()(const EOT& sol, size_t i, size_t j) = 0;
 	};
 
 	/**
@@ -49,12 +45,15 @@ namespace dim
 	public:
 	    IncrementalEvalCounter(IncrementalEval<EOT>& eval, std::string name = "IncrementalEval. ") : eoValueParam<unsigned int>(0, name), _eval(eval) {}
 
-	    virtual typename EOT::Fitness operator()(EOT& sol, size_t i, size_t j)
+	    virtual typename EOT::Fitness operator()(const EOT& sol, size_t i, size_t j)
 	    {
 		value()++;
 		return _eval(sol, i, j);
 	    }
 
+	    /// the counted evaluation, for the threads which cannot share the counter
+	    inline IncrementalEval<EOT>& eval() { return _eval; }
+
 	private:
 	    IncrementalEval<EOT>& _eval;
 	};
@@ -63,12 +62,9 @@ namespace dim
 	class InversionIncrementalEval : public IncrementalEval<EOT>
 	{
 	public:
-	    virtual typename EOT::Fitness operator()(EOT& sol, size_t i, size_t j)
+	    virtual typename EOT::Fitness operator()(const EOT& sol, size_t i, size_t j)
 	    {
-		return
-		    - (D(sol, j-1, j) + D(sol, j, j+1) + D(sol, i-1, i  ))
-		    + (D(sol, i-1, j) + D(sol, i, j)   + D(sol, j-1, j+1))
-		    ;
+		return neighborhood::Inversion::delta(sol, i, j);
 	    }
 	};
 
@@ -76,12 +72,9 @@ namespace dim
 	class ShiftIncrementalEval : public IncrementalEval<EOT>
 	{
 	public:
-	    virtual typename EOT::Fitness operator()(EOT& sol, size_t i, size_t j)
+	    virtual typename EOT::Fitness operator()(const EOT& sol, size_t i, size_t j)
 	    {
-		return
-		    - (D(sol, i-1, i) + D(sol, j, j+1))
-		    + (D(sol, i-1, j) + D(sol, i, j+1))
-		    ;
+		return neighborhood::Shift::delta(sol, i, j);
 	    }
 	};
 
@@ -89,12 +82,9 @@ namespace dim
 	class SwapIncrementalEval : public IncrementalEval<EOT>
 	{
 	public:
-	    virtual typename EOT::Fitness operator()(EOT& sol, size_t i, size_t j)
+	    virtual typename EOT::Fitness operator()(const EOT& sol, size_t i, size_t j)
 	    {
-		return
-		    - (D(sol, i-1, i) + D(sol, i, i+1) + D(sol, j-1, j) + D(sol, j, j+1))
-		    + (D(sol, i-1, j) + D(sol, j, i+1) + D(sol, j-1, i) + D(sol, i, j+1))
-		    ;
+		return neighborhood::Swap::delta(sol, i, j);
 	    }
 	};
 
@@ -102,7 +92,7 @@ namespace dim
 	class DummyIncrementalEval : public IncrementalEval<EOT>
 	{
 	public:
-	    virtual typename EOT::Fitness operator()(EOT& sol, size_t i, size_t j) { return 0; }
+	    virtual typename EOT::Fitness operator()(const EOT& sol, size_t i, size_t j) { return 0; }
 	};
 
     }
@@ -0,0 +1,101 @@
+// -*- mode: c++; c-indent-level: 4; c++-member-init-indent: 8; comment-column: 35; -*-
+
+/* This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+ * Authors:
+ * Caner Candan <caner.candan@univ-angers.fr>
+ */
+
+#ifndef _VARIATION_MOVE_H_
+#define _VARIATION_MOVE_H_
+
+#include <eoFunctor.h>
+#include <dim/core/Random.h>
+
+#include "PartialOp.h"
+#include "IncrementalEval.h"
+
+namespace dim
+{
+    namespace variation
+    {
+
+	/**
+	 * A random neighbour of a solution, evaluated before being applied.
+	 *
+	 * draw() picks the neighbour, delta() gives its fitness minus the
+	 * fitness of the solution without building it and apply() changes the
+	 * solution in place. The neighbour drawn is kept by the move between
+	 * the three calls, so an instance is only used by one island.
+	 */
+	template <typename EOT>
+	class Move : public eoFunctorBase
+	{
+	public:
+	    typedef typename EOT::Fitness Fitness;
+
+	    virtual void draw(const EOT& sol) = 0;
+	    virtual Fitness delta(const EOT& sol) = 0;
+	    virtual void apply(EOT& sol) = 0;
+
+	    /// The class name.
+	    virtual std::string className() const { return "Move"; }
+	};
+
+	/**
+	 * Neighbour (i, j) of a tour given by a partial operator, like RandMutation.
+	 *
+	 * The incremental evaluation gives the variation of the tour length and
+	 * the fitness being the opposite of the length, delta() is its opposite.
+	 */
+	template <typename EOT>
+	class PartialMove : public Move<EOT>
+	{
+	public:
+	    typedef typename EOT::Fitness Fitness;
+
+	    PartialMove(PartialOp<EOT>& op, IncrementalEval<EOT>& eval) : _op(op), _eval(eval), _i(0), _j(0) {}
+
+	    /// The class name.
+	    virtual std::string className() const { return "PartialMove"; }
+
+	    virtual void draw(const EOT& sol)
+	    {
+		core::Random& random = core::Random::local();
+
+		// generate two different indices
+		_i = random.random(sol.size());
+		do _j = random.random(sol.size()); while (_i == _j);
+	    }
+
+	    virtual Fitness delta(const EOT& sol)
+	    {
+		return -_eval(sol, _i, _j);
+	    }
+
+	    virtual void apply(EOT& sol)
+	    {
+		_op(sol, _i, _j);
+	    }
+
+	private:
+	    PartialOp<EOT>& _op;
+	    IncrementalEval<EOT>& _eval;
+	    size_t _i, _j;
+	};
+
+    }
+}
+
+#endif /* _VARIATION_MOVE_H_ */
@@ -0,0 +1,389 @@
+// -*- mode: c++; c-indent-level: 4; c++-member-init-indent: 8; comment-column: 35; -*-
+
+/* This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+ * Authors:
+ * Caner Candan <caner.candan@univ-angers.fr>
+ */
+#ifndef _VARIATION_NEIGHBORHOOD_H_
+#define _VARIATION_NEIGHBORHOOD_H_
+
+#include <vector>
+#include <limits>
+#include <algorithm>
+
+#include <dim/initialization/TSPLibGraph.h>
+
+namespace dim
+{
+    namespace variation
+    {
+
+	/**
+	 * Compile-time policies of the swap, shift and inversion neighbourhoods.
+	 *
+	 * Each move gives the operator itself (apply), the variation of the tour
+	 * length of one neighbour (delta) and the variations of a whole row of
+	 * neighbours (i fixed, every j) at once (row). The virtual PartialOp,
+	 * IncrementalEval and ComparisonOp classes are thin adapters over these
+	 * policies, so both paths always agree.
+	 *
+	 * A row is computed from a few batches of distances from a fixed city to
+	 * every city of the tour, which are plain gathers in the distance matrix,
+	 * and from the lengths of the tour edges computed once per solution. Its
+	 * final loop only does additions on contiguous buffers and is left to the
+	 * vectorizer of the compiler.
+	 */
+	namespace neighborhood
+	{
+	    inline double distance(unsigned from, unsigned to) { return initialization::TSPLibGraph::distance(from, to); }
+
+	    /// accepts delta if it is strictly better than best, the first best neighbour is kept
+	    struct Strict
+	    {
+		static bool better(double delta, double best) { return delta < best; }
+		static const bool last = false;
+	    };
+
+	    /// accepts delta if it is not worse than best, the last best neighbour is kept
+	    struct Neutral
+	    {
+		static bool better(double delta, double best) { return delta <= best; }
+		static const bool last = true;
+	    };
+
+	    /**
+	     * Copy of a tour padded with its wrapping cities and the buffers shared
+	     * by all the rows of one neighbourhood.
+	     *
+	     * city(p) is the city at position p, with p in [-1, n].
+	     */
+	    class Tour
+	    {
+	    public:
+		template <typename EOT>
+		void load(const EOT& sol, bool skips)
+		{
+		    const size_t n = sol.size();
+
+		    _cities.resize(n + 2);
+		    _cities[0] = sol[n-1];
+		    std::copy( sol.begin(), sol.end(), _cities.begin() + 1 );
+		    _cities[n+1] = sol[0];
+
+		    // _edges[p] is the length of the edge (p-1, p)
+		    _edges.resize(n + 1);
+		    for (size_t p = 0; p <= n; ++p) { _edges[p] = distance(_cities[p], _cities[p+1]); }
+
+		    // _skips[p] is the length of the edge (p-1, p+1)
+		    _skips.resize( skips ? n : 0 );
+		    for (size_t p = 0; p < _skips.size(); ++p) { _skips[p] = distance(_cities[p], _cities[p+2]); }
+		}
+
+		inline size_t size() const { return _cities.size() - 2; }
+		inline unsigned city(size_t p) const { return _cities[p+1]; }
+
+		/// same as city(), so that the scalar deltas also apply to a tour
+		inline unsigned operator[](size_t p) const { return _cities[p+1]; }
+
+		inline const unsigned* cities() const { return &_cities[0]; }
+		inline const double* edges() const { return &_edges[0]; }
+		inline const double* skips() const { return &_skips[0]; }
+
+	    private:
+		std::vector<unsigned> _cities;
+		std::vector<double> _edges;
+		std::vector<double> _skips;
+	    };
+
+	    /// scratch buffers of the rows computed by one thread
+	    class Rows
+	    {
+	    public:
+		Rows(size_t n = 0) { resize(n); }
+
+		void resize(size_t n)
+		{
+		    for (int k = 0; k < 3; ++k) { _distances[k].resize(n + 2); }
+		    _deltas.resize(n);
+		}
+
+		/// k-th buffer of n+2 distances
+		inline double* distances(int k) { return &_distances[k][0]; }
+
+		/// deltas of the last row computed
+		inline double* deltas() { return &_deltas[0]; }
+
+	    private:
+		std::vector<double> _distances[3];
+		std::vector<double> _deltas;
+	    };
+
+	    /**
+	     * Recomputes the deltas of the neighbours (i, i-1) and (i, i+1) of a row.
+	     *
+	     * The generic formulas of the rows count twice the edge shared by two
+	     * consecutive positions, and reversing or rotating the whole tour only
+	     * happens between the first and the last positions, so the cyclic
+	     * neighbours of i are the only special cases of every move.
+	     */
+	    template <typename Move>
+	    void adjacent(const Tour& tour, double* out, size_t i, size_t begin, size_t end)
+	    {
+		const size_t n = tour.size();
+		const size_t js[2] = { i ? i-1 : n-1, (i+1) % n };
+
+		for (int k = 0; k < 2; ++k)
+		    {
+			size_t j = js[k];
+			if ( begin <= j && j < end && j != i ) { out[j] = Move::delta(tour, i, j); }
+		    }
+	    }
+
+	    struct Swap
+	    {
+		static const bool skips = false;
+
+		template <typename EOT>
+		static void apply(EOT& sol, size_t i, size_t j)
+		{
+		    std::swap(sol[i], sol[j]);
+		}
+
+		template <typename EOT>
+		static double delta(const EOT& sol, size_t i, size_t j)
+		{
+		    const size_t n = sol.size();
+
+		    // every tour of three cities or less is the same cycle
+		    if ( i == j || n < 4 ) { return 0; }
+
+		    unsigned ip = sol[i ? i-1 : n-1], ic = sol[i], in = sol[(i+1) % n];
+		    unsigned jp = sol[j ? j-1 : n-1], jc = sol[j], jn = sol[(j+1) % n];
+
+		    double delta =
+			- (distance(ip, ic) + distance(ic, in) + distance(jp, jc) + distance(jc, jn))
+			+ (distance(ip, jc) + distance(jc, in) + distance(jp, ic) + distance(ic, jn))
+			;
+
+		    // the edge between two consecutive cities is kept
+		    if ( in == jc || jn == ic ) { delta += 2 * distance(ic, jc); }
+
+		    return delta;
+		}
+
+		/// rows.deltas()[j] = delta(sol, i, j) for j in [begin, end), end < n
+		static void row(const Tour& tour, Rows& rows, size_t i, size_t begin, size_t end)
+		{
+		    const unsigned* t = tour.cities();
+		    const double* e = tour.edges();
+		    double* out = rows.deltas();
+		    double* prev = rows.distances(0);
+		    double* next = rows.distances(1);
+		    double* self = rows.distances(2);
+
+		    initialization::TSPLibGraph::distances(t[i], t + 1 + begin, end - begin, prev + begin);
+		    initialization::TSPLibGraph::distances(t[i+2], t + 1 + begin, end - begin, next + begin);
+		    initialization::TSPLibGraph::distances(t[i+1], t + begin, end - begin + 2, self + begin);
+
+		    const double removed = e[i] + e[i+1];
+
+		    for (size_t j = begin; j < end; ++j)
+			{
+			    out[j] = prev[j] + next[j] + self[j] + self[j+2] - removed - e[j] - e[j+1];
+			}
+
+		    adjacent<Swap>(tour, out, i, begin, end);
+		}
+	    };
+
+	    /// moves the city at the highest position before the city at the lowest one
+	    struct Shift
+	    {
+		static const bool skips = true;
+
+		template <typename EOT>
+		static void apply(EOT& sol, size_t i, size_t j)
+		{
+		    unsigned from, to;
+		    typename EOT::AtomType tmp;
+
+		    // indexes
+		    from=std::min(i,j);
+		    to=std::max(i,j);
+
+		    // keep the first component to change
+		    tmp=sol[to];
+
+		    // shift
+		    for(unsigned int k=to ; k > from ; k--)
+			{
+			    sol[k]=sol[k-1];
+			}
+
+		    // shift the first component
+		    sol[from]=tmp;
+		}
+
+		template <typename EOT>
+		static double delta(const EOT& sol, size_t i, size_t j)
+		{
+		    const size_t n = sol.size();
+		    const size_t from = std::min(i, j), to = std::max(i, j);
+
+		    // moving the last city before the first one is a rotation
+		    if ( i == j || n < 4 || ( from == 0 && to == n-1 ) ) { return 0; }
+
+		    unsigned fp = sol[from ? from-1 : n-1], fc = sol[from];
+		    unsigned tp = sol[to-1], tc = sol[to], tn = sol[(to+1) % n];
+
+		    return
+			- (distance(tp, tc) + distance(tc, tn) + distance(fp, fc))
+			+ (distance(tp, tn) + distance(fp, tc) + distance(tc, fc))
+			;
+		}
+
+		static void row(const Tour& tour, Rows& rows, size_t i, size_t begin, size_t end)
+		{
+		    const unsigned* t = tour.cities();
+		    const double* e = tour.edges();
+		    const double* s = tour.skips();
+		    double* out = rows.deltas();
+		    double* prev = rows.distances(0);
+		    double* self = rows.distances(2);
+
+		    initialization::TSPLibGraph::distances(t[i], t + 1 + begin, end - begin, prev + begin);
+		    initialization::TSPLibGraph::distances(t[i+1], t + begin, end - begin + 2, self + begin);
+
+		    const size_t middle = std::max(begin, std::min(end, i));
+
+		    // j < i, the city i is moved before the city j
+		    const double removedBefore = e[i] + e[i+1] - s[i];
+		    for (size_t j = begin; j < middle; ++j)
+			{
+			    out[j] = self[j] + self[j+1] - removedBefore - e[j];
+			}
+
+		    // j > i, the city j is moved before the city i
+		    for (size_t j = middle; j < end; ++j)
+			{
+			    out[j] = prev[j] + self[j+1] + s[j] - e[i] - e[j] - e[j+1];
+			}
+
+		    adjacent<Shift>(tour, out, i, begin, end);
+		}
+	    };
+
+	    /// reverses the cities between the two positions
+	    struct Inversion
+	    {
+		static const bool skips = false;
+
+		template <typename EOT>
+		static void apply(EOT& sol, size_t i, size_t j)
+		{
+		    std::reverse( sol.begin() + std::min(i,j), sol.begin() + std::max(i,j) + 1 );
+		}
+
+		template <typename EOT>
+		static double delta(const EOT& sol, size_t i, size_t j)
+		{
+		    const size_t n = sol.size();
+		    const size_t from = std::min(i, j), to = std::max(i, j);
+
+		    // reversing the whole tour gives the same cycle
+		    if ( i == j || n < 4 || ( from == 0 && to == n-1 ) ) { return 0; }
+
+		    unsigned fp = sol[from ? from-1 : n-1], fc = sol[from];
+		    unsigned tc = sol[to], tn = sol[(to+1) % n];
+
+		    return
+			- (distance(fp, fc) + distance(tc, tn))
+			+ (distance(fp, tc) + distance(fc, tn))
+			;
+		}
+
+		static void row(const Tour& tour, Rows& rows, size_t i, size_t begin, size_t end)
+		{
+		    const unsigned* t = tour.cities();
+		    const double* e = tour.edges();
+		    double* out = rows.deltas();
+		    double* prev = rows.distances(0);
+		    double* next = rows.distances(1);
+		    double* self = rows.distances(2);
+
+		    initialization::TSPLibGraph::distances(t[i], t + 1 + begin, end - begin, prev + begin);
+		    initialization::TSPLibGraph::distances(t[i+2], t + 1 + begin, end - begin, next + begin);
+		    initialization::TSPLibGraph::distances(t[i+1], t + begin, end - begin + 2, self + begin);
+
+		    const size_t middle = std::max(begin, std::min(end, i));
+
+		    // j < i, the cities of [j, i] are reversed
+		    for (size_t j = begin; j < middle; ++j)
+			{
+			    out[j] = self[j] + next[j] - e[j] - e[i+1];
+			}
+
+		    // j > i, the cities of [i, j] are reversed
+		    for (size_t j = middle; j < end; ++j)
+			{
+			    out[j] = prev[j] + self[j+2] - e[i] - e[j+1];
+			}
+
+		    adjacent<Inversion>(tour, out, i, begin, end);
+		}
+	    };
+
+	    /**
+	     * Index of the best delta of a row, the first or the last one depending on the comparison.
+	     *
+	     * The minimum is found first by a branchless reduction, then located.
+	     */
+	    template <typename Comparison>
+	    size_t argmin(const double* deltas, size_t count, double& min)
+	    {
+		double m = std::numeric_limits<double>::infinity();
+		for (size_t j = 0; j < count; ++j) { m = deltas[j] < m ? deltas[j] : m; }
+		min = m;
+
+		if ( Comparison::last )
+		    {
+			for (size_t j = count; j > 0; --j) { if ( deltas[j-1] == m ) { return j-1; } }
+		    }
+		else
+		    {
+			for (size_t j = 0; j < count; ++j) { if ( deltas[j] == m ) { return j; } }
+		    }
+
+		return 0;
+	    }
+
+	    /// best neighbour (i, j) of the row i with j in [begin, end), the neighbour (i, i) being excluded
+	    template <typename Move, typename Comparison>
+	    size_t bestOfRow(const Tour& tour, Rows& rows, size_t i, size_t begin, size_t end, double& min)
+	    {
+		double* out = rows.deltas();
+
+		Move::row(tour, rows, i, begin, end);
+		if ( begin <= i && i < end ) { out[i] = std::numeric_limits<double>::infinity(); }
+
+		return begin + argmin<Comparison>(out + begin, end - begin, min);
+	    }
+
+	} // !neighborhood
+
+    }
+}
+
+#endif /* _VARIATION_NEIGHBORHOOD_H_ */
@@ -0,0 +1,216 @@
+// -*- mode: c++; c-indent-level: 4; c++-member-init-indent: 8; comment-column: 35; -*-
+
+/* This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+ * Authors:
+ * Caner Candan <caner.candan@univ-angers.fr>
+ */
+#ifndef _VARIATION_NEIGHBORHOODSCAN_H_
+#define _VARIATION_NEIGHBORHOODSCAN_H_
+
+#if __cplusplus > 199711L
+#include <atomic>
+#else
+#include <boost/atomic.hpp>
+#endif
+
+#include <vector>
+#include <utility>
+
+#include "PartialOp.h"
+#include "IncrementalEval.h"
+#include "ComparisonOp.h"
+
+namespace dim
+{
+    namespace variation
+    {
+#if __cplusplus > 199711L
+	namespace std_or_boost = std;
+#else
+	namespace std_or_boost = boost;
+#endif
+
+	/**
+	 * The neighbours (i, j) of rows consecutive rows from firstRow, with j in
+	 * [0, cols) and j != i, split in chunks of consecutive neighbours.
+	 *
+	 * Each chunk keeps its own best neighbour and count of evaluations, the
+	 * best of the whole neighbourhood being reduced in chunk order. It is the
+	 * neighbour a sequential scan keeps with the same comparison, whatever
+	 * the threads which ran the chunks.
+	 *
+	 * The evaluation and the comparison are called concurrently, they must
+	 * not count anything by themselves (see IncrementalEvalCounter::eval()).
+	 */
+	template <typename EOT>
+	class NeighborhoodScan
+	{
+	public:
+	    typedef typename EOT::Fitness Fitness;
+
+	    NeighborhoodScan(EOT& sol, IncrementalEval<EOT>& eval, ComparisonOp<EOT>& comp, size_t firstRow, size_t rows, size_t cols, size_t chunks)
+		: _sol(sol), _eval(eval), _comp(comp), _firstRow(firstRow), _cols(cols), _size(rows * cols), _results(chunks) {}
+
+	    inline size_t chunks() const { return _results.size(); }
+
+	    void operator()(size_t chunk)
+	    {
+		Result& r = _results[chunk];
+
+		const size_t end = (chunk + 1) * _size / chunks();
+
+		for (size_t k = chunk * _size / chunks(); k < end; ++k)
+		    {
+			size_t i = _firstRow + k / _cols;
+			size_t j = k % _cols;
+
+			if ( i == j ) { continue; }
+
+			Fitness delta = _eval(_sol, i, j);
+			++r.evaluations;
+
+			if ( _comp(delta, r.delta) )
+			    {
+				r.delta = delta;
+				r.i = i;
+				r.j = j;
+			    }
+		    }
+	    }
+
+	    /// @return false if no neighbour passed the comparison with a null delta
+	    bool best(size_t& i, size_t& j, Fitness& delta) const
+	    {
+		bool found = false;
+		delta = 0;
+
+		for (size_t c = 0; c < chunks(); ++c)
+		    {
+			const Result& r = _results[c];
+			if ( r.found() && _comp(r.delta, delta) )
+			    {
+				delta = r.delta;
+				i = r.i;
+				j = r.j;
+				found = true;
+			    }
+		    }
+
+		return found;
+	    }
+
+	    size_t evaluations() const
+	    {
+		size_t n = 0;
+		for (size_t c = 0; c < chunks(); ++c) { n += _results[c].evaluations; }
+		return n;
+	    }
+
+	private:
+	    struct Result
+	    {
+		Result() : delta(0), i(size_t(-1)), j(0), evaluations(0) {}
+
+		inline bool found() const { return i != size_t(-1); }
+
+		Fitness delta;
+		size_t i;
+		size_t j;
+		size_t evaluations;
+	    };
+
+	    EOT& _sol;
+	    IncrementalEval<EOT>& _eval;
+	    ComparisonOp<EOT>& _comp;
+	    size_t _firstRow;
+	    size_t _cols;
+	    size_t _size;
+	    std::vector<Result> _results;
+	};
+
+	/**
+	 * Speculative evaluation of a sequence of random neighbours, stopped as
+	 * soon as an improving one is known.
+	 *
+	 * Chunk c evaluates the neighbours c, c + chunks, c + 2 chunks... in this
+	 * order and gives up once it passes the first improving neighbour found
+	 * by any chunk. The neighbour kept is thus the first improving one of
+	 * the sequence, as in a sequential scan.
+	 */
+	template <typename EOT>
+	class NeighborhoodProbe
+	{
+	public:
+	    typedef typename EOT::Fitness Fitness;
+	    typedef std::pair<size_t, size_t> Move;
+
+	    NeighborhoodProbe(EOT& sol, IncrementalEval<EOT>& eval, ComparisonOp<EOT>& comp, const std::vector<Move>& moves, size_t chunks)
+		: _sol(sol), _eval(eval), _comp(comp), _moves(moves), _deltas(moves.size()), _evaluations(chunks, 0), _first(moves.size()) {}
+
+	    inline size_t chunks() const { return _evaluations.size(); }
+
+	    void operator()(size_t chunk)
+	    {
+		for (size_t k = chunk; k < _moves.size(); k += chunks())
+		    {
+			// cancelled by an earlier improving neighbour
+			if ( k > _first.load(std_or_boost::memory_order_relaxed) ) { return; }
+
+			Fitness delta = _eval(_sol, _moves[k].first, _moves[k].second);
+			++_evaluations[chunk];
+
+			if ( _comp(delta, 0) )
+			    {
+				_deltas[k] = delta;
+
+				size_t first = _first.load();
+				while ( k < first && !_first.compare_exchange_weak(first, k) ) {}
+				return;
+			    }
+		    }
+	    }
+
+	    /// @return false if no neighbour of the sequence is improving
+	    bool first(Move& move, Fitness& delta) const
+	    {
+		size_t k = _first.load();
+		if ( k == _moves.size() ) { return false; }
+
+		move = _moves[k];
+		delta = _deltas[k];
+		return true;
+	    }
+
+	    size_t evaluations() const
+	    {
+		size_t n = 0;
+		for (size_t c = 0; c < chunks(); ++c) { n += _evaluations[c]; }
+		return n;
+	    }
+
+	private:
+	    EOT& _sol;
+	    IncrementalEval<EOT>& _eval;
+	    ComparisonOp<EOT>& _comp;
+	    const std::vector<Move>& _moves;
+	    std::vector<Fitness> _deltas;
+	    std::vector<size_t> _evaluations;
+	    std_or_boost::atomic<size_t> _first;
+	};
+
+    }
+}
+
+#endif /* _VARIATION_NEIGHBORHOODSCAN_H_ */
@@ -27,6 +27,7 @@
 #define _VARIATION_OPCONTAINER_H_
 
 #include <eoGenOp.h>
+#include <dim/core/Random.h>
 
 namespace dim
 {
@@ -111,7 +112,7 @@ namespace dim
 		for (size_t i = 0; i < rates.size(); ++i) {
 		    _pop.seekp(pos);
 		    do {
-			if (eo::rng.flip(rates[i])) {
+			if (core::Random::local().flip(rates[i])) {
 			    //            try
 			    //            {
 			    // apply it to all the guys in the todo std::list
@@ -156,7 +157,7 @@ namespace dim
 
 	    void apply(eoPopulator<EOT>& _pop)
 	    {
-		unsigned i = eo::rng.roulette_wheel(rates);
+		unsigned i = core::Random::local().roulette(rates);
 
 		try
 		    {
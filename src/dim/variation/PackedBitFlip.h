@@ -0,0 +1,66 @@
+// -*- mode: c++; c-indent-level: 4; c++-member-init-indent: 8; comment-column: 35; -*-
+
+/* This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+ * Authors:
+ * Caner Candan <caner.candan@univ-angers.fr>
+ */
+
+#ifndef _VARIATION_PACKEDBITFLIP_H_
+#define _VARIATION_PACKEDBITFLIP_H_
+
+#include <vector>
+#include <algorithm>
+
+#include <eoOp.h>
+#include <dim/core/PackedBit.h>
+#include <dim/core/Random.h>
+
+#include "BitSampling.h"
+
+namespace dim
+{
+    namespace variation
+    {
+
+	/// flips exactly k distinct bits of a PackedBit, like eoDetPermutBitFlip
+	template <typename EOT>
+	class PackedDetBitFlip : public DetBitFlip<EOT>
+	{
+	public:
+	    PackedDetBitFlip(unsigned k = 1) : DetBitFlip<EOT>(k) {}
+
+	    /// The class name.
+	    virtual std::string className() const { return "PackedDetBitFlip"; }
+	};
+
+	/**
+	 * Flips each bit of a PackedBit with a probability rate, or rate / size
+	 * if normalized, like eoBitMutation, drawing one number per flipped bit
+	 * (see SkipBitMutation).
+	 */
+	template <typename EOT>
+	class PackedBitMutation : public SkipBitMutation<EOT>
+	{
+	public:
+	    PackedBitMutation(double rate = 0.01, bool normalize = false) : SkipBitMutation<EOT>(rate, normalize) {}
+
+	    /// The class name.
+	    virtual std::string className() const { return "PackedBitMutation"; }
+	};
+
+    }
+}
+
+#endif // !_VARIATION_PACKEDBITFLIP_H_
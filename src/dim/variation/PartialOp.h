@@ -20,16 +20,41 @@
 #ifndef _VARIATION_PARTIALOP_H_
 #define _VARIATION_PARTIALOP_H_
 
+#include <algorithm>
+
+#include <dim/core/Zobrist.h>
+
+#include "Neighborhood.h"
+
 namespace dim
 {
     namespace variation
     {
 
+	/**
+	 * Changes the components i and j of a solution, or the ones in between.
+	 *
+	 * The partial operators keep the Zobrist hash of the solution if it is
+	 * known, in the time of the change.
+	 */
 	template <typename EOT>
 	class PartialOp
 	{
 	public:
 	    virtual bool operator()(EOT& sol, size_t i, size_t j) = 0;
+
+	protected:
+	    /// hash of sol without the genes in [from, to], 0 if unknown
+	    static inline core::zobrist::Hash unhash(const EOT& sol, size_t from, size_t to)
+	    {
+		return sol.hashed() ? sol.hash() ^ core::zobrist::range(sol, from, to) : 0;
+	    }
+
+	    /// adds the genes in [from, to] back to the hash h given by unhash()
+	    static inline void rehash(EOT& sol, size_t from, size_t to, core::zobrist::Hash h)
+	    {
+		if ( sol.hashed() ) { sol.hash( h ^ core::zobrist::range(sol, from, to) ); }
+	    }
 	};
 
 	template <typename EOT>
@@ -42,21 +67,10 @@ namespace dim
 	     */
 	    virtual bool operator()(EOT& sol, size_t i, size_t j)
 	    {
-		unsigned from, to;
-
-		// indexes
-		from = std::min(i,j);
-		to = std::max(i,j);
-
-		size_t mid = (to-from)/2;
-
-		// inversion
-		for(size_t k = 0; k <= mid; ++k)
-		    {
-			size_t parity = (to-from)%2 == 0 ? 0 : 1;
-			std::swap(sol[mid-k], sol[mid+k+parity]);
-		    }
-
+		const size_t from = std::min(i, j), to = std::max(i, j);
+		core::zobrist::Hash h = this->unhash(sol, from, to);
+		neighborhood::Inversion::apply(sol, i, j);
+		this->rehash(sol, from, to, h);
 		return true;
 	    }
 	};
@@ -71,25 +85,10 @@ namespace dim
 	     */
 	    virtual bool operator()(EOT& sol, size_t i, size_t j)
 	    {
-		unsigned from, to;
-		typename EOT::AtomType tmp;
-
-		// indexes
-		from=std::min(i,j);
-		to=std::max(i,j);
-
-		// keep the first component to change
-		tmp=sol[to];
-
-		// shift
-		for(unsigned int k=to ; k > from ; k--)
-		    {
-			sol[k]=sol[k-1];
-		    }
-
-		// shift the first component
-		sol[from]=tmp;
-
+		const size_t from = std::min(i, j), to = std::max(i, j);
+		core::zobrist::Hash h = this->unhash(sol, from, to);
+		neighborhood::Shift::apply(sol, i, j);
+		this->rehash(sol, from, to, h);
 		return true;
 	    }
 	};
@@ -104,7 +103,15 @@ namespace dim
 	     */
 	    virtual bool operator()(EOT& sol, size_t i, size_t j)
 	    {
-		std::swap(sol[i], sol[j]);
+		if ( sol.hashed() )
+		    {
+			core::zobrist::Hash gi = core::zobrist::gene(sol[i]), gj = core::zobrist::gene(sol[j]);
+			sol.hash( sol.hash()
+				  ^ core::zobrist::key(i, gi) ^ core::zobrist::key(j, gj)
+				  ^ core::zobrist::key(i, gj) ^ core::zobrist::key(j, gi) );
+		    }
+
+		neighborhood::Swap::apply(sol, i, j);
 		return true;
 	    }
 	};
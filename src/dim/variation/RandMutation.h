@@ -27,8 +27,9 @@ namespace dim
     namespace variation
     {
 
+	/// applies the partial operator to two distinct random components, keeping the Zobrist hash
 	template<typename EOT>
-	class RandMutation : public Base<EOT>
+	class RandMutation : public Base<EOT>, public core::zobrist::Keeper
 	{
 	public:
 	    RandMutation(PartialOp<EOT>& op) : _op(op) {}
@@ -39,10 +40,11 @@ namespace dim
 	    bool operator()(EOT& sol)
 	    {
 		unsigned i, j;
+		core::Random& random = core::Random::local();
 
 		// generate two different indices
-		i=eo::rng.random(sol.size());
-		do j = eo::rng.random(sol.size()); while (i == j);
+		i=random.random(sol.size());
+		do j = random.random(sol.size()); while (i == j);
 
 		_op(sol, i, j);
 
@@ -0,0 +1,129 @@
+// -*- mode: c++; c-indent-level: 4; c++-member-init-indent: 8; comment-column: 35; -*-
+
+/* This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+ * Authors:
+ * Caner Candan <caner.candan@univ-angers.fr>
+ */
+#ifndef _VARIATION_RELATIVEBESTIMPROVEMENTKERNEL_H_
+#define _VARIATION_RELATIVEBESTIMPROVEMENTKERNEL_H_
+
+#include <vector>
+#include <limits>
+
+#include <utils/eoParam.h>
+
+#include "Base.h"
+#include "Neighborhood.h"
+
+namespace dim
+{
+    namespace variation
+    {
+
+	/**
+	 * RelativeBestImprovementMutation with the move and the comparison
+	 * given as compile-time policies (see neighborhood), the row of the
+	 * randomly selected index being computed at once.
+	 *
+	 * With a thread pool, the row is split in chunks of consecutive
+	 * neighbours, which only pays off for long rows or matrix-free
+	 * instances.
+	 *
+	 * Each delta computed is counted in the given parameter.
+	 */
+	template<typename EOT, typename Move, typename Comparison = neighborhood::Strict>
+	class RelativeBestImprovementKernel : public Base<EOT>
+	{
+	public:
+	    RelativeBestImprovementKernel(eoValueParam<unsigned int>& evaluations, core::ThreadPool* pool = NULL) : Base<EOT>(pool), _evaluations(evaluations) {}
+
+	    /// The class name.
+	    virtual std::string className() const { return "RelativeBestImprovementKernel"; }
+
+	    bool operator()(EOT& sol)
+	    {
+		if ( sol.size() < 2 ) { return false; }
+
+		// select one indice from the initial solution
+		size_t i;
+		i = core::Random::local().random(sol.size());
+
+		const size_t count = sol.size()-1;
+
+		neighborhood::Tour tour;
+		Scan scan(tour, i, count, this->chunks(count));
+
+		double best_delta = std::numeric_limits<double>::infinity();
+		size_t best_j = 0;
+
+		DO_MEASURE(
+
+			   tour.load(sol, Move::skips);
+
+			   this->run(scan, scan.chunks());
+
+			   for (size_t c = 0; c < scan.chunks(); ++c)
+			       {
+				   if ( Comparison::better(scan.deltas[c], best_delta) )
+				       {
+					   best_delta = scan.deltas[c];
+					   best_j = scan.js[c];
+				       }
+			       }
+
+			   _evaluations.value() += i < count ? count-1 : count;
+
+			   , this->_measureFiles, "variation_total" );
+
+		// if the best delta is negative, we apply the operator to the solution with the best indicies
+		if ( best_delta < 0 )
+		    {
+			Move::apply(sol, i, best_j);
+			sol.unhash();
+			sol.fitness( sol.fitness() - best_delta );
+			return true;
+		    }
+
+		return false;
+	    }
+
+	private:
+	    /// best neighbour of each chunk of the row
+	    struct Scan
+	    {
+		Scan(const neighborhood::Tour& t, size_t r, size_t n, size_t chunks) : tour(t), i(r), count(n), deltas(chunks), js(chunks) {}
+
+		inline size_t chunks() const { return deltas.size(); }
+
+		void operator()(size_t chunk)
+		{
+		    neighborhood::Rows rows(count + 1);
+		    js[chunk] = neighborhood::bestOfRow<Move, Comparison>(tour, rows, i, chunk * count / chunks(), (chunk + 1) * count / chunks(), deltas[chunk]);
+		}
+
+		const neighborhood::Tour& tour;
+		size_t i;
+		size_t count;
+		std::vector<double> deltas;
+		std::vector<size_t> js;
+	    };
+
+	    eoValueParam<unsigned int>& _evaluations;
+	};
+
+    }
+}
+
+#endif /* _VARIATION_RELATIVEBESTIMPROVEMENTKERNEL_H_ */
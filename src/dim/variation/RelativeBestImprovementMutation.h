@@ -21,17 +21,24 @@
 #define _VARIATION_RELATIVEBESTIMPROVEMENTMUTATION_H_
 
 #include "Base.h"
+#include "NeighborhoodScan.h"
 
 namespace dim
 {
     namespace variation
     {
 
+	/**
+	 * Applies the best neighbour of one random index.
+	 *
+	 * With a thread pool, the row of the index is split in chunks and the
+	 * neighbour applied is still the one of the sequential scan.
+	 */
 	template<typename EOT>
 	class RelativeBestImprovementMutation : public Base<EOT>
 	{
 	public:
-	    RelativeBestImprovementMutation(PartialOp<EOT>& op, IncrementalEval<EOT>& eval, ComparisonOp<EOT>& comp) : _op(op), _eval(eval), _comp(comp) {}
+	    RelativeBestImprovementMutation(PartialOp<EOT>& op, IncrementalEval<EOT>& eval, ComparisonOp<EOT>& comp, core::ThreadPool* pool = NULL) : Base<EOT>(pool), _op(op), _eval(eval), _comp(comp) {}
 
 	    /// The class name.
 	    virtual std::string className() const { return "RelativeBestImprovementMutation"; }
@@ -40,7 +47,9 @@ namespace dim
 	    {
 		// select one indice from the initial solution
 		size_t i;
-		i = eo::rng.random(sol.size());
+		i = core::Random::local().random(sol.size());
+
+		if ( this->_pool ) { return parallel(sol, i); }
 
 		// keep a best solution with its best delta
 		size_t best_i = i;
@@ -66,7 +75,7 @@ namespace dim
 		if ( best_delta < 0 )
 		    {
 			_op(sol, best_i, best_j);
-			sol.fitness( sol.fitness() + best_delta );
+			sol.fitness( sol.fitness() - best_delta );
 			return true;
 		    }
 
@@ -74,6 +83,37 @@ namespace dim
 	    }
 
 	private:
+	    bool parallel(EOT& sol, size_t i)
+	    {
+		size_t best_i = i;
+		size_t best_j = 0;
+		typename EOT::Fitness best_delta = 0;
+
+		// the counter is not shared between threads, it is updated once the scan is over
+		IncrementalEvalCounter<EOT>* counter = dynamic_cast< IncrementalEvalCounter<EOT>* >(&_eval);
+
+		const size_t cols = sol.size()-1;
+		NeighborhoodScan<EOT> scan(sol, counter ? counter->eval() : _eval, _comp, i, 1, cols, this->chunks(cols));
+
+		DO_MEASURE(
+
+			   this->run(scan, scan.chunks());
+			   scan.best(best_i, best_j, best_delta);
+
+			   , this->_measureFiles, "variation_total" );
+
+		if ( counter ) { counter->value() += scan.evaluations(); }
+
+		if ( best_delta < 0 )
+		    {
+			_op(sol, best_i, best_j);
+			sol.fitness( sol.fitness() - best_delta );
+			return true;
+		    }
+
+		return false;
+	    }
+
 	    PartialOp<EOT>& _op;
 	    IncrementalEval<EOT>& _eval;
 	    ComparisonOp<EOT>& _comp;
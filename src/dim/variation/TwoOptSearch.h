@@ -0,0 +1,171 @@
+// -*- mode: c++; c-indent-level: 4; c++-member-init-indent: 8; comment-column: 35; -*-
+
+/* This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+ * Authors:
+ * Caner Candan <caner.candan@univ-angers.fr>
+ */
+#ifndef _VARIATION_TWOOPTSEARCH_H_
+#define _VARIATION_TWOOPTSEARCH_H_
+
+#include <deque>
+#include <vector>
+
+#include <utils/eoParam.h>
+
+#include <dim/initialization/TSPLibGraph.h>
+#include <dim/initialization/CandidateList.h>
+#include <dim/representation/TwoLevelList.h>
+
+#include "Base.h"
+
+namespace dim
+{
+    namespace variation
+    {
+
+	/**
+	 * 2-opt local search driven by don't-look bits and candidate lists.
+	 *
+	 * The route is loaded in a representation::TwoLevelList so that a move
+	 * costs O(sqrt(n)), and only the cities whose neighbourhood changed are
+	 * queued again: a city whose bit is set is not looked at until one of
+	 * its tour edges is modified. For every queued city a, both tour edges
+	 * (a,b) are tried against the edges (a,c) towards its candidates c that
+	 * are shorter than (a,b), the first improving move being applied.
+	 *
+	 * The search stops at a local optimum or after maxMoves moves if it is
+	 * positive. Each move evaluated is counted in the given parameter, which
+	 * can be an IncrementalEvalCounter for the checkpoints.
+	 */
+	template<typename EOT>
+	class TwoOptSearch : public Base<EOT>
+	{
+	public:
+	    TwoOptSearch(eoValueParam<unsigned int>& evaluations, size_t maxMoves = 0) : _evaluations(evaluations), _maxMoves(maxMoves) {}
+
+	    /// The class name.
+	    virtual std::string className() const { return "TwoOptSearch"; }
+
+	    bool operator()(EOT& sol)
+	    {
+		const size_t n = sol.size();
+		if ( n < 4 ) { return false; }
+
+		representation::TwoLevelList tour( &initialization::TSPLibGraph::distance );
+		tour.build(sol);
+
+		// cities whose don't-look bit is off
+		std::deque<unsigned> queue( sol.begin(), sol.end() );
+		std::vector<bool> queued(n, true);
+
+		double gain = 0;
+		size_t moves = 0;
+
+		DO_MEASURE(
+
+			   while ( !queue.empty() && ( !_maxMoves || moves < _maxMoves ) )
+			       {
+				   unsigned a = queue.front();
+				   queue.pop_front();
+				   queued[a] = false;
+
+				   unsigned touched[4];
+				   double delta;
+
+				   DO_MEASURE( delta = improve(tour, a, touched);, this->_measureFiles, "variation_compute_delta" );
+
+				   if ( delta < 0 )
+				       {
+					   gain -= delta;
+					   ++moves;
+
+					   for (int t = 0; t < 4; ++t)
+					       {
+						   if ( !queued[ touched[t] ] )
+						       {
+							   queued[ touched[t] ] = true;
+							   queue.push_back( touched[t] );
+						       }
+					       }
+				       }
+			       }
+
+			   , this->_measureFiles, "variation_total" );
+
+		if ( !moves ) { return false; }
+
+		tour.toRoute(sol);
+		sol.unhash();
+
+		// the fitness is the opposite of the length
+		if ( !sol.invalid() ) { sol.fitness( sol.fitness() + gain ); }
+
+		return true;
+	    }
+
+	private:
+	    /**
+	     * Applies the first improving 2-opt move around the city a.
+	     *
+	     * @return the variation of length, negative if a move was applied
+	     */
+	    double improve(representation::TwoLevelList& tour, unsigned a, unsigned* touched)
+	    {
+		const unsigned* candidates = initialization::CandidateList::neighbors(a);
+		const size_t k = initialization::CandidateList::size();
+
+		for (int forward = 1; forward >= 0; --forward)
+		    {
+			unsigned b = forward ? tour.next(a) : tour.prev(a);
+			double ab = forward ? tour.nextCost(a) : tour.nextCost(b);
+
+			for (size_t r = 0; r < k; ++r)
+			    {
+				unsigned c = candidates[r];
+				double ac = initialization::TSPLibGraph::distance(a, c);
+
+				// the candidates are sorted, no farther one can improve
+				if ( ac >= ab ) { break; }
+
+				unsigned d = forward ? tour.next(c) : tour.prev(c);
+				if ( c == b || d == a ) { continue; }
+
+				++_evaluations.value();
+
+				double cd = forward ? tour.nextCost(c) : tour.nextCost(d);
+				double delta = ac + initialization::TSPLibGraph::distance(b, d) - ab - cd;
+
+				if ( delta < -1e-9 )
+				    {
+					// a->b ... c->d becomes a->c ... b->d, b->a ... d->c becomes c->a ... d->b
+					if ( forward ) { tour.reverse(b, c); } else { tour.reverse(a, d); }
+
+					touched[0] = a; touched[1] = b; touched[2] = c; touched[3] = d;
+					return delta;
+				    }
+			    }
+		    }
+
+		return 0;
+	    }
+
+	    eoValueParam<unsigned int>& _evaluations;
+	    size_t _maxMoves;
+	};
+
+    }
+}
+
+#endif /* _VARIATION_TWOOPTSEARCH_H_ */
@@ -69,12 +69,12 @@ namespace dim
 	    return vec;
 	}
 
-	std::vector<double> random_vector(unsigned size)
+	std::vector<double> random_vector(unsigned size, core::Random& random)
 	{
 	    std::vector<double> epsilon(size);
 	    for (size_t i = 0; i < size; ++i)
 		{
-		    epsilon[i] = rng.rand() % 1000;
+		    epsilon[i] = random.random(1000);
 		}
 	    return epsilon;
 	}
@@ -102,7 +102,7 @@ namespace dim
 		AUTO(typename BOOST_IDENTITY_TYPE((std::vector< typename EOT::Fitness >)))& S = data.feedbacks;
 		typename std::vector< typename EOT::Fitness >::iterator max_it = std::max_element(S.begin(), S.end());
 		int count = (max_it != S.end()) ? std::count(S.begin(), S.end(), *max_it) : 0;
-		std::vector< double > epsilon = normalize(random_vector(this->size()));
+		std::vector< double > epsilon = normalize(random_vector(this->size(), data.random));
 
 		unsigned sum = 0;
 		for ( size_t i = 0; i < this->size()-1; ++i )
@@ -154,7 +154,7 @@ namespace dim
 
 		R = normalize(R);
 
-		std::vector< double > epsilon = normalize(random_vector(this->size()));
+		std::vector< double > epsilon = normalize(random_vector(this->size(), data.random));
 
 		AUTO(double) elapsed = std_or_boost::chrono::duration_cast<std_or_boost::chrono::microseconds>( std_or_boost::chrono::system_clock::now() - tau ).count() / 1000.; // \DELTA{t}
 
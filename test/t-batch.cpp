@@ -0,0 +1,110 @@
+#undef NDEBUG
+#include <eo>
+#include <dim/core/Bit.h>
+#include <dim/evaluation/Batch.h>
+#include <dim/evaluation/OneMax.h>
+#include <dim/evaluation/NKLandscapes.h>
+#include <dim/evaluation/Route.h>
+#include <dim/core/Random.h>
+#include <vector>
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <cassert>
+
+using namespace std;
+using namespace dim::evaluation;
+
+typedef dim::core::Bit<double> B;
+typedef dim::representation::Route<double> R;
+
+// the batch gives the fitnesses of the scalar evaluation, whatever the number of lanes used
+template <typename EOT, typename Eval>
+void check(Eval& eval, vector<EOT>& sols)
+{
+    vector<double> scalar(sols.size());
+    for (size_t i = 0; i < sols.size(); ++i) { eval(sols[i]); scalar[i] = sols[i].fitness(); sols[i].invalidate(); }
+
+    vector<EOT*> ptrs(sols.size());
+    for (size_t i = 0; i < sols.size(); ++i) { ptrs[i] = &sols[i]; }
+
+    BatchCounter<EOT> counter(eval);
+    evaluate(counter, &ptrs[0], ptrs.size());
+
+    assert( counter.value() == sols.size() );
+    for (size_t i = 0; i < sols.size(); ++i) { assert( !sols[i].invalid() && sols[i].fitness() == scalar[i] ); }
+
+    // the valid ones are neither evaluated nor counted again
+    sols[3].invalidate();
+    evaluate(counter, &ptrs[0], ptrs.size());
+    assert( counter.value() == sols.size() + 1 );
+}
+
+int main(void)
+{
+    dim::core::Random rnd(1);
+
+    const size_t count = 2 * Batch<B>::lanes + 3;
+
+    // NK
+    {
+	vector<B> sols(count, B(100));
+	for (size_t i = 0; i < sols.size(); ++i) { for (size_t k = 0; k < 100; ++k) { sols[i][k] = rnd.flip(); } }
+
+	NKLandscapes<B> nk(100, 4);
+	check(nk, sols);
+    }
+
+    // Route
+    {
+	const size_t n = 50;
+
+	ofstream file("t-batch.tsp");
+	file << n << endl;
+	for (size_t k = 0; k < n; ++k) { file << rnd.random(1000) << " " << rnd.random(1000) << endl; }
+	file.close();
+
+	dim::initialization::TSPLibGraph::load("t-batch.tsp", "EUC_2D");
+
+	vector<R> sols(count);
+	for (size_t i = 0; i < sols.size(); ++i)
+	    {
+		for (size_t k = 0; k < n; ++k) { sols[i].push_back(k); }
+		for (size_t k = n; k > 1; --k) { swap( sols[i][k-1], sols[i][ rnd.random(k) ] ); }
+	    }
+
+	Route<double> route;
+	check(route, sols);
+    }
+
+    // routes of different lengths or too short for a tour
+    {
+	vector<R> sols(count);
+	for (size_t i = 0; i < sols.size(); ++i)
+	    {
+		for (size_t k = 0; k < i % 5; ++k) { sols[i].push_back(k); }
+	    }
+
+	Route<double> route;
+	check(route, sols);
+	for (size_t i = 0; i + 1 < sols.size(); i += 5) { assert( sols[i].fitness() == 0 && sols[i+1].fitness() == 0 ); }
+    }
+
+    // an evaluator without batch is called on each invalid individual
+    {
+	vector<B> sols(count, B(10, true));
+	dim::core::Pop<B> pop;
+	pop.insert(pop.end(), sols.begin(), sols.end());
+
+	OneMax<B> onemax;
+	eoEvalFuncCounter<B> counter(onemax);
+	evaluate(counter, pop);
+
+	assert( counter.value() == count );
+	for (size_t i = 0; i < pop.size(); ++i) { assert( pop[i].fitness() == 10 ); }
+    }
+
+    cout << "ok" << endl;
+
+    return 0;
+}
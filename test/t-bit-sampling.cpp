@@ -0,0 +1,111 @@
+#undef NDEBUG
+#include <dim/core/Bit.h>
+#include <dim/core/PackedBit.h>
+#include <dim/variation/BitSampling.h>
+#include <vector>
+#include <algorithm>
+#include <iostream>
+#include <cassert>
+
+using namespace std;
+using namespace dim::variation;
+
+// the bits reported are the ones flipped
+template <typename EOT, typename Op>
+void check(Op& op, size_t n)
+{
+    for (int rep = 0; rep < 100; ++rep)
+	{
+	    EOT sol(n), before(n);
+	    op(sol);
+
+	    vector<size_t> changed;
+	    for (size_t b = 0; b < n; ++b) { if ( sol[b] != before[b] ) { changed.push_back(b); } }
+
+	    vector<size_t> bits = op.bits();
+	    sort(bits.begin(), bits.end());
+	    assert( bits == changed );
+	}
+}
+
+int main(void)
+{
+    BitSampler sampler;
+    vector<size_t> bits;
+
+    // skip sampling: increasing positions, n * p of them on average
+    {
+	const size_t n = 1000;
+	const int reps = 10000;
+	vector<int> hits(n, 0);
+	size_t total = 0;
+
+	for (int rep = 0; rep < reps; ++rep)
+	    {
+		sampler.geometric(n, 0.01, bits);
+		for (size_t k = 0; k < bits.size(); ++k)
+		    {
+			assert( bits[k] < n );
+			if ( k ) { assert( bits[k-1] < bits[k] ); }
+			++hits[ bits[k] ];
+		    }
+		total += bits.size();
+	    }
+
+	assert( total > 0.97 * reps * 10 && total < 1.03 * reps * 10 );
+
+	// the first and the last bits are as likely as the others
+	assert( hits[0] > 50 && hits[0] < 150 );
+	assert( hits[n-1] > 50 && hits[n-1] < 150 );
+
+	sampler.geometric(n, 0, bits);
+	assert( bits.empty() );
+	sampler.geometric(n, 1, bits);
+	assert( bits.size() == n );
+    }
+
+    // Floyd: exactly k distinct positions, each one as likely
+    {
+	const size_t n = 20;
+	const int reps = 20000;
+	vector<int> hits(n, 0);
+
+	for (int rep = 0; rep < reps; ++rep)
+	    {
+		sampler.floyd(n, 5, bits);
+		assert( bits.size() == 5 );
+
+		vector<size_t> sorted = bits;
+		sort(sorted.begin(), sorted.end());
+		assert( unique(sorted.begin(), sorted.end()) == sorted.end() );
+
+		for (size_t k = 0; k < bits.size(); ++k) { assert( bits[k] < n ); ++hits[ bits[k] ]; }
+	    }
+
+	for (size_t b = 0; b < n; ++b) { assert( hits[b] > 0.9 * reps / 4 && hits[b] < 1.1 * reps / 4 ); }
+
+	sampler.floyd(n, 30, bits);
+	assert( bits.size() == n );
+    }
+
+    // the operators on both representations
+    {
+	SkipBitMutation< dim::core::Bit<double> > bitMutation(3, true);
+	check< dim::core::Bit<double> >(bitMutation, 100);
+
+	SkipBitMutation< dim::core::PackedBit<double> > packedMutation(3, true);
+	check< dim::core::PackedBit<double> >(packedMutation, 100);
+
+	DetBitFlip< dim::core::Bit<double> > kflip(7);
+	check< dim::core::Bit<double> >(kflip, 100);
+	assert( kflip.bits().size() == 7 );
+
+	DetBitFlip< dim::core::PackedBit<double> > packedKflip(7);
+	check< dim::core::PackedBit<double> >(packedKflip, 130);
+	assert( packedKflip.bits().size() == 7 );
+    }
+
+    cout << "ok" << endl;
+
+    return 0;
+}
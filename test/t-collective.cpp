@@ -0,0 +1,184 @@
+#undef NDEBUG
+#include <dim/core/Collective.h>
+#include <dim/representation/Route.h>
+#include <boost/mpi.hpp>
+#include <vector>
+#include <algorithm>
+#include <iostream>
+#include <cassert>
+
+using namespace std;
+using namespace dim::core;
+
+typedef dim::representation::Route<double> EOT;
+
+// the individuals from the island "from" to the island "to", telling where they come from (Pop copies no individual)
+void migrants(Pop<EOT>& pop, int from, int to, int generation)
+{
+    for (int k = 0; k < (from + to + generation) % 4; ++k)
+	{
+	    EOT ind;
+	    ind.push_back(from);
+	    ind.push_back(to);
+	    ind.push_back(k);
+	    ind.fitness(generation);
+	    ind.addIsland(from);
+	    pop.push_back(ind);
+	}
+}
+
+// the migrants received by an island are the ones sent to it, in order
+void checkMigration(Collective<EOT>& collective, const vector<int>& peers, int generation)
+{
+    boost::mpi::communicator world;
+    const int rank = world.rank();
+
+    vector< Pop<EOT> > out( world.size() ), in;
+    for (size_t s = 0; s < peers.size(); ++s) { migrants(out[ peers[s] ], rank, peers[s], generation); }
+
+    // the migrants are serialized by the post, out can go meanwhile
+    if ( generation % 2 )
+	{
+	    collective.postMigration(out);
+	    out.clear();
+	    collective.waitMigration(in);
+	}
+    else
+	{
+	    collective.migrate(out, in);
+	}
+
+    assert( in.size() == size_t( world.size() ) );
+    for (int i = 0; i < world.size(); ++i)
+	{
+	    bool peer = find( peers.begin(), peers.end(), i ) != peers.end() && i != rank;
+	    Pop<EOT> expected;
+	    if ( peer ) { migrants(expected, i, rank, generation); }
+
+	    assert( in[i].size() == expected.size() );
+	    for (size_t k = 0; k < expected.size(); ++k)
+		{
+		    assert( in[i][k][0] == unsigned(i) && in[i][k][1] == unsigned(rank) && in[i][k][2] == k );
+		    assert( in[i][k].fitness() == generation );
+		    assert( in[i][k].getLastIsland() == i );
+		}
+	}
+}
+
+// an individual of the user with no wire format, serialized by boost
+struct Custom : public EO<double>
+{
+    std::vector<int> genes;
+
+    template <class Archive>
+    void serialize(Archive& ar, const unsigned int /*version*/) { ar & genes; }
+};
+
+// the individuals without wire format go through boost, the empty ones included
+void checkCustom(Collective<Custom>& collective, int generation)
+{
+    boost::mpi::communicator world;
+    const int rank = world.rank();
+
+    vector< Pop<Custom> > out( world.size() ), in;
+    for (int i = 0; i < world.size(); ++i)
+	{
+	    for (int k = 0; k < (rank + i + generation) % 3; ++k)
+		{
+		    Custom ind;
+		    ind.genes.assign(k, rank);
+		    ind.genes.push_back(i);
+		    out[i].push_back(ind);
+		}
+	}
+
+    collective.migrate(out, in);
+
+    for (int i = 0; i < world.size(); ++i)
+	{
+	    const int n = i == rank ? 0 : (i + rank + generation) % 3;
+	    assert( in[i].size() == size_t(n) );
+	    for (int k = 0; k < n; ++k)
+		{
+		    assert( in[i][k].genes.size() == size_t(k + 1) );
+		    assert( count( in[i][k].genes.begin(), in[i][k].genes.end(), i ) == k );
+		    assert( in[i][k].genes.back() == rank );
+		}
+	}
+}
+
+// the feedback received from an island is the one it computed for this one
+void checkFeedbacks(Collective<EOT>& collective, const vector<int>& peers, int generation)
+{
+    boost::mpi::communicator world;
+    const int rank = world.rank();
+
+    vector<double> out( world.size() ), in;
+    for (int i = 0; i < world.size(); ++i) { out[i] = 1000 * generation + 10 * rank + i; }
+
+    collective.feedbacks(out, in);
+
+    for (int i = 0; i < world.size(); ++i)
+	{
+	    bool peer = find( peers.begin(), peers.end(), i ) != peers.end();
+	    assert( in[i] == ( peer ? 1000 * generation + 10 * i + rank : 0 ) );
+	}
+}
+
+int main(int argc, char** argv)
+{
+    boost::mpi::environment env(argc, argv);
+    boost::mpi::communicator world;
+
+    // every island, the same buffers generation after generation
+    {
+	Collective<EOT>& collective = Collective<EOT>::shared();
+	for (int g = 0; g < 5; ++g)
+	    {
+		checkMigration(collective, collective.peers(), g);
+		checkFeedbacks(collective, collective.peers(), g);
+	    }
+    }
+
+    // individuals without wire format
+    {
+	assert( !dim::core::wire::Encoded<Custom>::value );
+
+	Collective<Custom> collective;
+	for (int g = 0; g < 3; ++g) { checkCustom(collective, g); }
+    }
+
+    // a ring of neighbours
+    if ( world.size() > 2 )
+	{
+	    vector<int> ring;
+	    ring.push_back( (world.rank() + world.size() - 1) % world.size() );
+	    ring.push_back( (world.rank() + 1) % world.size() );
+	    if ( ring[0] == ring[1] ) { ring.pop_back(); }
+
+	    Collective<EOT> collective(ring);
+
+	    for (int g = 0; g < 5; ++g)
+		{
+		    checkMigration(collective, ring, g);
+		    checkFeedbacks(collective, ring, g);
+		}
+
+	    // nothing goes to the other islands
+	    if ( world.size() > 3 )
+		{
+		    vector< Pop<EOT> > out( world.size() ), in;
+		    out[ (world.rank() + 2) % world.size() ].push_back( EOT() );
+
+		    bool thrown = false;
+		    try { collective.postMigration(out); } catch (std::runtime_error&) { thrown = true; }
+		    assert( thrown );
+		}
+	}
+
+    world.barrier();
+
+    if ( 0 == world.rank() ) { cout << "ok" << endl; }
+
+    return 0;
+}
@@ -0,0 +1,171 @@
+#undef NDEBUG
+#include <eo>
+#include <dim/core/Bit.h>
+#include <dim/core/PackedBit.h>
+#include <dim/core/IslandData.h>
+#include <dim/core/FitnessCache.h>
+#include <dim/representation/Route.h>
+#include <dim/variation/BitSampling.h>
+#include <dim/variation/PartialOp.h>
+#include <dim/evaluation/OneMax.h>
+#include <dim/evolver/Easy.h>
+#include <dim/core/Random.h>
+#include <boost/archive/text_oarchive.hpp>
+#include <boost/archive/text_iarchive.hpp>
+#include <sstream>
+#include <vector>
+#include <thread>
+#include <iostream>
+#include <cassert>
+
+using namespace std;
+using namespace dim;
+
+typedef core::Bit<double> B;
+typedef core::PackedBit<double> P;
+typedef representation::Route<double> R;
+
+// the hash kept by the operator is the one of the genes
+template <typename EOT, typename Op>
+void keep(Op& op, size_t n)
+{
+    EOT sol(n);
+    sol.hash( core::zobrist::hash(sol) );
+
+    for (int rep = 0; rep < 200; ++rep)
+	{
+	    op(sol);
+	    assert( sol.hashed() && sol.hash() == core::zobrist::hash(sol) );
+	}
+}
+
+void lookups(core::FitnessCache<double>* cache, int offset)
+{
+    for (int k = 0; k < 10000; ++k)
+	{
+	    core::zobrist::Hash h = core::zobrist::key(k % 100, offset);
+	    double fitness;
+	    if ( cache->find(h, fitness) ) { assert( fitness == k % 100 + offset ); }
+	    else { cache->insert(h, k % 100 + offset); }
+	}
+}
+
+int main(void)
+{
+    // bit strings
+    {
+	variation::SkipBitMutation<B> bitMutation(2, true);
+	keep<B>(bitMutation, 100);
+	variation::DetBitFlip<B> kflip(3);
+	keep<B>(kflip, 100);
+	variation::SkipBitMutation<P> packedMutation(2, true);
+	keep<P>(packedMutation, 130);
+	variation::DetBitFlip<P> packedKflip(3);
+	keep<P>(packedKflip, 130);
+
+	// the same bits give the same hash whatever the representation
+	B b(70);
+	P p(70);
+	for (size_t k = 0; k < 70; k += 3) { b[k] = true; p.flip(k); }
+	assert( core::zobrist::hash(b) == core::zobrist::hash(p) );
+    }
+
+    // tours
+    {
+	R r;
+	for (unsigned k = 0; k < 50; ++k) { r.push_back(k); }
+	r.hash( core::zobrist::hash(r) );
+
+	variation::SwapPartialOp<R> swapOp;
+	variation::ShiftPartialOp<R> shiftOp;
+	variation::InversionPartialOp<R> inversionOp;
+	variation::PartialOp<R>* ops[] = { &swapOp, &shiftOp, &inversionOp };
+
+	core::Random random(1);
+	for (int rep = 0; rep < 300; ++rep)
+	    {
+		(*ops[rep % 3])(r, random.random(50), random.random(50));
+		assert( r.hash() == core::zobrist::hash(r) );
+	    }
+    }
+
+    // the hash travels with the migrants
+    {
+	B b(40, true);
+	b.hash( core::zobrist::hash(b) );
+
+	std::ostringstream os;
+	{ boost::archive::text_oarchive oa(os); oa << b; }
+
+	B c;
+	std::istringstream is(os.str());
+	{ boost::archive::text_iarchive ia(is); ia >> c; }
+
+	assert( c.hashed() && c.hash() == b.hash() );
+    }
+
+    // bounded, and shared by threads
+    {
+	core::FitnessCache<double> cache(64, 4);
+	assert( cache.capacity() == 64 );
+
+	for (int k = 0; k < 1000; ++k) { cache.insert( core::zobrist::key(k, 0), k ); }
+
+	size_t found = 0;
+	for (int k = 0; k < 1000; ++k)
+	    {
+		double fitness;
+		if ( cache.find( core::zobrist::key(k, 0), fitness ) ) { assert( fitness == k ); ++found; }
+	    }
+	assert( found > 0 && found <= 64 );
+	assert( cache.hits() == found && cache.misses() == 1000 - found );
+
+	// large enough for none of the 200 keys to be evicted, whatever the interleaving
+	core::FitnessCache<double> shared(1 << 12);
+	thread t0(lookups, &shared, 0), t1(lookups, &shared, 1000);
+	t0.join(); t1.join();
+	assert( shared.misses() == 200 && shared.hits() == 20000 - 200 );
+	assert( shared.hitRate() + shared.missRate() == 1 );
+
+	// fewer sets than locks, each set still has a single lock
+	core::FitnessCache<double> small(8, 64);
+	thread t2(lookups, &small, 0), t3(lookups, &small, 1000);
+	t2.join(); t3.join();
+	assert( small.hits() + small.misses() == 20000 );
+    }
+
+    // the evolver only evaluates the genomes it has not seen
+    {
+	evaluation::OneMax<B> onemax;
+	eoEvalFuncCounter<B> counter(onemax);
+	variation::DetBitFlip<B> flip(1);
+	core::FitnessCache<double> cache(1 << 12);
+
+	core::Pop<B> pop;
+	for (int i = 0; i < 20; ++i) { B b(8); onemax(b); pop.push_back(b); }
+
+	core::IslandData<B> data(1, 0);
+	evolver::Easy<B> easy(counter, flip, true, 10, false, &cache);
+	evolver::Easy<B> batch(counter, flip, true, 10, true, &cache);
+	easy.firstCall(pop, data);
+	batch.firstCall(pop, data);
+
+	for (int g = 0; g < 5; ++g) { easy(pop, data); batch(pop, data); }
+
+	assert( counter.value() == cache.misses() );
+	assert( cache.hits() + cache.misses() == 20 * 10 * 10 );
+	assert( counter.value() <= 256 );
+
+	for (size_t i = 0; i < pop.size(); ++i)
+	    {
+		B b = pop[i];
+		b.invalidate();
+		onemax(b);
+		assert( b.fitness() == pop[i].fitness() );
+	    }
+    }
+
+    cout << "ok" << endl;
+
+    return 0;
+}
@@ -0,0 +1,100 @@
+#undef NDEBUG
+
+#include <dim/core/Bit.h>
+#include <boost/archive/text_oarchive.hpp>
+#include <boost/archive/text_iarchive.hpp>
+#include <sstream>
+#include <iostream>
+#include <cassert>
+
+using namespace std;
+
+typedef dim::core::Bit<double> EOT;
+
+int main(void)
+{
+    // the ring keeps the newest entries, oldest first
+    {
+	dim::core::History<double, 3> h;
+	for (int i = 0; i < 10; ++i) { h.push(i, i * 10); }
+	assert( h.size() == 3 );
+	assert( h[0].island == 7 && h[1].island == 8 && h[2].island == 9 );
+	assert( h.back().fitness == 90 );
+
+	// a smaller limit drops the oldest ones
+	h.push(10, 100, 2);
+	assert( h.size() == 2 );
+	assert( h[0].island == 9 && h[1].island == 10 );
+    }
+
+    // a smaller ring keeps the newest entries of an archive
+    {
+	dim::core::History<double, 8> big;
+	for (int i = 0; i < 6; ++i) { big.push(i, i * 10); }
+
+	stringstream ar;
+	{
+	    boost::archive::text_oarchive oa(ar);
+	    oa << big;
+	}
+	dim::core::History<double, 3> small;
+	{
+	    boost::archive::text_iarchive ia(ar);
+	    ia >> small;
+	}
+	assert( small.size() == 3 );
+	assert( small[0].island == 3 && small[2].island == 5 );
+	assert( small.back().fitness == 50 );
+    }
+
+    // the visits of an individual, counted while it stays in an island
+    {
+	EOT ind(8);
+	ind.setHistorySize(2);
+
+	assert( ind.getLastIsland() == -1 );
+	assert( ind.getLastFitness() == -1 );
+
+	ind.fitness(1);
+	ind.addIsland(0);
+	ind.fitness(2);
+	ind.addIsland(0);
+	assert( ind.getLastIsland() == 0 );
+	assert( ind.getLastIslandCount() == 1 );
+	assert( ind.getLastFitness() == 2 );
+
+	ind.addIsland(1);
+	ind.fitness(3);
+	ind.addIsland(2);
+	assert( ind.getLastIslandsSize() == 2 );
+	assert( ind.getHistory()[0].island == 1 );
+	assert( ind.getLastIsland() == 2 );
+	assert( ind.getLastIslandCount() == 0 );
+	assert( ind.getLastFitness() == 3 );
+
+	// the history travels with the migrants
+	stringstream ar;
+	{
+	    boost::archive::text_oarchive oa(ar);
+	    oa << ind;
+	}
+	EOT copy;
+	{
+	    boost::archive::text_iarchive ia(ar);
+	    ia >> copy;
+	}
+	assert( copy.getLastIslandsSize() == 2 );
+	assert( copy.getHistory()[0].island == 1 );
+	assert( copy.getLastIsland() == 2 );
+	assert( copy.getLastFitness() == 3 );
+
+	// 0 keeps as many islands as the ring can hold
+	ind.setHistorySize(0);
+	for (size_t i = 0; i < 2 * dim::core::History<double>::capacity(); ++i) { ind.addIsland(i); }
+	assert( ind.getLastIslandsSize() == dim::core::History<double>::capacity() );
+    }
+
+    cout << "ok" << endl;
+
+    return 0;
+}
@@ -0,0 +1,120 @@
+#undef NDEBUG
+#include <dim/core/Mailbox.h>
+#include <thread>
+#include <vector>
+#include <iostream>
+#include <cassert>
+
+using namespace std;
+
+struct Migrant
+{
+    Migrant(int v = 0) : value(v), receivedTime(0) {}
+    int value;
+    double receivedTime;
+};
+
+void producer(dim::core::Mailbox<int>& box, size_t id, int n)
+{
+    for (int i = 0; i < n; ++i)
+	{
+	    box.push(i, id);
+	}
+}
+
+int main(void)
+{
+    const size_t P = 8;
+    const int N = 100000;
+
+    // many producers, one consumer, FIFO per producer
+    {
+	dim::core::Mailbox<int> box;
+	vector<thread> producers;
+
+	for (size_t p = 0; p < P; ++p)
+	    {
+		producers.push_back( thread(producer, ref(box), p, N) );
+	    }
+
+	vector<int> last(P, -1);
+	size_t received = 0;
+
+	while ( received < P * N )
+	    {
+		int value;
+		double elapsed;
+		size_t id;
+
+		if ( !box.try_pop(value, elapsed, id) ) { continue; }
+
+		assert( id < P );
+		assert( value == last[id] + 1 );
+		assert( elapsed > 0 );
+		last[id] = value;
+		++received;
+	    }
+
+	for (size_t p = 0; p < P; ++p) { producers[p].join(); }
+
+	assert( box.empty() );
+	assert( box.size() == 0 );
+    }
+
+    // bounded mailbox refuses pushes once full
+    {
+	dim::core::Mailbox<int> box(2);
+	assert( box.push(1) );
+	assert( box.push(2) );
+	assert( !box.push(3) );
+	assert( std::get<0>( box.pop() ) == 1 );
+	assert( box.push(3) );
+	assert( box.size() == 2 );
+    }
+
+    // bulk consume into a population
+    {
+	dim::core::Mailbox<Migrant> box;
+	for (int i = 0; i < 10; ++i) { box.push( Migrant(i), 1 ); }
+
+	vector<Migrant> pop;
+	assert( box.drain_into(pop) == 10 );
+	assert( pop.size() == 10 );
+	for (int i = 0; i < 10; ++i)
+	    {
+		assert( pop[i].value == i );
+		assert( pop[i].receivedTime > 0 );
+	    }
+	assert( box.empty() );
+    }
+
+    // parked consumer is woken up by the producer
+    {
+	dim::core::Mailbox<int> box;
+	box.waitPolicy().strategy( dim::core::WaitPolicy::Park );
+	box.waitPolicy().maxSleep( 1000000 );
+
+	thread p( [&box]() { this_thread::sleep_for( chrono::milliseconds(50) ); box.push(42); } );
+	assert( std::get<0>( box.pop(true) ) == 42 );
+	p.join();
+
+	assert( box.waitPolicy().parks() == 1 );
+	assert( box.waitPolicy().wakes() == 1 );
+    }
+
+    // timed wakeups of a parked consumer do not count as parks
+    {
+	dim::core::Mailbox<int> box;
+	box.waitPolicy().strategy( dim::core::WaitPolicy::Park );
+	box.waitPolicy().maxSleep( 100 );
+
+	thread p( [&box]() { this_thread::sleep_for( chrono::milliseconds(50) ); box.push(42); } );
+	assert( std::get<0>( box.pop(true) ) == 42 );
+	p.join();
+
+	assert( box.waitPolicy().parks() == 1 );
+    }
+
+    cout << "ok" << endl;
+    return 0;
+}
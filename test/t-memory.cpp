@@ -0,0 +1,116 @@
+#undef NDEBUG
+#include <dim/core/Memory.h>
+#include <dim/core/Vector.h>
+#include <dim/core/Pop.h>
+#include <dim/core/IslandData.h>
+#include <thread>
+#include <deque>
+#include <iostream>
+#include <cassert>
+
+using namespace std;
+
+#if defined(DIM_PMR)
+
+namespace memory = dim::core::memory;
+
+// counts what goes through it
+struct Counting : public std::pmr::memory_resource
+{
+    Counting() : allocated(0), deallocated(0) {}
+
+    void* do_allocate(size_t bytes, size_t alignment) { ++allocated; return std::pmr::new_delete_resource()->allocate(bytes, alignment); }
+    void do_deallocate(void* p, size_t bytes, size_t alignment) { ++deallocated; std::pmr::new_delete_resource()->deallocate(p, bytes, alignment); }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept { return this == &other; }
+
+    size_t allocated, deallocated;
+};
+
+typedef dim::core::Vector<double, int> EOT;
+
+#endif
+
+int main(void)
+{
+#if defined(DIM_PMR)
+    // the genes come from the resource of the thread and go back to it whoever frees them
+    {
+	Counting a, b;
+
+	memory::local(&a);
+	EOT* ind = new EOT(1000, 1);
+	assert( a.allocated == 1 );
+
+	memory::local(&b);
+	delete ind;
+	assert( a.deallocated == 1 && b.deallocated == 0 );
+
+	memory::local(NULL);
+    }
+
+    // individuals swapped or moved between islands keep their blocks
+    {
+	Counting a, b;
+	EOT x, y;
+
+	std::thread( [&]() { memory::local(&a); x = EOT(100, 1); } ).join();
+	std::thread( [&]() { memory::local(&b); y = EOT(10, 2); } ).join();
+
+	x.swap(y);
+	assert( x.size() == 10 && y.size() == 100 && y[99] == 1 );
+
+	dim::core::Pop<EOT> pop;
+	pop.push_back(x);
+	pop.clear();
+	x = EOT(); y = EOT();
+
+	assert( a.allocated == a.deallocated && b.allocated == b.deallocated );
+    }
+
+    // the nodes of a mailbox come from the pushing island and go back to it
+    {
+	Counting a, b;
+	dim::core::Mailbox<int> mailbox;
+
+	std::thread( [&]() { memory::local(&a); for (int k = 0; k < 10; ++k) { mailbox.push(k); } } ).join();
+	assert( a.allocated == 10 );
+
+	std::thread( [&]() { memory::local(&b); for (int k = 0; k < 10; ++k) { assert( std::get<0>(mailbox.pop()) == k ); } } ).join();
+	assert( b.allocated == 0 && b.deallocated == 0 );
+	assert( a.deallocated == 9 );
+    }
+
+    // the times and ids of a data queue are kept like its data
+    {
+	Counting a, b;
+
+	memory::local(&a);
+	dim::core::DataQueue<int>* queue = new dim::core::DataQueue<int>;
+	memory::local(&b);
+	std::deque< int, memory::Allocator<int> >* data = new std::deque< int, memory::Allocator<int> >;
+	memory::local(NULL);
+
+	assert( b.allocated > 0 && a.allocated == 3 * b.allocated );
+
+	delete queue;
+	delete data;
+	assert( a.deallocated == a.allocated && b.deallocated == b.allocated );
+    }
+
+    // the islands have their own resources, always the same
+    {
+	memory::arena(1 << 16);
+	assert( memory::island(0) != memory::island(1) );
+	assert( memory::island(1) == memory::island(1) );
+
+	memory::local(memory::island(1));
+	EOT ind(1000, 3);
+	memory::local(NULL);
+	assert( ind[999] == 3 );
+    }
+#endif
+
+    cout << "ok" << endl;
+
+    return 0;
+}
@@ -0,0 +1,86 @@
+#undef NDEBUG
+#include <dim/core/Vector.h>
+#include <dim/core/MigrantPool.h>
+#include <thread>
+#include <vector>
+#include <iostream>
+#include <cassert>
+
+using namespace std;
+
+typedef dim::core::Vector<double, int> EOT;
+typedef dim::core::MigrantPool<EOT> Pool;
+
+EOT make(int id, size_t n)
+{
+    EOT ind(n, id);
+    ind.fitness(id);
+    ind.addIsland(id % 4);
+    return ind;
+}
+
+int main(void)
+{
+    // a migrant comes out as it went in, the sender keeps no gene
+    {
+	Pool pool;
+	EOT ind = make(7, 1000);
+	Pool::Handle h = pool.put(ind);
+	assert( ind.empty() );
+
+	EOT out;
+	pool.take(h, out);
+	assert( out.size() == 1000 && out[999] == 7 );
+	assert( out.fitness() == 7 && out.getLastIsland() == 3 );
+    }
+
+    // freed slots are reused
+    {
+	Pool pool;
+	for (int k = 0; k < 100; ++k)
+	    {
+		EOT ind = make(k, 10), out;
+		pool.take(pool.put(ind), out);
+		assert( out[0] == k );
+	    }
+	assert( pool.capacity() == 1 );
+    }
+
+    // islands putting and taking concurrently neither lose nor mix migrants
+    {
+	Pool pool;
+	const int islands = 4, rounds = 5000;
+	vector<thread> threads;
+
+	for (int rank = 0; rank < islands; ++rank)
+	    {
+		threads.push_back( thread( [&pool, rank]()
+					   {
+					       for (int r = 0; r < rounds; ++r)
+						   {
+						       EOT ind = make(rank * rounds + r, 20), out;
+						       Pool::Handle h = pool.put(ind);
+						       if ( r % 3 ) { pool.take(h, out); assert( out[19] == rank * rounds + r ); }
+						       else
+							   {
+							       EOT other = make(-1, 1);
+							       Pool::Handle g = pool.put(other);
+							       pool.take(h, out);
+							       assert( out[0] == rank * rounds + r );
+							       pool.take(g, out);
+							       assert( out[0] == -1 );
+							   }
+						   }
+					   } ) );
+	    }
+
+	for (size_t k = 0; k < threads.size(); ++k) { threads[k].join(); }
+
+	// at most two slots per island were ever in use at once
+	assert( pool.capacity() <= 2 * islands );
+    }
+
+    cout << "ok" << endl;
+
+    return 0;
+}
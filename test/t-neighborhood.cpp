@@ -0,0 +1,125 @@
+#undef NDEBUG
+
+#include <eo>
+#include <dim/variation/Neighborhood.h>
+#include <dim/variation/BestImprovementKernel.h>
+#include <dim/variation/RelativeBestImprovementKernel.h>
+#include <dim/representation/Route.h>
+#include <dim/core/Random.h>
+#include <vector>
+#include <algorithm>
+#include <iostream>
+#include <fstream>
+#include <cassert>
+#include <cmath>
+
+using namespace std;
+using namespace dim::variation::neighborhood;
+using dim::core::Random;
+
+Random rnd(1);
+
+struct Route : public vector<unsigned>
+{
+    typedef unsigned AtomType;
+};
+
+template <typename R>
+double length(const R& r)
+{
+    double len = 0;
+    for (size_t k = 0; k < r.size(); ++k) { len += distance(r[k], r[(k + 1) % r.size()]); }
+    return len;
+}
+
+// every delta and every row matches the length of the tour after the move
+template <typename Move>
+void check(size_t n)
+{
+    Route r;
+    for (size_t k = 0; k < n; ++k) { r.push_back(k); }
+    for (size_t k = n; k > 1; --k) { swap( r[k-1], r[ rnd.random(k) ] ); }
+
+    Tour tour;
+    tour.load(r, Move::skips);
+    Rows rows(n);
+
+    for (size_t i = 0; i < n; ++i)
+	{
+	    size_t begin = rnd.random(n);
+	    size_t end = begin + rnd.random(n - begin + 1);
+
+	    Move::row(tour, rows, i, begin, end);
+
+	    for (size_t j = 0; j < n; ++j)
+		{
+		    if ( i == j ) { continue; }
+
+		    Route s = r;
+		    Move::apply(s, i, j);
+		    double real = length(s) - length(r);
+
+		    assert( fabs( Move::delta(r, i, j) - real ) < 1e-6 );
+		    if ( begin <= j && j < end ) { assert( fabs( rows.deltas()[j] - real ) < 1e-6 ); }
+		}
+	}
+}
+
+// the kernels apply improving moves only, keeping the fitness the opposite of the tour length
+template <typename Kernel>
+void checkKernel(size_t n)
+{
+    typedef dim::representation::Route<double> EOT;
+
+    EOT sol;
+    for (size_t k = 0; k < n; ++k) { sol.push_back(k); }
+    sol.fitness( -length(sol) );
+
+    eoValueParam<unsigned int> evaluations(0, "evaluations");
+    Kernel kernel(evaluations);
+
+    for (int step = 0; step < 20; ++step)
+	{
+	    double before = sol.fitness();
+	    bool improved = kernel(sol);
+
+	    assert( fabs( sol.fitness() + length(sol) ) < 1e-6 );
+	    assert( improved ? sol.fitness() > before : sol.fitness() == before );
+	}
+}
+
+int main(void)
+{
+    const size_t n = 60;
+
+    ofstream file("t-neighborhood.tsp");
+    file << n << endl;
+    for (size_t k = 0; k < n; ++k) { file << rnd.random(1000) << " " << rnd.random(1000) << endl; }
+    file.close();
+
+    dim::initialization::TSPLibGraph::load("t-neighborhood.tsp", "EUC_2D");
+
+    // the first cities only, the smallest tours are all special cases
+    for (size_t m = 2; m <= n; m = m * 2 + 1)
+	{
+	    for (int rep = 0; rep < 10; ++rep)
+		{
+		    check<Swap>(m);
+		    check<Shift>(m);
+		    check<Inversion>(m);
+		}
+	}
+
+    Random::local(&rnd);
+
+    checkKernel< dim::variation::BestImprovementKernel<dim::representation::Route<double>, Swap> >(n);
+    checkKernel< dim::variation::BestImprovementKernel<dim::representation::Route<double>, Inversion, Neutral> >(n);
+    checkKernel< dim::variation::RelativeBestImprovementKernel<dim::representation::Route<double>, Shift> >(n);
+    checkKernel< dim::variation::RelativeBestImprovementKernel<dim::representation::Route<double>, Inversion> >(n);
+
+    Random::local(NULL);
+
+    cout << "ok" << endl;
+
+    return 0;
+}
@@ -0,0 +1,109 @@
+#undef NDEBUG
+#include <eo>
+#include <dim/core/Bit.h>
+#include <dim/evaluation/NKLandscapes.h>
+#include <dim/variation/BitFlipMove.h>
+#include <dim/core/Random.h>
+#include <vector>
+#include <algorithm>
+#include <iostream>
+#include <cassert>
+#include <fstream>
+#include <cmath>
+
+using namespace std;
+
+typedef dim::core::Bit<double> EOT;
+
+dim::core::Random rnd(1);
+
+// every delta matches the fitness of the flipped solution
+template <typename Value>
+void check(dim::evaluation::NKLandscapes<EOT, Value>& nk, double eps)
+{
+    dim::variation::NKLandscapesBitFlipEval<EOT, Value> flipEval(nk);
+
+    EOT sol(nk.N);
+    for (size_t k = 0; k < sol.size(); ++k) { sol[k] = rnd.flip(); }
+    nk(sol);
+
+    vector<double> neighbours;
+    flipEval.neighbours(sol, neighbours);
+
+    vector< vector<size_t> > candidates;
+
+    for (unsigned b = 0; b < nk.N; ++b)
+	{
+	    EOT s = sol;
+	    s[b] = !s[b];
+	    nk(s);
+
+	    assert( fabs( flipEval.flip(sol, b) - (s.fitness() - sol.fitness()) ) < eps );
+	    assert( fabs( neighbours[b] - (s.fitness() - sol.fitness()) ) < eps );
+
+	    // k distinct flips
+	    vector<size_t> bits(1, b);
+	    while ( bits.size() < 4 )
+		{
+		    size_t c = rnd.random(nk.N);
+		    if ( find(bits.begin(), bits.end(), c) == bits.end() ) { bits.push_back(c); }
+		}
+	    candidates.push_back(bits);
+
+	    s = sol;
+	    for (size_t k = 0; k < bits.size(); ++k) { s[ bits[k] ] = !s[ bits[k] ]; }
+	    nk(s);
+
+	    assert( fabs( flipEval(sol, bits) - (s.fitness() - sol.fitness()) ) < eps );
+	}
+
+    // the batch gives the deltas one by one
+    vector<double> deltas;
+    flipEval(sol, candidates, deltas);
+    for (size_t c = 0; c < candidates.size(); ++c) { assert( fabs( deltas[c] - flipEval(sol, candidates[c]) ) < eps ); }
+}
+
+int main(void)
+{
+    for (unsigned K = 0; K <= 6; K += 2)
+	{
+	    dim::evaluation::NKLandscapes<EOT> random(64, K), consecutive(64, K, true);
+	    check(random, 1e-9);
+	    check(consecutive, 1e-9);
+
+	    dim::evaluation::NKLandscapes<EOT, float> single(64, K);
+	    check(single, 1e-5);
+
+	    // the tables are aligned on cache lines
+	    for (unsigned i = 0; i < random.N; ++i) { assert( size_t(random.table(i)) % 64 == 0 ); }
+
+	    // a saved instance gives the same fitness once loaded
+	    random.save("t-nk-landscapes.txt");
+	    dim::evaluation::NKLandscapes<EOT> loaded("t-nk-landscapes.txt");
+	    EOT a(64, true), b(64, true);
+	    for (size_t k = 0; k < a.size(); k += 3) { a[k] = b[k] = false; }
+	    random(a);
+	    loaded(b);
+	    assert( fabs( a.fitness() - b.fitness() ) < 1e-5 );
+	}
+
+    // an instance linking a bit twice to the same contribution
+    {
+	const unsigned N = 16, K = 2;
+	ofstream file("t-nk-landscapes-twice.txt");
+	file << "p NK " << N << " " << K << endl << "p links" << endl;
+	for (unsigned i = 0; i < N; ++i) { file << i << endl; }
+	for (unsigned i = 0; i < N; ++i) { file << ( i % 2 ? i : (i + 1) % N ) << endl; }
+	for (unsigned i = 0; i < N; ++i) { file << (i + 1) % N << endl; }
+	file << "p tables" << endl;
+	for (unsigned j = 0; j < (1u << (K+1)) * N; ++j) { file << rnd.uniform() << endl; }
+	file.close();
+
+	dim::evaluation::NKLandscapes<EOT> twice("t-nk-landscapes-twice.txt");
+	check(twice, 1e-9);
+    }
+
+    cout << "ok" << endl;
+
+    return 0;
+}
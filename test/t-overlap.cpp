@@ -0,0 +1,203 @@
+#undef NDEBUG
+#include <eo>
+#include <dim/core/core>
+#include <dim/representation/Route.h>
+#include <dim/migrator/Easy.h>
+#include <dim/feedbacker/Easy.h>
+#include <dim/algo/Easy.h>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <cassert>
+
+using namespace std;
+using namespace dim::core;
+
+typedef dim::representation::Route<double> EOT;
+
+const int M = 10;
+
+// the individuals of an island, coming from the island before it in the ring
+void fill(Pop<EOT>& pop, int rank, int size)
+{
+    for (int k = 0; k < M; ++k)
+	{
+	    EOT ind;
+	    ind.push_back(rank);
+	    ind.push_back(k);
+	    ind.fitness(k);
+	    ind.addIsland( (rank + size - 1) % size );
+	    ind.fitness(k + rank + 1);
+	    pop.push_back(ind);
+	}
+}
+
+// what the operators of the loop did, in order
+string events;
+
+// counts the generations, up to n calls
+struct Generations : public dim::continuator::Base<EOT>
+{
+    Generations(int n) : n(n), calls(0) {}
+    bool operator()(const Pop<EOT>&) { return ++calls < n; }
+    int n, calls;
+};
+
+// counts the evolutions of each individual in its second gene
+struct Evolver : public dim::evolver::Base<EOT>
+{
+    void operator()(Pop<EOT>& pop, IslandData<EOT>&)
+    {
+	for (size_t i = 0; i < pop.size(); ++i) { ++pop[i][1]; }
+	events += 'e';
+    }
+};
+
+struct Feedbacker : public dim::feedbacker::sync::Easy<EOT>
+{
+    void post(Pop<EOT>& pop, IslandData<EOT>& data) { events += 'p'; dim::feedbacker::sync::Easy<EOT>::post(pop, data); }
+    void wait(Pop<EOT>& pop, IslandData<EOT>& data) { events += 'w'; dim::feedbacker::sync::Easy<EOT>::wait(pop, data); }
+};
+
+struct Migrator : public dim::migrator::sync::Easy<EOT>
+{
+    void post(Pop<EOT>& pop, IslandData<EOT>& data) { events += 'P'; dim::migrator::sync::Easy<EOT>::post(pop, data); }
+    void wait(Pop<EOT>& arrivals, IslandData<EOT>& data) { events += 'W'; dim::migrator::sync::Easy<EOT>::wait(arrivals, data); }
+};
+
+// a migrator without post/wait split, migrating nobody
+struct AtOnce : public dim::migrator::Base<EOT>
+{
+    void operator()(Pop<EOT>& pop, IslandData<EOT>&) { pop.setInputSize(7); }
+};
+
+struct Updater : public dim::vectorupdater::Base<EOT> { void operator()(Pop<EOT>&, IslandData<EOT>&) {} };
+struct Memorizer : public dim::memorizer::Base<EOT> { void firstCall(Pop<EOT>&, IslandData<EOT>&) {} void operator()(Pop<EOT>&, IslandData<EOT>&) {} };
+
+int main(int argc, char** argv)
+{
+    boost::mpi::environment env(argc, argv);
+    boost::mpi::communicator world;
+
+    const int rank = world.rank(), size = world.size();
+    const int next = (rank + 1) % size, previous = (rank + size - 1) % size;
+
+    for (int g = 0; g < 3; ++g)
+	{
+	    Pop<EOT> pop, same;
+	    fill(pop, rank, size);
+	    fill(same, rank, size);
+
+	    // every individual goes to the next island
+	    IslandData<EOT> data(size, rank), blocking(size, rank);
+	    data.proba.assign(size, 0);
+	    data.proba[next] = 1000;
+
+	    // the split feedbacks are the blocking ones
+	    dim::feedbacker::sync::Easy<EOT> feedbacker, reference;
+	    dim::migrator::sync::Easy<EOT> migrator;
+	    feedbacker.size(size); feedbacker.rank(rank);
+	    reference.size(size); reference.rank(rank);
+	    migrator.size(size); migrator.rank(rank);
+
+	    reference(same, blocking);
+
+	    // both exchanges in flight together, the way the overlapped loop of algo::Easy posts them
+	    feedbacker.post(pop, data);
+	    migrator.post(pop, data);
+
+	    // only the residents are left to evolve meanwhile
+	    assert( pop.size() == size_t( size > 1 ? 0 : M ) );
+	    assert( pop.getOutputSize() == size_t(M) );
+
+	    Pop<EOT> arrivals;
+	    feedbacker.wait(pop, data);
+	    migrator.wait(arrivals, data);
+
+	    for (int i = 0; i < size; ++i) { assert( data.feedbacks[i] == blocking.feedbacks[i] ); }
+
+	    // the migrants of the island before, in order
+	    assert( arrivals.size() == size_t( size > 1 ? M : 0 ) );
+	    for (size_t k = 0; k < arrivals.size(); ++k)
+		{
+		    assert( arrivals[k][0] == unsigned(previous) && arrivals[k][1] == k );
+		    assert( arrivals[k].fitness() == k + previous + 1 );
+		}
+	}
+
+    // the overlapped loop of algo::Easy
+    {
+	Pop<EOT> pop;
+	for (int k = 0; k < M; ++k)
+	    {
+		EOT ind;
+		ind.push_back(rank);
+		ind.push_back(0);
+		ind.fitness(k);
+		ind.addIsland(rank);
+		pop.push_back(ind);
+	    }
+
+	IslandData<EOT> data(size, rank);
+	data.proba.assign(size, 1000 / size);
+	data.proba[rank] += 1000 % size;
+
+	Evolver evolver;
+	Feedbacker feedbacker;
+	Migrator migrator;
+	Updater updater;
+	Memorizer memorizer;
+	feedbacker.size(size); feedbacker.rank(rank);
+	migrator.size(size); migrator.rank(rank);
+
+	Generations generations(4);
+	dim::utils::CheckPoint<EOT> checkpoint(generations);
+
+	dim::algo::Easy<EOT> algo(evolver, feedbacker, updater, memorizer, migrator, checkpoint);
+	algo.overlap(true);
+
+	events.clear();
+	algo(pop, data);
+
+	// the residents evolve before the exchanges of the previous generation complete,
+	// the immigrants then, and the last exchanges are completed after the loop
+	assert( events == "epP" "ewWepP" "ewWepP" "wW" );
+
+	// every individual evolved once a generation, wherever it went, and nobody is lost
+	for (size_t i = 0; i < pop.size(); ++i) { assert( pop[i][1] == 3 ); }
+	int total = 0;
+	boost::mpi::all_reduce( world, int(pop.size()), total, std::plus<int>() );
+	assert( total == size * M );
+	assert( pop.getInputSize() <= pop.size() );
+    }
+
+    // a migrator migrating at once keeps its input size
+    {
+	Pop<EOT> pop;
+	fill(pop, rank, size);
+	IslandData<EOT> data(size, rank);
+
+	Evolver evolver;
+	dim::feedbacker::sync::Easy<EOT> feedbacker;
+	AtOnce migrator;
+	Updater updater;
+	Memorizer memorizer;
+	feedbacker.size(size); feedbacker.rank(rank);
+
+	Generations generations(3);
+	dim::utils::CheckPoint<EOT> checkpoint(generations);
+
+	dim::algo::Easy<EOT> algo(evolver, feedbacker, updater, memorizer, migrator, checkpoint);
+	algo.overlap(true);
+	algo(pop, data);
+
+	assert( pop.size() == size_t(M) );
+	assert( pop.getInputSize() == 7 );
+    }
+
+    world.barrier();
+
+    if ( 0 == rank ) { cout << "ok" << endl; }
+
+    return 0;
+}
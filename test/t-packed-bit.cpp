@@ -0,0 +1,123 @@
+#undef NDEBUG
+
+#include <dim/core/PackedBit.h>
+#include <dim/evaluation/OneMax.h>
+#include <dim/variation/PackedBitFlip.h>
+#include <dim/core/Random.h>
+#include <boost/archive/text_oarchive.hpp>
+#include <boost/archive/text_iarchive.hpp>
+#include <vector>
+#include <sstream>
+#include <iostream>
+#include <cassert>
+
+using namespace std;
+
+typedef dim::core::PackedBit<double> EOT;
+
+// the packed string and a reference vector<bool> hold the same bits
+void same(const EOT& sol, const vector<bool>& ref)
+{
+    assert( sol.size() == ref.size() );
+    size_t ones = 0;
+    for (size_t i = 0; i < ref.size(); ++i) { assert( sol[i] == ref[i] ); ones += ref[i]; }
+    assert( sol.count() == ones );
+}
+
+int main(void)
+{
+    dim::core::Random rnd(1);
+
+    // sizes around the words and the vector blocks
+    size_t sizes[] = {0, 1, 63, 64, 65, 255, 256, 257, 1000};
+
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s)
+	{
+	    const size_t n = sizes[s];
+
+	    EOT a(n), b(n, true);
+	    vector<bool> ra(n, false), rb(n, true);
+	    same(a, ra);
+	    same(b, rb);
+
+	    for (size_t k = 0; k < 2 * n; ++k)
+		{
+		    size_t i = rnd.random(n);
+		    a[i] = !a[i]; ra[i] = !ra[i];
+		    size_t j = rnd.random(n);
+		    b.flip(j); rb[j] = !rb[j];
+		}
+	    same(a, ra);
+	    same(b, rb);
+
+	    size_t diff = 0;
+	    for (size_t i = 0; i < n; ++i) { diff += ra[i] != rb[i]; }
+	    assert( a.hamming(b) == diff );
+
+	    // growing with ones keeps the old bits
+	    a.resize(n + 70, true);
+	    ra.resize(n + 70, true);
+	    same(a, ra);
+
+	    // shrinking clears the bits past the end
+	    a.resize(n / 2);
+	    ra.resize(n / 2);
+	    same(a, ra);
+	    a.resize(n);
+	    ra.resize(n, false);
+	    same(a, ra);
+
+	    // printing and reading give the same string
+	    a.fitness(1);
+	    stringstream ss;
+	    a.printOn(ss);
+	    EOT c;
+	    c.readFrom(ss);
+	    same(c, ra);
+
+	    // serialization too
+	    stringstream ar;
+	    {
+		boost::archive::text_oarchive oa(ar);
+		oa << a;
+	    }
+	    EOT d;
+	    {
+		boost::archive::text_iarchive ia(ar);
+		ia >> d;
+	    }
+	    same(d, ra);
+
+	    dim::evaluation::OneMax<EOT> eval;
+	    eval(b);
+	    assert( b.fitness() == b.count() );
+	}
+
+    // the operators flip the expected number of bits and nothing past the end
+    {
+	EOT sol(1000), before = sol;
+
+	dim::variation::PackedDetBitFlip<EOT> kflip(7);
+	kflip(sol);
+	assert( sol.hamming(before) == 7 );
+
+	dim::variation::PackedBitMutation<EOT> all(1);
+	EOT tail(100);
+	all(tail);
+	assert( tail.count() == 100 );
+	assert( tail.words()[1] == tail.tailMask() );
+
+	// about rate * size bits flipped
+	dim::core::Random random(3);
+	dim::core::Random::local(&random);
+	dim::variation::PackedBitMutation<EOT> some(0.01);
+	EOT many(10000);
+	some(many);
+	assert( many.count() > 50 && many.count() < 170 );
+	dim::core::Random::local(NULL);
+    }
+
+    cout << "ok" << endl;
+
+    return 0;
+}
@@ -0,0 +1,103 @@
+#undef NDEBUG
+#include <eo>
+#include <dim/core/Bit.h>
+#include <dim/core/Pop.h>
+#include <dim/core/IslandData.h>
+#include <dim/evolver/Parallel.h>
+#include <dim/evaluation/OneMax.h>
+#include <vector>
+#include <algorithm>
+#include <iostream>
+#include <cassert>
+
+using namespace std;
+
+typedef dim::core::Bit<double> B;
+
+// flips one bit drawn from the generator of the calling thread
+struct Flip : public eoMonOp<B>
+{
+    bool operator()(B& b)
+    {
+	size_t i = dim::core::Random::local().random(b.size());
+	b[i] = !b[i];
+	return true;
+    }
+};
+
+// marks the chunks run by a thread with a generator bound to it
+struct Bound
+{
+    Bound(size_t chunks) : bound(chunks, 0) {}
+    void operator()(size_t chunk) { bound[chunk] = dim::core::Random::localBinding() != NULL; }
+    vector<int> bound;
+};
+
+// evolves an island with the given parts and pool, and returns its population
+dim::core::Pop<B> evolve(size_t parts, dim::core::ThreadPool* pool, size_t& evaluations)
+{
+    dim::evaluation::OneMax<B> onemax;
+    eoEvalFuncCounter<B> counter(onemax);
+
+    vector< dim::evaluation::OneMax<B> > evals(parts);
+    vector<Flip> flips(parts);
+    vector< eoEvalFunc<B>* > ptEvals;
+    vector< eoMonOp<B>* > ptOps;
+    for (size_t p = 0; p < parts; ++p) { ptEvals.push_back(&evals[p]); ptOps.push_back(&flips[p]); }
+
+    dim::core::Pop<B> pop;
+    for (size_t i = 0; i < 37; ++i)
+	{
+	    B b(64, false);
+	    onemax(b);
+	    pop.push_back(b);
+	}
+
+    dim::core::IslandData<B> data(1, 0);
+    dim::evolver::Parallel<B> evolver(counter, ptEvals, ptOps, pool, true, 3);
+    evolver.firstCall(pop, data);
+
+    for (int g = 0; g < 20; ++g) { evolver(pop, data); }
+
+    evaluations = counter.value();
+    return pop;
+}
+
+int main(void)
+{
+    dim::core::Random::master(3);
+
+    size_t sequential, parallel;
+    dim::core::Pop<B> a = evolve(4, NULL, sequential);
+
+    // the same parts give the same population whatever the pool
+    dim::core::ThreadPool pool(3);
+    for (int rep = 0; rep < 5; ++rep)
+	{
+	    dim::core::Pop<B> b = evolve(4, &pool, parallel);
+
+	    assert( parallel == sequential );
+	    for (size_t i = 0; i < a.size(); ++i)
+		{
+		    assert( a[i] == b[i] );
+		    assert( a[i].fitness() == b[i].fitness() );
+		}
+	}
+
+    // the threads are left without a binding, as they were before evolving
+    {
+	Bound bound(64);
+	pool.run(bound, bound.bound.size());
+	assert( std::count(bound.bound.begin(), bound.bound.end(), 1) == 0 );
+    }
+
+    // every candidate is counted once by the counter of the island
+    assert( sequential == 37 * 3 * 20 );
+
+    // and the individuals only improve
+    for (size_t i = 0; i < a.size(); ++i) { assert( a[i].fitness() > 0 && a[i].fitness() <= 60 ); }
+
+    cout << "ok" << endl;
+
+    return 0;
+}
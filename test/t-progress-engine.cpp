@@ -0,0 +1,177 @@
+#undef NDEBUG
+#include <eo>
+#include <dim/core/core>
+#include <dim/representation/Route.h>
+#include <thread>
+#include <iostream>
+#include <cassert>
+
+using namespace std;
+using namespace dim::core;
+
+typedef dim::representation::Route<double> EOT;
+
+const int N = 100;
+
+// an island sending N migrants and N feedbacks to every other rank, flushing them and stopping once it got them all back
+struct Island : public Thread<EOT>
+{
+    void operator()(Pop<EOT>& /*pop*/, IslandData<EOT>& data)
+    {
+	boost::mpi::communicator world;
+
+	for (int k = 0; k < N; ++k)
+	    {
+		for (int peer = 0; peer < world.size(); ++peer)
+		    {
+			if ( peer == world.rank() ) { continue; }
+			EOT ind;
+			ind.push_back(k);
+			data.migratorSendingQueue.push(ind, peer);
+			data.feedbackerSendingQueue.push(k, peer);
+		    }
+	    }
+
+	ProgressEngine<EOT>::shared().flush();
+
+	// messages from the same peer arrive in order
+	vector<int> migrants(world.size(), 0), feedbacks(world.size(), 0);
+	int left = 2 * N * ( world.size() - 1 );
+
+	while ( left )
+	    {
+		EOT ind;
+		double fit, time;
+		size_t from;
+
+		if ( data.migratorReceivingQueue.try_pop(ind, time, from) ) { assert( ind[0] == migrants[from]++ ); --left; }
+		if ( data.feedbackerReceivingQueue.try_pop(fit, time, from) ) { assert( fit == feedbacks[from]++ ); --left; }
+	    }
+
+	data.toContinue = false;
+    }
+};
+
+// an island of rank 0 stopping at once, the others queueing big migrants for it later on and stopping without a flush
+struct Late : public Thread<EOT>
+{
+    void operator()(Pop<EOT>& /*pop*/, IslandData<EOT>& data)
+    {
+	boost::mpi::communicator world;
+
+	if ( world.rank() != 0 )
+	    {
+		this_thread::sleep_for( chrono::milliseconds(100) );
+
+		for (int k = 0; k < N; ++k)
+		    {
+			EOT ind;
+			ind.assign(10000, k);
+			data.migratorSendingQueue.push(ind, 0);
+		    }
+	    }
+
+	data.toContinue = false;
+    }
+};
+
+// the thread run by the caller of the runner
+struct Main : public Thread<EOT>
+{
+    void operator()(Pop<EOT>& /*pop*/, IslandData<EOT>& /*data*/) { id = this_thread::get_id(); }
+    thread::id id;
+};
+
+int main(int argc, char** argv)
+{
+    boost::mpi::environment env(argc, argv, boost::mpi::threading::funneled, true);
+    boost::mpi::communicator world;
+
+    Pop<EOT> pop;
+
+    // only one thread runs on the caller
+    {
+	IslandData<EOT> data(world.size(), world.rank());
+	ThreadsRunner<EOT> tr;
+	Main a, b;
+	tr.main(a).main(a);
+
+	bool thrown = false;
+	try { tr.main(b); } catch (std::runtime_error&) { thrown = true; }
+	assert( thrown );
+
+	tr(pop, data);
+	assert( a.id == this_thread::get_id() );
+    }
+
+    ProgressEngine<EOT>& engine = ProgressEngine<EOT>::shared();
+    const size_t peers = world.size() - 1;
+
+    // migrants and feedbacks go through the engine, on the main thread, coalesced until the flush
+    {
+	IslandData<EOT> data(world.size(), world.rank());
+	ThreadsRunner<EOT> tr;
+	Island island;
+	tr.add(island);
+
+	engine.maxPacket(10 * N);
+	engine.maxDelay(60000000);
+	engine.serve(ProgressEngine<EOT>::Migrants, tr);
+	engine.serve(ProgressEngine<EOT>::Feedbacks, tr);
+
+	tr(pop, data);
+
+	assert( engine.packets() == peers );
+	if ( peers ) { assert( engine.packetSize() == 2 * N ); }
+	assert( engine.inFlight() == 0 );
+    }
+
+    // nothing of the next run reaches the data of this one
+    world.barrier();
+
+    // a packet is sent as soon as it is full
+    {
+	IslandData<EOT> data(world.size(), world.rank());
+	ThreadsRunner<EOT> tr;
+	Island island;
+	tr.add(island);
+
+	engine.maxPacket(1);
+	engine.serve(ProgressEngine<EOT>::Migrants, tr);
+
+	tr(pop, data);
+
+	assert( engine.packets() == peers + 2 * N * peers );
+	assert( engine.inFlight() == 0 );
+    }
+
+    world.barrier();
+
+    // what is queued at stop is sent, and a rank stopping first receives it whatever its size
+    {
+	IslandData<EOT> data(world.size(), world.rank());
+	ThreadsRunner<EOT> tr;
+	Late island;
+	tr.add(island);
+
+	engine.maxPacket(10 * N);
+	engine.serve(ProgressEngine<EOT>::Migrants, tr);
+
+	tr(pop, data);
+
+	EOT ind;
+	double time;
+	size_t from;
+	vector<int> migrants(world.size(), 0);
+	while ( data.migratorReceivingQueue.try_pop(ind, time, from) ) { assert( ind.size() == 10000 && ind[0] == migrants[from]++ ); }
+
+	for (int i = 0; i < world.size(); ++i) { assert( migrants[i] == ( world.rank() == 0 && i != 0 ? N : 0 ) ); }
+	assert( engine.inFlight() == 0 );
+    }
+
+    world.barrier();
+
+    if ( 0 == world.rank() ) { cout << "ok" << endl; }
+
+    return 0;
+}
@@ -0,0 +1,108 @@
+#undef NDEBUG
+
+#include <dim/core/Random.h>
+#include <thread>
+#include <vector>
+#include <iostream>
+#include <cassert>
+
+using namespace std;
+using dim::core::Random;
+
+// a thread bound to its own generator draws the same values as the generator alone
+void island(Random* random, vector<unsigned>* out)
+{
+    assert( !Random::localBinding() );
+    Random::local(random);
+    assert( Random::localBinding() == random );
+    for (size_t k = 0; k < out->size(); ++k) { (*out)[k] = Random::local().random(1000); }
+    Random::local(NULL);
+    assert( !Random::localBinding() );
+}
+
+// a thread named (group, index) draws from its own generator
+void named(Random::uint64 group, Random::uint64 index, vector<unsigned>* out)
+{
+    Random::local(group, index);
+    for (size_t k = 0; k < out->size(); ++k) { (*out)[k] = Random::local().random(1000); }
+}
+
+int main(void)
+{
+    // same seed and stream, same sequence
+    {
+	Random a(42, 3), b(42, 3);
+	for (int k = 0; k < 1000; ++k) { assert( a.next() == b.next() ); }
+    }
+
+    // different streams do not overlap
+    {
+	Random a(42, 0), b(42, 1);
+	int same = 0;
+	for (int k = 0; k < 1000; ++k) { same += a.next() == b.next(); }
+	assert( same == 0 );
+    }
+
+    // the bulk fills give the scalar sequence, whatever the offset in the buffer
+    for (size_t skip = 0; skip < Random::lanes; ++skip)
+	{
+	    Random a(7), b(7);
+	    for (size_t k = 0; k < skip; ++k) { a.next(); b.next(); }
+
+	    vector<Random::uint32> ints(37);
+	    a.fill(&ints[0], ints.size(), 100);
+	    for (size_t k = 0; k < ints.size(); ++k) { assert( ints[k] == b.random(100) ); }
+
+	    vector<double> reals(41);
+	    a.fill(&reals[0], reals.size());
+	    for (size_t k = 0; k < reals.size(); ++k) { assert( reals[k] == b.uniform() ); }
+	}
+
+    // ranges and mean
+    {
+	Random r(1);
+	double sum = 0;
+	const int n = 100000;
+	for (int k = 0; k < n; ++k)
+	    {
+		double u = r.uniform();
+		assert( 0 <= u && u < 1 );
+		assert( r.random(10) < 10 );
+		sum += u;
+	    }
+	assert( sum / n > 0.49 && sum / n < 0.51 );
+    }
+
+    // islands drawing in parallel are reproducible
+    {
+	Random g0(5, 0), g1(5, 1), r0(5, 0), r1(5, 1);
+	vector<unsigned> v0(10000), v1(10000);
+
+	thread t0(island, &g0, &v0), t1(island, &g1, &v1);
+	t0.join(); t1.join();
+
+	for (size_t k = 0; k < v0.size(); ++k)
+	    {
+		assert( v0[k] == r0.random(1000) );
+		assert( v1[k] == r1.random(1000) );
+	    }
+    }
+
+    // named threads draw the same numbers whatever the order they start in
+    {
+	vector<unsigned> a0(1000), a1(1000), b0(1000), b1(1000), c(1000);
+
+	thread t0(named, 3, 0, &a0); t0.join();
+	thread t1(named, 3, 1, &a1); t1.join();
+	thread u1(named, 3, 1, &b1); u1.join();
+	thread u0(named, 3, 0, &b0); u0.join();
+	thread v(named, 4, 0, &c); v.join();
+
+	assert( a0 == b0 && a1 == b1 );
+	assert( a0 != a1 && a0 != c );
+    }
+
+    cout << "ok" << endl;
+
+    return 0;
+}
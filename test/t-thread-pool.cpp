@@ -0,0 +1,82 @@
+#undef NDEBUG
+#include <dim/core/ThreadPool.h>
+#include <thread>
+#include <vector>
+#include <iostream>
+#include <cassert>
+
+using namespace std;
+
+struct Sum
+{
+    Sum(size_t chunks) : partial(chunks, 0) {}
+
+    void operator()(size_t chunk)
+    {
+	// chunk k sums the integers of [k*1000, (k+1)*1000)
+	for (size_t x = chunk * 1000; x < (chunk + 1) * 1000; ++x) { partial[chunk] += x; }
+    }
+
+    size_t total() const
+    {
+	size_t s = 0;
+	for (size_t k = 0; k < partial.size(); ++k) { s += partial[k]; }
+	return s;
+    }
+
+    vector<size_t> partial;
+};
+
+/// sum of the integers of [0, n)
+size_t triangle(size_t n) { return n * (n - 1) / 2; }
+
+void island(dim::core::ThreadPool& pool, size_t runs)
+{
+    for (size_t r = 0; r < runs; ++r)
+	{
+	    Sum sum(64);
+	    pool.run(sum, 64);
+	    assert( sum.total() == triangle(64000) );
+	}
+}
+
+int main(void)
+{
+    // without worker, the caller runs every chunk
+    {
+	dim::core::ThreadPool pool;
+	assert( pool.size() == 0 );
+	assert( pool.concurrency() == 1 );
+
+	Sum sum(10);
+	pool.run(sum, 10);
+	assert( sum.total() == triangle(10000) );
+
+	pool.run(sum, 0);
+    }
+
+    // timings of a run
+    {
+	dim::core::ThreadPool pool(3);
+	dim::core::ThreadPool::Stats stats;
+
+	Sum sum(100);
+	pool.run(sum, 100, &stats);
+	assert( sum.total() == triangle(100000) );
+	assert( stats.threads == 4 );
+	assert( stats.wall >= 0 && stats.busy >= 0 );
+	assert( stats.efficiency() >= 0 );
+    }
+
+    // several islands share the pool
+    {
+	dim::core::ThreadPool pool(4);
+	vector<thread> islands;
+
+	for (size_t k = 0; k < 8; ++k) { islands.push_back( thread(island, ref(pool), 200) ); }
+	for (size_t k = 0; k < islands.size(); ++k) { islands[k].join(); }
+    }
+
+    cout << "ok" << endl;
+    return 0;
+}
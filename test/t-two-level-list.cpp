@@ -0,0 +1,90 @@
+#undef NDEBUG
+#include <dim/representation/TwoLevelList.h>
+#include <vector>
+#include <algorithm>
+#include <iostream>
+#include <cassert>
+#include <cstdlib>
+#include <cmath>
+
+using namespace std;
+
+static vector<double> X, Y;
+
+double distance(unsigned a, unsigned b)
+{
+    return sqrt( (X[a]-X[b])*(X[a]-X[b]) + (Y[a]-Y[b])*(Y[a]-Y[b]) );
+}
+
+// reference: reverse the cities from position i to position j going forward
+void reverseArray(vector<unsigned>& tour, size_t i, size_t j)
+{
+    size_t n = tour.size();
+    size_t len = (j + n - i) % n + 1;
+    for (size_t k = 0; k < len / 2; ++k)
+	{
+	    swap( tour[(i + k) % n], tour[(j + n - k) % n] );
+	}
+}
+
+// same cycle, whatever the starting city and the direction
+bool sameCycle(const vector<unsigned>& a, const vector<unsigned>& b)
+{
+    size_t n = a.size();
+    size_t s = find(b.begin(), b.end(), a[0]) - b.begin();
+    bool forward = true, backward = true;
+    for (size_t k = 0; k < n; ++k)
+	{
+	    if ( a[k] != b[(s + k) % n] ) { forward = false; }
+	    if ( a[k] != b[(s + n - k) % n] ) { backward = false; }
+	}
+    return forward || backward;
+}
+
+int main(void)
+{
+    srand(1);
+
+    for (size_t n = 1; n <= 4000; n = n * 3 + 1)
+	{
+	    X.resize(n); Y.resize(n);
+	    for (size_t i = 0; i < n; ++i) { X[i] = rand() % 1000; Y[i] = rand() % 1000; }
+
+	    vector<unsigned> tour(n);
+	    for (size_t i = 0; i < n; ++i) { tour[i] = i; }
+	    random_shuffle(tour.begin(), tour.end());
+
+	    dim::representation::TwoLevelList list(distance);
+	    list.build(tour);
+
+	    for (int move = 0; move < 2000; ++move)
+		{
+		    // the reference follows the direction of the list
+		    list.toRoute(tour);
+
+		    size_t i = rand() % n, j = rand() % n;
+		    unsigned a = tour[i], b = tour[j];
+
+		    reverseArray(tour, i, j);
+		    list.reverse(a, b);
+
+		    vector<unsigned> current;
+		    list.toRoute(current);
+		    assert( sameCycle(tour, current) );
+
+		    for (size_t k = 0; k < n; ++k)
+			{
+			    unsigned c = current[k];
+			    assert( list.position(c) == k );
+			    assert( list.next(c) == current[(k + 1) % n] );
+			    assert( list.prev(c) == current[(k + n - 1) % n] );
+			    assert( fabs( list.nextCost(c) - distance(c, list.next(c)) ) < 1e-9 );
+			}
+
+		    assert( list.segments() <= 2 * n + 2 );
+		}
+	}
+
+    cout << "ok" << endl;
+    return 0;
+}
@@ -0,0 +1,222 @@
+#undef NDEBUG
+#include <dim/core/Bit.h>
+#include <dim/core/PackedBit.h>
+#include <dim/core/Pop.h>
+#include <dim/core/Wire.h>
+#include <dim/core/Random.h>
+#include <dim/representation/Route.h>
+#include <boost/mpi.hpp>
+#include <vector>
+#include <iostream>
+#include <cassert>
+
+using namespace std;
+using namespace dim::core;
+
+typedef Bit<double> BitEOT;
+typedef PackedBit<double> PackedEOT;
+typedef dim::representation::Route<double> RouteEOT;
+typedef Vector<double, double> RealEOT;
+
+// an individual with every field of the header set
+template <class EOT>
+void decorate(EOT& ind, int seed)
+{
+    ind.fitness(seed * 1.5);
+    ind.hash(seed * 0x9e3779b97f4a7c15ULL);
+    ind.receivedTime = seed + 0.25;
+    ind.setHistorySize(0);
+    for (int i = 0; i < seed % 7; ++i) { ind.addIsland(i % 3); }
+}
+
+template <class EOT>
+void same(const EOT& a, const EOT& b)
+{
+    assert( a.size() == b.size() );
+    for (size_t i = 0; i < a.size(); ++i) { assert( a[i] == b[i] ); }
+
+    assert( a.invalid() == b.invalid() );
+    if ( !a.invalid() ) { assert( a.fitness() == b.fitness() ); }
+    assert( a.hashed() == b.hashed() );
+    if ( a.hashed() ) { assert( a.hash() == b.hash() ); }
+    assert( a.receivedTime == b.receivedTime );
+
+    assert( a.getHistory().size() == b.getHistory().size() );
+    for (size_t i = 0; i < a.getHistory().size(); ++i)
+	{
+	    assert( a.getHistory()[i].island == b.getHistory()[i].island );
+	    assert( a.getHistory()[i].count == b.getHistory()[i].count );
+	    assert( a.getHistory()[i].fitness == b.getHistory()[i].fitness );
+	}
+}
+
+// an individual read back from its bytes is the same, and takes the announced size
+template <class EOT>
+void roundTrip(const EOT& ind)
+{
+    vector<char> bytes( wire::size(ind) );
+    assert( wire::write(ind, &bytes[0]) == &bytes[0] + bytes.size() );
+
+    EOT copy;
+    assert( wire::read(copy, &bytes[0]) == &bytes[0] + bytes.size() );
+    same(ind, copy);
+}
+
+// a population sent through a boost::mpi archive
+template <class EOT>
+void archive(const Pop<EOT>& pop)
+{
+    boost::mpi::communicator world;
+
+    boost::mpi::packed_oarchive oa(world);
+    oa << pop;
+
+    boost::mpi::packed_iarchive ia(world);
+    ia.resize( oa.size() );
+    std::copy( (const char*)oa.address(), (const char*)oa.address() + oa.size(), (char*)ia.address() );
+
+    Pop<EOT> copy;
+    ia >> copy;
+
+    assert( copy.size() == pop.size() );
+    for (size_t i = 0; i < pop.size(); ++i) { same(pop[i], copy[i]); }
+}
+
+int main(int argc, char** argv)
+{
+    boost::mpi::environment env(argc, argv);
+
+    Random random(1);
+
+    assert( wire::Encoded<BitEOT>::value );
+    assert( wire::Encoded<PackedEOT>::value );
+    assert( wire::Encoded<RouteEOT>::value );
+    assert( !wire::Encoded<int>::value );
+
+    // bits packed in words, whatever the tail
+    for (size_t n = 0; n < 200; n += 13)
+	{
+	    BitEOT b(n);
+	    PackedEOT p(n);
+	    for (size_t i = 0; i < n; ++i) { b[i] = random.flip(); p[i] = b[i]; }
+	    decorate(b, n);
+	    decorate(p, n);
+
+	    assert( wire::size(b) == wire::header<BitEOT>() + (n + 63) / 64 * 8 );
+	    assert( wire::size(p) == wire::size(b) );
+
+	    roundTrip(b);
+	    roundTrip(p);
+	}
+
+    // cities on 16 bits while they fit, on 32 bits beyond
+    {
+	RouteEOT r;
+	for (unsigned i = 0; i < 100; ++i) { r.push_back(i * 600); }
+	decorate(r, 3);
+	assert( wire::size(r) == wire::header<RouteEOT>() + 2 * r.size() );
+	roundTrip(r);
+
+	r.push_back(70000);
+	assert( wire::size(r) == wire::header<RouteEOT>() + 4 * r.size() );
+	roundTrip(r);
+
+	// nothing known of a fresh individual
+	RouteEOT fresh(5);
+	roundTrip(fresh);
+    }
+
+    // raw genes
+    {
+	RealEOT x(10);
+	for (size_t i = 0; i < x.size(); ++i) { x[i] = i / 3.; }
+	decorate(x, 5);
+	roundTrip(x);
+    }
+
+    // populations
+    {
+	Pop<RouteEOT> routes;
+	Pop<PackedEOT> bits;
+	for (int k = 0; k < 20; ++k)
+	    {
+		RouteEOT r;
+		for (unsigned i = 0; i < 50; ++i) { r.push_back( random.random(1000) ); }
+		if ( k % 2 ) { decorate(r, k); }
+		routes.push_back(r);
+
+		PackedEOT p(130);
+		for (size_t i = 0; i < p.size(); ++i) { p[i] = random.flip(); }
+		decorate(p, k);
+		bits.push_back(p);
+	    }
+
+	archive(routes);
+	archive(bits);
+	archive( Pop<RouteEOT>() );
+    }
+
+    // the genes are only read by a representation of the same width
+    {
+	RealEOT x(4);
+	vector<char> bytes( wire::size(x) );
+	wire::write(x, &bytes[0]);
+
+	Vector<double, float> narrower;
+	bool thrown = false;
+	try { wire::read(narrower, &bytes[0]); } catch (std::runtime_error&) { thrown = true; }
+	assert( thrown );
+
+	BitEOT b;
+	thrown = false;
+	try { wire::read(b, &bytes[0]); } catch (std::runtime_error&) { thrown = true; }
+	assert( thrown );
+    }
+
+    // a frame of routes goes as records of one datatype
+    {
+	wire::Frame<RouteEOT> out;
+	vector<RouteEOT> sent;
+	for (int k = 0; k < 8; ++k)
+	    {
+		RouteEOT r;
+		for (unsigned i = 0; i < 30; ++i) { r.push_back( (i * 7 + k) % 30 ); }
+		decorate(r, k);
+		sent.push_back(r);
+		out.push_back(r);
+	    }
+	assert( out.count() == 8 );
+	assert( out.stride() == wire::Frame<RouteEOT>::strideOf( sent[0] ) );
+
+	// a longer genome does not fit
+	RouteEOT longer(31);
+	bool thrown = false;
+	try { out.push_back(longer); } catch (std::runtime_error&) { thrown = true; }
+	assert( thrown );
+
+	wire::Frame<RouteEOT> in( out.stride(), out.count() );
+	MPI_Sendrecv( out.data(), out.count(), out.datatype(), 0, 0,
+		      in.data(), in.count(), in.datatype(), 0, 0, MPI_COMM_SELF, MPI_STATUS_IGNORE );
+
+	vector<RouteEOT> received;
+	in.appendTo(received);
+	assert( received.size() == sent.size() );
+	for (size_t k = 0; k < sent.size(); ++k) { same(sent[k], received[k]); }
+
+	// a copy commits its own datatype, freed with it
+	{
+	    wire::Frame<RouteEOT> copy(in);
+	    assert( copy.count() == in.count() );
+	    int size;
+	    MPI_Type_size( copy.datatype(), &size );
+	    assert( size_t(size) == copy.stride() );
+	}
+	int size;
+	MPI_Type_size( in.datatype(), &size );
+	assert( size_t(size) == in.stride() );
+    }
+
+    cout << "ok" << endl;
+
+    return 0;
+}